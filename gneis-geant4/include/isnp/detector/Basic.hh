@@ -1,42 +1,199 @@
 #ifndef isnp_detector_Basic_hh
 #define isnp_detector_Basic_hh
 
+#include <cstdint>
 #include <vector>
 #include <map>
+#include <future>
+#include <fstream>
 #include <G4VSensitiveDetector.hh>
 #include <G4ParticleDefinition.hh>
+#include <G4ThreeVector.hh>
+
+#include "isnp/detector/Histogram.hh"
 
 namespace isnp {
 
 namespace detector {
 
+/**
+ * Detector writing every hit into a file, hits are ordered by event.
+ * In multithreaded mode every worker thread has its own detector writing its own file
+ * (shard), shards are merged into one output file at the end of every run.
+ * Detectors also fill histograms, which are written as tables at the end of every run.
+ */
 class Basic: public G4VSensitiveDetector {
 public:
 
+	/**
+	 * Text: tab-separated values, one hit per line.
+	 * Binary: columnar sample format which Resampling gun reads directly.
+	 */
+	enum class Format {
+		Text, Binary
+	};
+
 	Basic();
 	Basic(const G4String& name);
+
+	/**
+	 * Creates a detector writing its hits in the given format regardless of the common one.
+	 */
+	Basic(const G4String& name, Format aFormat);
 	virtual ~Basic();
 
+	static Format GetFormat() {
+
+		return format;
+
+	}
+
+	static void SetFormat(Format aFormat);
+
+	static std::size_t GetFlushThreshold() {
+
+		return flushThreshold;
+
+	}
+
+	/**
+	 * Sets a number of hits after which they are written to the file.
+	 * Writing is done by a background thread while new hits are collected,
+	 * the file is valid after every written chunk.
+	 * Zero means the hits are written once on detector destruction.
+	 */
+	static void SetFlushThreshold(std::size_t aFlushThreshold);
+
+	static G4bool GetWriteHits() {
+
+		return writeHits;
+
+	}
+
+	/**
+	 * Hits may be not written at all when only histograms are needed.
+	 */
+	static void SetWriteHits(G4bool aWriteHits);
+
+	/**
+	 * Adds a histogram filled by every detector.
+	 * Histograms of a detector are written into <detector>.<histogram>.txt files,
+	 * their content accumulates over runs.
+	 */
+	static void AddHistogram(Histogram const&);
+
+	/**
+	 * Returns the definition of the histogram with the given name or null.
+	 */
+	static Histogram* FindHistogram(G4String const& name);
+
+	static std::vector<Histogram> const& GetHistograms() {
+
+		return histogramDefinitions;
+
+	}
+
+	static void ClearHistograms();
+
+	/**
+	 * Collects a hit, quantities are in Geant4 units.
+	 * Used by scorers which are not sensitive detectors themselves.
+	 */
+	void Record(G4ParticleDefinition const* particle, G4double totalEnergy,
+			G4double kineticEnergy, G4double time,
+			G4ThreeVector const& direction, G4ThreeVector const& position,
+			G4double weight);
+
+	/**
+	 * Writes all the hits collected by the detectors of the calling thread.
+	 * On worker threads the files are closed and registered as shards of the outputs.
+	 */
+	static void CloseRun();
+
+	/**
+	 * Merges the shards registered during the run into the output files
+	 * and removes them. Called on the master thread when all workers have closed the run.
+	 * Output of the first run overwrites existing files, output of the next runs is appended.
+	 * Real time of the run (in seconds) and its number of events are used to report
+	 * the relative errors and figures of merit of the histograms.
+	 */
+	static void MergeRun(G4double realTime = 0.0, G4int numOfEvents = 0);
+
 protected:
 
 	virtual G4bool ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist);
 
 private:
 
-	typedef std::vector<double>::size_type key_type;
+	typedef std::vector<G4String>::size_type key_type;
+
+	// hits are stored by columns in units of the output file
+	struct Hits {
+		std::vector<key_type> types;
+		std::vector<int32_t> events;
+		std::vector<G4float> totalEnergies, kineticEnergies, times,
+				directionsX, directionsY, directionsZ, positionsX, positionsY,
+				positionsZ, weights;
 
-	struct Data {
-		key_type nameKey;
-		G4double totalEnergy, kineticEnergy, time;
-		G4ThreeVector direction, position;
+		void Clear();
 	};
 
-	std::vector<Data> accum;
+	static Format format;
+	static std::size_t flushThreshold;
+	static G4bool writeHits;
+	static std::vector<Histogram> histogramDefinitions;
+
+	// number of the thread writing a shard, negative if the output is written directly
+	G4int const shardNo;
+
+	// if the format is given by the constructor instead of the common one
+	G4bool const formatFixed;
+
+	// histograms filled during the current run
+	std::vector<Histogram> histograms;
+	G4bool histogramsPrepared;
+
+	// event the histograms are being filled by, its hits make one history
+	G4int histogramEvent;
+
+	// hits being collected and hits being written by the background thread,
+	// the background thread returns its messages to be printed by the detector thread
+	Hits hits, pendingHits;
+	std::future<std::vector<G4String>> pendingWrite;
+
+	std::vector<G4String> names;
+	std::map<G4ParticleDefinition const*, key_type> keyMap;
+
+	// output file is opened on the first write
+	std::vector<char> buffer;
+	std::ofstream file;
+	Format fileFormat;
+	G4bool fileWritten;
+
+	// text file for hits of particle types not fitting into the binary file
+	std::ofstream overflowFile;
 
-	std::map<key_type, G4String> nameMap;
-	std::map<G4String, key_type> keyMap;
+	Basic(const G4String& name, Format aFormat, G4bool aFormatFixed);
 
+	key_type GetKey(G4ParticleDefinition const*);
+	void StartWrite();
+	void WaitWrite();
 	void flush();
+	void Report(std::vector<G4String> const& messages) const;
+	std::vector<G4String> Write(Hits const&,
+			std::vector<G4String> const& typeNames);
+	void OpenFile(std::vector<G4String> const& typeNames,
+			std::vector<G4String>& messages);
+	void CloseFile();
+	void RegisterShard(Format);
+	void MergeHistograms();
+	G4String MakeFileName(G4bool shard) const;
+	G4String MakeFileName(G4bool shard, Format) const;
+	static void WriteTextHeader(std::ostream&);
+	static void WriteText(std::ostream&, Hits const&,
+			std::vector<G4String> const& typeNames);
+	void WriteBinary(Hits const&, std::vector<G4String> const& typeNames,
+			std::vector<G4String>& messages);
 
 };
 
@@ -0,0 +1,295 @@
+#ifndef isnp_detector_Histogram_hh
+#define isnp_detector_Histogram_hh
+
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+#include <G4String.hh>
+#include <G4ParticleDefinition.hh>
+
+namespace isnp {
+
+namespace detector {
+
+/**
+ * Histogram of hits by one or two quantities.
+ * Every bin holds a number of hits, their total weight and the weighted mean and variance
+ * of a value quantity (kinetic energy by default) accumulated by Welford's algorithm.
+ * Weights are also summed up by histories (events), sums of their squares give
+ * the statistical errors of weighted (biased) runs, since hits of one history are correlated.
+ * Histograms filled by different threads are merged without loss of precision.
+ */
+class Histogram {
+public:
+
+	class InvalidAxisException: public std::exception {
+
+	};
+
+	class MismatchException: public std::exception {
+
+	};
+
+	/**
+	 * Quantities of a hit, in units of the detector output:
+	 * kinetic energy (MeV), angle between the direction and Z axis (deg),
+	 * X and Y position (mm), time (ns).
+	 */
+	enum class Quantity {
+		Energy, Angle, X, Y, Time
+	};
+
+	static std::size_t const NumOfQuantities = 5;
+
+	typedef std::array<G4double, NumOfQuantities> Values;
+
+	enum class Scale {
+		Linear, Log
+	};
+
+	class Axis {
+	public:
+
+		Axis(Quantity aQuantity, std::size_t aNumOfBins, G4double aMin,
+				G4double aMax, Scale aScale = Scale::Linear);
+
+		Quantity GetQuantity() const {
+
+			return quantity;
+
+		}
+
+		std::size_t GetNumOfBins() const {
+
+			return numOfBins;
+
+		}
+
+		G4double GetMin() const {
+
+			return min;
+
+		}
+
+		G4double GetMax() const {
+
+			return max;
+
+		}
+
+		Scale GetScale() const {
+
+			return scale;
+
+		}
+
+		/**
+		 * Returns the number of the bin holding the value
+		 * or the number of bins if the value is out of range.
+		 */
+		std::size_t BinOf(G4double const value) const {
+
+			auto const v = (scale == Scale::Log ? Log(value) : value) - low;
+			if (!(v >= 0)) {
+				return numOfBins;
+			}
+
+			auto const bin = static_cast<std::size_t>(v * binsPerUnit);
+			return bin < numOfBins ? bin : numOfBins;
+
+		}
+
+		G4double LowerEdge(std::size_t bin) const;
+
+		bool operator==(Axis const&) const;
+
+	private:
+
+		Quantity quantity;
+		std::size_t numOfBins;
+		G4double min, max;
+		Scale scale;
+
+		// lower edge and number of bins per unit, after log transform for log axes
+		G4double low, binsPerUnit;
+
+		static G4double Log(G4double value);
+
+	};
+
+	struct Bin {
+
+		// weight2 is the sum of squared weights of the ended histories,
+		// history is the weight of the current one
+		uint64_t count;
+		G4double weight, weight2, mean, m2, history;
+
+		void Add(G4double const value, G4double const w) {
+
+			if (!(w > 0)) {
+				return;
+			}
+
+			count++;
+			weight += w;
+			history += w;
+			auto const delta = value - mean;
+			mean += delta * w / weight;
+			m2 += w * delta * (value - mean);
+
+		}
+
+		void EndHistory();
+		void Merge(Bin const&);
+		G4double Variance() const;
+
+		/**
+		 * Returns the relative statistical error of the total weight
+		 * over the given number of histories, including ones with no hits.
+		 */
+		G4double RelativeError(uint64_t numOfHistories) const;
+
+	};
+
+	Histogram(G4String const& aName, Axis const& anX);
+	Histogram(G4String const& aName, Axis const& anX, Axis const& aY);
+
+	G4String const& GetName() const {
+
+		return name;
+
+	}
+
+	Axis const& GetX() const {
+
+		return axes[0];
+
+	}
+
+	Axis const& GetY() const {
+
+		return axes[1];
+
+	}
+
+	bool IsTwoDimensional() const {
+
+		return axes.size() == 2;
+
+	}
+
+	/**
+	 * Name of the particle to count, empty string means all particles.
+	 */
+	G4String const& GetParticleName() const {
+
+		return particleName;
+
+	}
+
+	void SetParticleName(G4String const& aParticleName);
+
+	Quantity GetValue() const {
+
+		return value;
+
+	}
+
+	void SetValue(Quantity aValue);
+
+	void Fill(G4ParticleDefinition const* particle, Values const& values,
+			G4double const weight = 1.0) {
+
+		if (!particleName.isNull()
+				&& particle->GetParticleName() != particleName) {
+			return;
+		}
+
+		auto const x = axes[0].BinOf(values[Index(axes[0].GetQuantity())]);
+		auto bin = x < axes[0].GetNumOfBins() ? x : bins.size();
+		if (axes.size() == 2 && bin < bins.size()) {
+			auto const y = axes[1].BinOf(values[Index(axes[1].GetQuantity())]);
+			bin = y < axes[1].GetNumOfBins() ?
+					x * axes[1].GetNumOfBins() + y : bins.size();
+		}
+
+		if (bin < bins.size()) {
+			if (weight > 0) {
+				if (bins[bin].history == 0) {
+					touched.push_back(bin);
+				}
+				bins[bin].Add(values[Index(value)], weight);
+				total.history += weight;
+			}
+		} else {
+			outOfRange++;
+		}
+
+	}
+
+	/**
+	 * Ends the current history (event): hits filled since the previous call
+	 * are summed up as one sample of the statistical error.
+	 */
+	void EndHistory();
+
+	Bin const& GetBin(std::size_t x, std::size_t y = 0) const;
+
+	/**
+	 * Returns the sum of all the bins, its squared weights are summed up by histories
+	 * of the whole histogram.
+	 */
+	Bin GetTotal() const;
+
+	uint64_t GetOutOfRange() const {
+
+		return outOfRange;
+
+	}
+
+	/**
+	 * Adds the content of the other histogram having the same definition.
+	 */
+	void Merge(Histogram const&);
+
+	/**
+	 * Clears the content keeping the definition.
+	 */
+	void Reset();
+
+	/**
+	 * Writes the bins as a table, one line per bin.
+	 */
+	void Write(std::ostream&) const;
+
+	static G4String const& QuantityName(Quantity);
+
+	static std::size_t Index(Quantity const q) {
+
+		return static_cast<std::size_t>(q);
+
+	}
+
+private:
+
+	G4String name;
+	std::vector<Axis> axes;
+	G4String particleName;
+	Quantity value;
+	std::vector<Bin> bins;
+	uint64_t outOfRange;
+
+	// squared history weights of the whole histogram and the bins hit by the current history
+	Bin total;
+	std::vector<std::size_t> touched;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_detector_Histogram_hh
@@ -1,6 +1,8 @@
 #ifndef isnp_dist_AbstractDistribution_hh
 #define isnp_dist_AbstractDistribution_hh
 
+#include <cstddef>
+
 #include <G4ThreeVector.hh>
 #include "isnp/util/NonCopyable.hh"
 
@@ -13,6 +15,12 @@ public:
 
 	virtual G4ThreeVector Generate() const = 0;
 
+	/**
+	 * Generates n points at once storing their X and Y coordinates into separate arrays.
+	 * Z coordinate of a point is always zero.
+	 */
+	virtual void GenerateN(G4double* x, G4double* y, std::size_t n) const;
+
 };
 
 }
@@ -25,6 +25,7 @@ public:
 	using util::PropertyHolder<GaussEllipseProps>::PropertyHolder;
 
 	G4ThreeVector Generate() const override;
+	void GenerateN(G4double* x, G4double* y, std::size_t n) const override;
 
 };
 
@@ -12,7 +12,15 @@ namespace dist {
 class UniformCircleProps {
 public:
 
-	UniformCircleProps(G4double aDiameter);
+	/**
+	 * Rejection: points of the enclosing square are drawn until one falls within the circle.
+	 * Analytic: radius and angle are drawn directly, always two random numbers per point.
+	 */
+	enum class Engine {
+		Rejection, Analytic
+	};
+
+	UniformCircleProps(G4double aDiameter, Engine anEngine = Engine::Rejection);
 
 	G4double GetDiameter() const {
 		return diameter;
@@ -22,9 +30,18 @@ public:
 		diameter = v;
 	}
 
+	Engine GetEngine() const {
+		return engine;
+	}
+
+	void SetEngine(Engine const v) {
+		engine = v;
+	}
+
 private:
 
 	G4double diameter;
+	Engine engine;
 
 };
 
@@ -35,6 +52,7 @@ public:
 	using util::PropertyHolder<UniformCircleProps>::PropertyHolder;
 
 	G4ThreeVector Generate() const override;
+	void GenerateN(G4double* x, G4double* y, std::size_t n) const override;
 
 };
 
@@ -2,6 +2,7 @@
 #define isnp_facility_BasicSpallation_hpp
 
 #include <memory>
+#include <functional>
 
 #include <G4VUserDetectorConstruction.hh>
 #include <G4LogicalVolume.hh>
@@ -17,9 +18,15 @@ class BasicSpallation: public G4VUserDetectorConstruction,
 		public util::Singleton<BasicSpallation> {
 public:
 
+	/**
+	 * Creates a sensitive detector, called once by every thread processing events.
+	 */
+	typedef std::function<G4VSensitiveDetector*()> DetectorFactory;
+
 	~BasicSpallation() override;
 
 	G4VPhysicalVolume* Construct() override;
+	void ConstructSDandField() override;
 
 	G4double GetXAngle() const;
 	void SetXAngle(G4double anAngle);
@@ -47,8 +54,8 @@ public:
 	}
 	void SetWorldMaterial(const G4String&);
 
-	G4VSensitiveDetector* GetDetector() const;
-	void SetDetector(G4VSensitiveDetector* aDetector);
+	DetectorFactory const& GetDetectorFactory() const;
+	void SetDetectorFactory(DetectorFactory const& aDetectorFactory);
 
 private:
 
@@ -56,7 +63,8 @@ private:
 
 	BasicSpallation();
 
-	G4VSensitiveDetector* detector;
+	DetectorFactory detectorFactory;
+	G4LogicalVolume* detectorVolume;
 	std::unique_ptr<BasicSpallationMessenger> const messenger;
 	G4double worldRadius, xAngle, yAngle, distance, detectorWidth,
 			detectorHeight, detectorLength;
@@ -65,7 +73,7 @@ private:
 	G4LogicalVolume* logicWorld;
 
 	static G4double HalfOf(G4double v);
-	G4VSensitiveDetector* MakeDefaultDetector();
+	static G4VSensitiveDetector* MakeDefaultDetector();
 
 };
 
@@ -1,11 +1,17 @@
 #ifndef isnp_facility_Beam5_hpp
 #define isnp_facility_Beam5_hpp
 
+#include <array>
 #include <memory>
+#include <functional>
+#include <map>
+#include <vector>
 #include <G4VUserDetectorConstruction.hh>
 #include <G4LogicalVolume.hh>
 #include "isnp/util/Singleton.hh"
 
+class G4ProductionCuts;
+
 namespace isnp {
 
 namespace facility {
@@ -15,9 +21,34 @@ class Beam5Messenger;
 class Beam5: public G4VUserDetectorConstruction, public util::Singleton<Beam5> {
 public:
 
+	/**
+	 * Creates a sensitive detector, called once by every thread processing events.
+	 */
+	typedef std::function<G4VSensitiveDetector*()> DetectorFactory;
+
+	/**
+	 * Groups of volumes placed in their own G4Regions:
+	 * the spallation target, the vacuum chamber and the neutron tubes with their inner space,
+	 * the collimators and the concrete shielding around collimators #3 and #4.
+	 */
+	enum class Region {
+		Target, VacuumTubes, Collimators, Shielding
+	};
+
+	static std::size_t const NumOfRegions = 4;
+
+	/**
+	 * Production cut (all particles), maximal global time and minimal kinetic energy
+	 * of tracks in a region, zero means the default cuts and no limit.
+	 */
+	struct RegionSettings {
+		G4double productionCut, maxTime, minKineticEnergy;
+	};
+
 	~Beam5() override;
 
 	virtual G4VPhysicalVolume* Construct();
+	void ConstructSDandField() override;
 
 	G4bool GetHasSpallationTarget() const;
 	void SetHasSpallationTarget(G4bool v);
@@ -34,8 +65,8 @@ public:
 	G4int GetVerboseLevel() const;
 	void SetVerboseLevel(G4int aVerboseLevel);
 
-	void SetDetector(G4VSensitiveDetector* aDetector);
-	G4VSensitiveDetector* GetDetector() const;
+	void SetDetectorFactory(DetectorFactory const& aDetectorFactory);
+	DetectorFactory const& GetDetectorFactory() const;
 
 	G4double GetC5Diameter() const;
 	void SetC5Diameter(G4double angle);
@@ -43,13 +74,76 @@ public:
 	G4String const& GetC5Material() const;
 	void SetC5Material(G4String const& aMaterial);
 
+	RegionSettings const& GetRegionSettings(Region region) const;
+	void SetRegionSettings(Region region, RegionSettings const& settings);
+
+	/**
+	 * If any region limits the time or the energy of tracks,
+	 * such limits take effect through G4StepLimiterPhysics only.
+	 */
+	G4bool HasTrackLimits() const;
+
+	/**
+	 * Short name of a region used by the commands,
+	 * the name of the G4Region is prefixed by "beam5".
+	 */
+	static G4String const& RegionName(Region region);
+
+	/**
+	 * Short name of the region of the evacuated volumes enveloping
+	 * component::VacuumTransportModel if the fast vacuum is on.
+	 */
+	static G4String const& VacuumEnvelopeName();
+
+	/**
+	 * If neutrons cross the evacuated volumes in one step,
+	 * see component::VacuumTransportModel. The evacuated volumes are then moved from
+	 * the vacuum tubes region into a region of their own, the envelope of the model,
+	 * which takes the settings of the vacuum tubes region.
+	 */
+	G4bool GetFastVacuum() const;
+	void SetFastVacuum(G4bool v);
+
+	/**
+	 * If collimators #1 and #2 are built with their apertures as daughter volumes
+	 * instead of boolean subtractions, the geometry is the same.
+	 */
+	G4bool GetC1Native() const;
+	void SetC1Native(G4bool v);
+
+	G4bool GetC2Native() const;
+	void SetC2Native(G4bool v);
+
+	/**
+	 * If the components are placed in envelopes of the world material, one per section
+	 * of the beamline (the target hall, collimator #1 and neutron tube #1, collimator #2
+	 * and neutron tube #2, the wall with collimators #3 and #4, neutron tube #4
+	 * with collimator #5, neutron tube #5 and the detector), instead of the world.
+	 * The geometry is the same, the navigator voxelises a few daughters per volume.
+	 */
+	G4bool GetHasSections() const;
+	void SetHasSections(G4bool v);
+
+	/**
+	 * Smartless of the section envelopes, see G4LogicalVolume::SetSmartless.
+	 */
+	G4double GetSectionSmartless() const;
+	void SetSectionSmartless(G4double v);
+
+	/**
+	 * Shoots geantino rays from the beam position along the beam through the constructed
+	 * geometry and prints the navigation time per metre.
+	 */
+	void RunNavigationBenchmark(G4int numOfRays) const;
+
 private:
 
 	friend class util::Singleton<Beam5>;
 	Beam5();
 
 	std::unique_ptr<Beam5Messenger> const messenger;
-	G4VSensitiveDetector* detector;
+	DetectorFactory detectorFactory;
+	G4LogicalVolume* detectorVolume;
 	G4double zeroPosition, worldLength, xAngle, yAngle;
 	G4bool hasSpallationTarget;
 	G4double c5Diameter;
@@ -60,18 +154,59 @@ private:
 	G4String ntubeMaterial, ntubeFlangeMaterial, ntubeInnerMaterial,
 			wallMaterial, worldMaterial, windowMaterial, c5Material;
 	G4double worldRadius;
+	std::array<RegionSettings, NumOfRegions> regionSettings;
+	std::array<std::vector<G4LogicalVolume*>, NumOfRegions> regionVolumes;
+
+	// own production cuts of the regions by name, reused by every construction
+	std::map<G4String, G4ProductionCuts*> productionCuts;
+
+	// inner space of the chamber, the neutron tubes and the collimator channels
+	std::vector<G4LogicalVolume*> vacuumVolumes;
+	G4bool fastVacuum, c1Native, c2Native, hasSections;
+	G4double sectionSmartless;
+
+	/**
+	 * Envelope occupying [begin, end] along the beam.
+	 */
+	struct Section {
+		G4double begin, end;
+		G4LogicalVolume* volume;
+	};
+
+	std::vector<Section> sections;
 
 	void PlaceComponent(G4LogicalVolume *world, G4LogicalVolume *component,
 			G4double position, G4double componentLength, G4bool checkOverlaps =
 					true);
+	void AddSection(G4LogicalVolume* world, G4String const& name,
+			G4double begin, G4double end);
+
+	/**
+	 * Returns the section containing [position, position + length] along the beam
+	 * or the world, origin is the Z coordinate of the beam start in the returned volume.
+	 */
+	G4LogicalVolume* MotherAt(G4LogicalVolume* world, G4double position,
+			G4double length, G4double& origin) const;
+
 	void PlaceCollimator(G4LogicalVolume *world, G4LogicalVolume *collimator,
 			G4double position, G4double collimatorLength);
 
 	G4VSolid* MakeCylinder(G4String const &name, G4double halfLength);
-	G4VSensitiveDetector* MakeDefaultDetector();
+	static G4VSensitiveDetector* MakeDefaultDetector();
 	G4LogicalVolume* MakeFlange(G4int ntubeNo, G4int flangeNo);
 	void AddNTube(G4LogicalVolume* logicWorld, G4double length, G4double zPos,
 			G4int ntubeNo);
+	void AddToRegion(Region region, G4LogicalVolume* volume);
+	void AddToVacuum(G4LogicalVolume* volume);
+
+	/**
+	 * Makes the volumes added to every region the root volumes of its G4Region
+	 * and applies the region settings.
+	 */
+	void ConstructRegions();
+	void ConstructRegion(G4String const& name,
+			std::vector<G4LogicalVolume*> const& volumes,
+			RegionSettings const& settings);
 
 };
 
@@ -0,0 +1,126 @@
+#ifndef isnp_generator_Emulator_hh
+#define isnp_generator_Emulator_hh
+
+#include <memory>
+#include <exception>
+
+#include <G4VUserPrimaryGeneratorAction.hh>
+#include <G4ParticleGun.hh>
+#include <G4String.hh>
+#include <G4Transform3D.hh>
+
+#include "isnp/util/DataFrame.hh"
+
+namespace isnp {
+
+namespace generator {
+
+class EmulatorMessenger;
+class EmulatorTable;
+
+/**
+ * Class emulates the neutron source (spallation target) by drawing particles
+ * from a precomputed double-differential table instead of simulating the proton
+ * cascade. A table is built once from a sample recorded in a Spallation run
+ * (by a detector or a scoring plane), see BuildTable.
+ * Particles start at z = 0 of the beam like the ones of Resampling gun.
+ */
+class Emulator: public G4VUserPrimaryGeneratorAction {
+public:
+
+	class NoFileException: public std::exception {
+
+	};
+
+	typedef util::DataFrame::size_type size_type;
+
+	Emulator();
+	~Emulator();
+
+	void GeneratePrimaries(G4Event*) override;
+
+	G4String const& GetTableFileName() const {
+
+		return tableFileName;
+
+	}
+
+	void SetTableFileName(G4String const&);
+
+	G4int GetVerboseLevel() const {
+
+		return verboseLevel;
+
+	}
+
+	void SetVerboseLevel(G4int const aVerboseLevel) {
+
+		verboseLevel = aVerboseLevel;
+
+	}
+
+	size_type GetEnergyBins() const {
+
+		return energyBins;
+
+	}
+
+	size_type GetAngleBins() const {
+
+		return angleBins;
+
+	}
+
+	size_type GetAzimuthBins() const {
+
+		return azimuthBins;
+
+	}
+
+	size_type GetPositionBins() const {
+
+		return positionBins;
+
+	}
+
+	/**
+	 * Sets the number of bins of the tables built by BuildTable.
+	 */
+	void SetBins(size_type anEnergyBins, size_type anAngleBins,
+			size_type anAzimuthBins, size_type aPositionBins);
+
+	/**
+	 * Accumulates a sample file (text or binary, in the format of Resampling samples)
+	 * into a table written in the binary format.
+	 */
+	void BuildTable(G4String const& sampleFileName,
+			G4String const& tableFileName) const;
+
+	/**
+	 * Loads the table file unless it is already loaded.
+	 * Table is shared by the guns of all threads.
+	 */
+	void PrepareTable();
+
+private:
+
+	std::unique_ptr<EmulatorMessenger> const messenger;
+	std::unique_ptr<G4ParticleGun> const particleGun;
+	G4String tableFileName;
+	G4int verboseLevel;
+	size_type energyBins, angleBins, azimuthBins, positionBins;
+	std::shared_ptr<EmulatorTable const> table;
+	unsigned counter;
+	G4bool beamTransformDetected;
+	G4Transform3D beamTransform;
+
+	util::DataFrame ReadSampleFile(G4String const& sampleFileName) const;
+	G4Transform3D DetectBeamTransform() const;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_generator_Emulator_hh
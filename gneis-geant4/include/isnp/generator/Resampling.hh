@@ -4,6 +4,7 @@
 #include <memory>
 #include <exception>
 #include <iostream>
+#include <set>
 
 #include <G4VUserPrimaryGeneratorAction.hh>
 #include <G4ParticleGun.hh>
@@ -16,12 +17,45 @@
 
 namespace isnp {
 
+namespace util {
+
+class DataFrameBlockReader;
+
+}
+
+}
+
+namespace isnp {
+
 namespace generator {
 
 class ResamplingMessenger;
+class EnergyImportance;
+class ResamplingSampler;
+class SampleStream;
+
+}
+
+namespace util {
+
+class ApertureChain;
+
+}
+
+namespace generator {
 
 /**
  * Class generates random particles using the given data files as a sample.
+ * If the sample has the Weight column rows are drawn with probabilities proportional
+ * to their weights, so a weighted sample may replace a sample of duplicated rows.
+ * If an energy importance is given primaries of important energies are generated more often,
+ * the weight of a primary vertex compensates the bias.
+ * In acceptance mode directions are drawn only from the rows passing the collimators
+ * of the beam line, the weight of a primary vertex is multiplied by the weight fraction
+ * of these rows.
+ * Positions are projected along their directions onto z = 0 of the beam unless
+ * the projection is switched off to start particles where they are recorded,
+ * e.g. by a scoring plane in the middle of a beam line.
  */
 class Resampling: public G4VUserPrimaryGeneratorAction {
 public:
@@ -34,6 +68,14 @@ public:
 
 	};
 
+	/**
+	 * Memory: whole sample is loaded (or mapped) into memory.
+	 * Stream: sample is read by blocks, rows are drawn within the current block.
+	 */
+	enum class Mode {
+		Memory, Stream
+	};
+
 	Resampling();
 	~Resampling();
 
@@ -52,32 +94,117 @@ public:
 		verboseLevel = aVerboseLevel;
 	}
 
+	Mode GetMode() const {
+
+		return mode;
+
+	}
+
+	void SetMode(Mode aMode);
+
+	util::DataFrame::size_type GetBlockSize() const {
+
+		return blockSize;
+
+	}
+
+	void SetBlockSize(util::DataFrame::size_type aBlockSize);
+
+	G4bool GetShuffleBlocks() const {
+
+		return shuffleBlocks;
+
+	}
+
+	void SetShuffleBlocks(G4bool aShuffleBlocks);
+
+	/**
+	 * Sets the importance of the primary energies from the given energy up to the next
+	 * energy point, energies below the first point have importance 1.
+	 */
+	void AddEnergyImportance(G4double energy, G4double importance);
+	void ClearEnergyImportance();
+
+	/**
+	 * Returns the energy importance points as "energy importance" pairs, energies in MeV.
+	 */
+	G4String GetEnergyImportance() const;
+
+	G4bool GetAcceptance() const {
+
+		return acceptance;
+
+	}
+
+	void SetAcceptance(G4bool anAcceptance);
+
+	G4bool GetProjectPositions() const {
+
+		return projectPositions;
+
+	}
+
+	/**
+	 * Acceptance is computed for particles starting at z = 0,
+	 * so it is ignored if the positions are not projected.
+	 */
+	void SetProjectPositions(G4bool aProjectPositions);
+
 	void Load(std::istream&);
 
+	/**
+	 * Loads the sample file unless it is already loaded.
+	 * Sample is shared by the guns of all threads, so calling this on the master thread
+	 * before workers start makes them reuse the loaded sample.
+	 */
+	void PrepareSample();
+
+	/**
+	 * Converts a text sample file into the binary format.
+	 * Binary files are memory-mapped instead of being parsed on load.
+	 */
+	void ConvertSampleFile(G4String const& textFileName,
+			G4String const& binaryFileName) const;
+
 private:
 
 	std::unique_ptr<ResamplingMessenger> const messenger;
 	std::unique_ptr<G4ParticleGun> const particleGun;
 	G4String sampleFileName, energyColumn, directionXColumn, directionYColumn,
 			directionZColumn, positionXColumn, positionYColumn, positionZColumn,
-			typeColumn;
+			typeColumn, weightColumn;
 	bool sampleFileLoaded;
 	unsigned counter;
 	G4int verboseLevel;
-	std::unique_ptr<util::DataFrame> dataFrame;
+	std::shared_ptr<ResamplingSampler const> sampler;
+	Mode mode;
+	util::DataFrame::size_type blockSize;
+	G4bool shuffleBlocks;
+	std::shared_ptr<util::DataFrameBlockReader const> blockReader;
+	std::shared_ptr<std::vector<G4double> const> blockWeights;
+	std::unique_ptr<SampleStream> stream;
 	G4bool beamTransformDetected;
 	G4Transform3D beamTransform;
+	std::unique_ptr<EnergyImportance> const energyImportance;
+	G4bool acceptance;
+	G4bool projectPositions;
 
 	static std::unique_ptr<G4ParticleGun> MakeGun();
 	G4ThreeVector CalculatePosition(const G4ThreeVector& direction,
 			const G4ThreeVector& targetPos);
 	G4ThreeVector CalculateDirection(G4ThreeVector dir);
 	void LoadSampleFile();
-	G4double ShootNumber(G4String const& column,
-			util::DataFrame::size_type rowNo) const;
-	G4ThreeVector ShootVector(G4String const& columnX, G4String const & columnY,
-			G4String const & columnZ, util::DataFrame::size_type rowNo) const;
+	std::set<G4String> FloatColumns() const;
+	std::set<G4String> CategoryColumns() const;
+	std::set<G4String> OptionalFloatColumns() const;
+	util::DataFrame ReadSampleFile() const;
+	std::shared_ptr<ResamplingSampler const> MakeSampler(
+			util::DataFrame&&) const;
+	void SetSampler(std::shared_ptr<ResamplingSampler const> const&);
+	void OpenSampleStream();
+	ResamplingSampler const& NextSample();
 	G4Transform3D DetectBeamTransform() const;
+	util::ApertureChain Apertures() const;
 
 };
 
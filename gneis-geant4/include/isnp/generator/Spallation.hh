@@ -6,6 +6,7 @@
 #include <G4Transform3D.hh>
 
 #include <memory>
+#include <vector>
 
 #include <gtest/gtest_prod.h>
 
@@ -67,6 +68,7 @@ public:
 	void SetMode(Mode const aMode) {
 
 		mode = aMode;
+		ResetPositions();
 
 	}
 
@@ -78,6 +80,7 @@ public:
 
 	dist::UniformRectangle& GetUniformRectangle() {
 
+		ResetPositions();
 		return uniformRectangle;
 
 	}
@@ -90,6 +93,7 @@ public:
 
 	dist::UniformCircle& GetUniformCircle() {
 
+		ResetPositions();
 		return uniformCircle;
 
 	}
@@ -102,6 +106,7 @@ public:
 
 	dist::GaussEllipse& GetGaussEllipse() {
 
+		ResetPositions();
 		return gaussEllipse;
 
 	}
@@ -118,6 +123,8 @@ private:
 
 	FRIEND_TEST(Spallation, GenerateDirection);
 
+	FRIEND_TEST(Spallation, ResetPositions);
+
 	std::unique_ptr<G4ParticleGun> const particleGun;
 	std::unique_ptr<SpallationMessenger> const messenger;
 	G4double positionX, positionY;
@@ -129,10 +136,24 @@ private:
 	dist::GaussEllipse gaussEllipse;
 	G4bool targetTransformDetected;
 	G4Transform3D targetTransform;
+	// positions are generated in batches, X and Y coordinates are kept separately
+	std::vector<G4double> positionsX, positionsY;
+	std::size_t positionNo;
 
 	G4ThreeVector GenerateDirection(G4Transform3D const&) const;
 	const dist::AbstractDistribution& ResolveDistribution() const;
-	G4ThreeVector GeneratePosition(G4Transform3D const&) const;
+	G4ThreeVector GeneratePosition(G4Transform3D const&);
+	G4ThreeVector NextPosition();
+
+	/**
+	 * Discards the positions generated in advance.
+	 * Called whenever the distribution or its properties may change.
+	 */
+	void ResetPositions() {
+
+		positionNo = positionsX.size();
+
+	}
 
 	static std::unique_ptr<G4ParticleGun> MakeGun();
 
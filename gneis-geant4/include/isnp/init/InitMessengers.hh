@@ -13,6 +13,8 @@ class FileNameBuilderMessenger;
 class PhysListMessenger;
 class FacilityMessenger;
 class UserActionMessenger;
+class DetectorMessenger;
+class ScoreMessenger;
 
 class InitMessengers {
 public:
@@ -26,6 +28,8 @@ private:
 	std::unique_ptr<PhysListMessenger> const physListMessenger;
 	std::unique_ptr<FacilityMessenger> const facilityMessenger;
 	std::unique_ptr<UserActionMessenger> const userActionMessenger;
+	std::unique_ptr<DetectorMessenger> const detectorMessenger;
+	std::unique_ptr<ScoreMessenger> const scoreMessenger;
 
 };
 
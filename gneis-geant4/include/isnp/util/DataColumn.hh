@@ -0,0 +1,77 @@
+#ifndef isnp_util_DataColumn_hh
+#define isnp_util_DataColumn_hh
+
+#include <cstddef>
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Read-only view of a data column stored in a contiguous memory block.
+ * The view does not own the memory, the owning DataFrame does.
+ */
+template<typename T>
+class DataColumn {
+public:
+
+	typedef T value_type;
+	typedef std::size_t size_type;
+	typedef T const* const_iterator;
+
+	DataColumn() :
+			first(nullptr), count(0) {
+	}
+
+	DataColumn(T const* const aFirst, size_type const aCount) :
+			first(aFirst), count(aCount) {
+	}
+
+	size_type size() const {
+
+		return count;
+
+	}
+
+	bool empty() const {
+
+		return count == 0;
+
+	}
+
+	T const* data() const {
+
+		return first;
+
+	}
+
+	T const& operator[](size_type const i) const {
+
+		return first[i];
+
+	}
+
+	const_iterator begin() const {
+
+		return first;
+
+	}
+
+	const_iterator end() const {
+
+		return first + count;
+
+	}
+
+private:
+
+	T const* first;
+	size_type count;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_util_DataColumn_hh
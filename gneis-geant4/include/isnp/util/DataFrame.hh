@@ -2,6 +2,7 @@
 #define isnp_utl_DataFrame_hh
 
 #include <vector>
+#include <list>
 #include <map>
 #include <exception>
 #include <cstdint>
@@ -10,39 +11,58 @@
 #include <G4Types.hh>
 #include <G4String.hh>
 
+#include "isnp/util/DataColumn.hh"
+
 namespace isnp {
 
 namespace util {
 
 class DataFrameLoader;
+class DataFrameMapper;
+class DataFrameWriter;
+class DataFrameBlockReader;
 
 /**
  * Class holds one or several data vectors, with either numeric or categorized values.
  * All vectors have equal size.
+ * Vectors are either owned by the data frame or mapped from a binary sample file.
  */
 class DataFrame {
 
 public:
 
 	typedef uint8_t CategoryId;
+	typedef DataColumn<CategoryId> CategoryColumnView;
+	typedef DataColumn<G4float> FloatColumnView;
 
 private:
 
 	typedef std::vector<CategoryId> CategoryVector;
 	typedef std::vector<G4float> FloatVector;
-	typedef std::map<G4String, CategoryVector> CategoryVectorMap;
+	typedef std::map<G4String, CategoryColumnView> CategoryColumnMap;
 	typedef std::map<CategoryId, G4String> CategoryMap;
 	typedef std::map<G4String, CategoryMap> CategoryNameMap;
-	typedef std::map<G4String, FloatVector> FloatVectorMap;
+	typedef std::map<G4String, FloatColumnView> FloatColumnMap;
 	typedef std::map<G4String, unsigned> PrecisionMap;
 
 	struct DataPack {
 
-		FloatVectorMap floatColumns;
-		CategoryVectorMap categoryColumns;
+		FloatColumnMap floatColumns;
+		CategoryColumnMap categoryColumns;
 		CategoryNameMap categoryNames;
 		PrecisionMap precisions;
 
+		// storage of the columns loaded into memory
+		std::list<FloatVector> floatVectors;
+		std::list<CategoryVector> categoryVectors;
+
+		// storage of the columns mapped from a file
+		std::shared_ptr<void const> mapping;
+
+		void AddFloatColumn(G4String const& columnName, FloatVector&& v);
+		void AddCategoryColumn(G4String const& columnName,
+				CategoryVector&& v);
+
 	};
 
 public:
@@ -54,13 +74,16 @@ public:
 	typedef FloatVector::size_type size_type;
 
 	DataFrame(DataFrame&&);
+	~DataFrame();
 
 	size_type Size() const;
 
 	G4String const& CategoryName(const G4String& columnName,
 			CategoryId id) const;
-	CategoryVector const& CategoryColumn(const G4String& columnName) const;
-	FloatVector const& FloatColumn(const G4String& columnName) const;
+	CategoryColumnView const& CategoryColumn(
+			const G4String& columnName) const;
+	FloatColumnView const& FloatColumn(const G4String& columnName) const;
+	bool HasFloatColumn(const G4String& columnName) const;
 	unsigned Precision(const G4String& columnName) const;
 
 	G4String const& CategoryValue(const G4String& columnName,
@@ -76,9 +99,17 @@ public:
 
 	}
 
+	/**
+	 * Returns true if the data are mapped from a file rather than loaded into memory
+	 */
+	bool IsMapped() const;
+
 private:
 
 	friend class DataFrameLoader;
+	friend class DataFrameMapper;
+	friend class DataFrameWriter;
+	friend class DataFrameBlockReader;
 
 	DataFrame (std::unique_ptr<DataPack>);
 
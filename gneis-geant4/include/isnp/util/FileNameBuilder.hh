@@ -18,6 +18,13 @@ public:
 	static G4String Make(char const* base, char const* suffix = nullptr);
 	static G4String Make(G4String const& base, char const* suffix = nullptr);
 
+	/**
+	 * Makes a name of a file holding a part of the output written by one thread,
+	 * e.g. detector.t3.txt for detector.txt
+	 */
+	static G4String MakeShard(G4String const& base, G4int shardNo,
+			char const* suffix = nullptr);
+
 	static G4String const& GetCommonSuffix() {
 
 		return commonSuffix;
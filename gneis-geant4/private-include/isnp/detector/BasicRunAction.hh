@@ -0,0 +1,31 @@
+#ifndef isnp_detector_BasicRunAction_hh
+#define isnp_detector_BasicRunAction_hh
+
+#include <G4UserRunAction.hh>
+#include <G4Timer.hh>
+
+namespace isnp {
+
+namespace detector {
+
+/**
+ * Writes the hits of the basic detectors at the end of every run.
+ * Worker threads close their shards, the master thread merges them.
+ */
+class BasicRunAction: public G4UserRunAction {
+public:
+
+	void BeginOfRunAction(G4Run const*) override;
+	void EndOfRunAction(G4Run const*) override;
+
+private:
+
+	G4Timer timer;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_detector_BasicRunAction_hh
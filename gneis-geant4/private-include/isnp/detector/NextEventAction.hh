@@ -0,0 +1,170 @@
+#ifndef isnp_detector_NextEventAction_hh
+#define isnp_detector_NextEventAction_hh
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <G4UserSteppingAction.hh>
+#include <G4Navigator.hh>
+#include <G4ThreeVector.hh>
+#include <G4Material.hh>
+
+#include "isnp/detector/Basic.hh"
+
+namespace isnp {
+
+namespace detector {
+
+/**
+ * Next-event (point detector) estimator of the neutron flux at distant detectors.
+ * At every hadronic interaction emitting neutrons the expected contribution of every
+ * emitted neutron to every detector is recorded as a hit: the probability density
+ * of the emission towards the detector times the probability to reach it uncollided,
+ * the attenuation along the straight path is found by ray casting through the mass geometry
+ * with the total hadronic cross sections of its materials.
+ *
+ * Neutrons scattered elastically are assumed to be emitted isotropically in the centre
+ * of mass frame, the density and the energy towards the detector follow from
+ * the non-relativistic kinematics of the target nucleus. Geant4 gives no access
+ * to the angular distributions of other interactions, their neutrons are assumed
+ * to be emitted isotropically in the laboratory frame, which holds for evaporation
+ * neutrons rather than for the forward cascade ones.
+ * Uncollided primary neutrons contribute the probability to reach a disk along their
+ * initial direction, their contribution to a point is zero.
+ *
+ * A detector of zero radius is a point, the hit weight is the fluence per mm^2
+ * per unit weight of the emitted neutron. A detector of non-zero radius is a disk across
+ * the beam, the hit weight is the expected number of crossings.
+ * Hits are recorded by basic detectors (one per detector and thread) with
+ * positions and directions in the world coordinate system as the analog detectors do,
+ * so they fill the same histograms.
+ */
+class NextEventAction: public G4UserSteppingAction {
+public:
+
+	struct Point {
+		G4String name;
+		G4ThreeVector position;
+		G4double radius;
+	};
+
+	/**
+	 * Neutron leaving an interaction, in the world coordinate system.
+	 * Elastic scattering is given by the incident neutron and the ratio of the target
+	 * nucleus mass to the neutron mass, zero mass ratio means isotropic emission.
+	 */
+	struct Emission {
+		G4ThreeVector position;
+		G4double kineticEnergy, time, weight;
+		G4ThreeVector incidentDirection;
+		G4double incidentEnergy, massRatio;
+	};
+
+	/**
+	 * Macroscopic cross section of a material for a neutron of the given kinetic energy.
+	 */
+	typedef std::function<G4double(G4Material const*, G4double)> CrossSection;
+
+	NextEventAction();
+	~NextEventAction() override;
+
+	/**
+	 * Adds a detector or moves the detector with the same name,
+	 * position is in the beam coordinate system.
+	 */
+	static void AddPoint(Point const&);
+	static void ClearPoints();
+
+	static std::vector<Point> const& GetPoints() {
+
+		return points;
+
+	}
+
+	/**
+	 * Takes the current detectors, beam position and world volume,
+	 * called at the beginning of every run.
+	 */
+	void Prepare();
+
+	void UserSteppingAction(G4Step const*) override;
+
+	/**
+	 * Sets the world volume to cast rays through, taken from the tracking on Prepare.
+	 */
+	void SetWorldVolume(G4VPhysicalVolume*);
+
+	/**
+	 * Replaces the total hadronic cross sections used for attenuation.
+	 */
+	void SetCrossSection(CrossSection const&);
+
+	/**
+	 * Returns the probability density per steradian of the direction of a neutron
+	 * scattered elastically, isotropically in the centre of mass frame, and the ratio of
+	 * its kinetic energy to the incident one. The cosine is the one between the incident and
+	 * the scattered direction in the laboratory frame. Targets lighter than a neutron
+	 * are taken as heavy as a neutron.
+	 */
+	static G4double ElasticDensity(G4double massRatio, G4double cosine,
+			G4double& energyRatio);
+
+	/**
+	 * Returns the contribution of the emitted neutron of unit weight to the detector
+	 * at the global position: fluence per mm^2 for a point, or the expected number
+	 * of crossings of a disk of the given radius across the normal.
+	 * The energy the neutron arrives with is returned by the last argument.
+	 */
+	G4double Contribution(Emission const&, G4ThreeVector const& target,
+			G4double radius, G4ThreeVector const& normal,
+			G4double& kineticEnergy);
+
+	/**
+	 * Returns the probability of a neutron going along the direction to cross the disk
+	 * uncollided, zero if its line misses the disk. The distance to the crossing
+	 * is returned by the last argument.
+	 */
+	G4double Uncollided(G4ThreeVector const& position,
+			G4ThreeVector const& direction, G4double kineticEnergy,
+			G4ThreeVector const& target, G4double radius,
+			G4ThreeVector const& normal, G4double& distance);
+
+	/**
+	 * Returns the number of mean free paths of a neutron along the straight path.
+	 */
+	G4double OpticalDepth(G4ThreeVector const& from,
+			G4ThreeVector const& direction, G4double distance,
+			G4double kineticEnergy);
+
+private:
+
+	struct Target {
+		Point point;
+		G4ThreeVector globalPosition;
+		Basic* writer;
+	};
+
+	static std::vector<Point> points;
+
+	std::map<G4String, std::unique_ptr<Basic>> writers;
+	std::vector<Target> targets;
+	G4Navigator navigator;
+	CrossSection crossSection;
+
+	// beam direction in the world, disks are across it
+	G4ThreeVector normal;
+
+	void Estimate(Emission const&);
+	void EstimateUncollided(G4ThreeVector const& position,
+			G4ThreeVector const& direction, G4double kineticEnergy,
+			G4double time, G4double weight);
+
+};
+
+}
+
+}
+
+#endif	//	isnp_detector_NextEventAction_hh
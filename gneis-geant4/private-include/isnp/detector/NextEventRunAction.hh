@@ -0,0 +1,33 @@
+#ifndef isnp_detector_NextEventRunAction_hh
+#define isnp_detector_NextEventRunAction_hh
+
+#include <G4UserRunAction.hh>
+
+#include "isnp/detector/NextEventAction.hh"
+
+namespace isnp {
+
+namespace detector {
+
+/**
+ * Prepares the next-event estimator of the thread at the beginning of every run.
+ * Hits of the estimator are written by BasicRunAction as hits of the basic detectors.
+ */
+class NextEventRunAction: public G4UserRunAction {
+public:
+
+	NextEventRunAction(NextEventAction& anAction);
+
+	void BeginOfRunAction(G4Run const*) override;
+
+private:
+
+	NextEventAction& action;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_detector_NextEventRunAction_hh
@@ -0,0 +1,58 @@
+#ifndef isnp_detector_ScoringPlaneAction_hh
+#define isnp_detector_ScoringPlaneAction_hh
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <G4UserSteppingAction.hh>
+#include <G4RotationMatrix.hh>
+#include <G4ThreeVector.hh>
+
+#include "isnp/detector/Basic.hh"
+
+namespace isnp {
+
+namespace detector {
+
+/**
+ * Records particles crossing the scoring planes downstream.
+ * A crossing is found by the pre-step and the post-step points lying on different sides
+ * of a plane, the position is interpolated onto the plane, other quantities are taken
+ * at the pre-step point. Hits are written by binary basic detectors (one per plane and thread)
+ * with positions and directions in the beam coordinate system.
+ */
+class ScoringPlaneAction: public G4UserSteppingAction {
+public:
+
+	ScoringPlaneAction();
+	~ScoringPlaneAction() override;
+
+	/**
+	 * Takes the current planes and beam position, called at the beginning of every run.
+	 */
+	void Prepare();
+
+	void UserSteppingAction(G4Step const*) override;
+
+private:
+
+	struct Plane {
+		G4double z;
+		Basic* writer;
+	};
+
+	std::map<G4String, std::unique_ptr<Basic>> writers;
+	std::vector<Plane> planes;
+
+	// transformation from the world into the beam coordinate system
+	G4RotationMatrix rotation;
+	G4ThreeVector origin;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_detector_ScoringPlaneAction_hh
@@ -0,0 +1,33 @@
+#ifndef isnp_detector_ScoringPlaneRunAction_hh
+#define isnp_detector_ScoringPlaneRunAction_hh
+
+#include <G4UserRunAction.hh>
+
+#include "isnp/detector/ScoringPlaneAction.hh"
+
+namespace isnp {
+
+namespace detector {
+
+/**
+ * Prepares the scoring plane action of the thread at the beginning of every run.
+ * Hits of the planes are written by BasicRunAction as hits of the basic detectors.
+ */
+class ScoringPlaneRunAction: public G4UserRunAction {
+public:
+
+	ScoringPlaneRunAction(ScoringPlaneAction& anAction);
+
+	void BeginOfRunAction(G4Run const*) override;
+
+private:
+
+	ScoringPlaneAction& action;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_detector_ScoringPlaneRunAction_hh
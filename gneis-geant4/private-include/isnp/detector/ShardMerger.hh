@@ -0,0 +1,49 @@
+#ifndef isnp_detector_ShardMerger_hh
+#define isnp_detector_ShardMerger_hh
+
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+#include <G4String.hh>
+
+namespace isnp {
+
+namespace detector {
+
+/**
+ * Merges the files (shards) written by the detectors of worker threads into one output.
+ * Every shard holds hits in increasing event order, the output holds the hits of all
+ * the shards ordered by event, so it does not depend on the scheduling of the threads.
+ * Shards are read sequentially, so memory use does not depend on their size.
+ */
+class ShardMerger final {
+public:
+
+	class MergeException: public std::exception {
+
+	};
+
+	ShardMerger() = delete;
+
+	/**
+	 * Appends lines of text shards to the stream skipping their headers.
+	 * Event number is the last column of a line.
+	 */
+	static void MergeText(std::vector<G4String> const& shards, std::ostream& os);
+
+	/**
+	 * Appends rows of binary shards to the stream by frames of at most frameSize rows.
+	 * Category dictionaries of the shards are merged by name.
+	 */
+	static void MergeBinary(std::vector<G4String> const& shards,
+			G4String const& eventColumn, std::ostream& os, std::size_t frameSize);
+
+};
+
+}
+
+}
+
+#endif	//	isnp_detector_ShardMerger_hh
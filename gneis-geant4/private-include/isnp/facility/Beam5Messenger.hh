@@ -9,6 +9,8 @@
 #include <G4UIcmdWithAString.hh>
 #include <G4UIcmdWithABool.hh>
 #include <G4UIcmdWithADoubleAndUnit.hh>
+#include <G4UIcmdWithADouble.hh>
+#include <G4UIcmdWithAnInteger.hh>
 
 #include "isnp/facility/Beam5.hh"
 
@@ -33,7 +35,15 @@ private:
 			yAngleCmd;
 	std::unique_ptr<G4UIcmdWithAnInteger> const verboseCmd;
 	std::unique_ptr<G4UIcmdWithAString> const c5MaterialCmd;
-	std::unique_ptr<G4UIcmdWithABool> const hasTargetCmd;
+	std::unique_ptr<G4UIcmdWithABool> const hasTargetCmd, fastVacuumCmd,
+			c1NativeCmd, c2NativeCmd, hasSectionsCmd;
+	std::unique_ptr<G4UIcmdWithADouble> const sectionSmartlessCmd;
+	std::unique_ptr<G4UIcmdWithAnInteger> const navigationBenchmarkCmd;
+	std::unique_ptr<G4UIdirectory> const regionDirectory;
+	std::unique_ptr<G4UIcommand> const regionCutCmd, regionMaxTimeCmd,
+			regionMinEnergyCmd;
+
+	static Beam5::Region StringToRegion(G4String const& name);
 
 };
 
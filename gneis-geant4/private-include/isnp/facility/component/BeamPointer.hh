@@ -5,6 +5,7 @@
 
 #include <G4ThreeVector.hh>
 #include "isnp/util/Singleton.hh"
+#include "isnp/util/ApertureChain.hh"
 
 namespace isnp {
 
@@ -23,6 +24,12 @@ public:
 	G4ThreeVector GetPosition() const;
 	void SetPosition(G4ThreeVector v);
 
+	/**
+	 * Apertures of the beam line in the beam coordinate system, empty if unknown.
+	 */
+	util::ApertureChain const& GetApertures() const;
+	void SetApertures(util::ApertureChain const& anApertures);
+
 private:
 
 	friend class util::Singleton<BeamPointer>;
@@ -31,6 +38,7 @@ private:
 
 	std::unique_ptr<BeamPointerMessenger> const messenger;
 	G4ThreeVector rotation, position;
+	util::ApertureChain apertures;
 
 };
 
@@ -28,6 +28,13 @@ protected:
 	static G4VSolid* SolidWithAperture(const G4String &name, G4VSolid* outer,
 			util::Box const& aperture);
 
+	/**
+	 * Places the aperture filled with the material into the component
+	 * as a daughter volume, the native alternative to SolidWithAperture.
+	 */
+	static void PlaceAperture(const G4String &name, G4LogicalVolume* component,
+			util::Box const& aperture, G4Material* material);
+
 };
 
 }
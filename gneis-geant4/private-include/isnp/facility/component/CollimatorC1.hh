@@ -24,6 +24,13 @@ public:
 	G4LogicalVolume* AsCylinder(const G4String &name,
 			G4double outerRadius) const;
 
+	/**
+	 * Makes the cylinder without boolean subtraction: the aperture is a daughter volume
+	 * of the material (the material of the volume the collimator is placed in).
+	 */
+	G4LogicalVolume* AsNativeCylinder(G4double outerRadius,
+			G4Material* apertureMaterial) const;
+
 	G4LogicalVolume* Instance(G4VSolid *outer) const;
 	G4LogicalVolume* Instance(const G4String &name, G4VSolid *outer) const;
 
@@ -35,6 +42,12 @@ public:
 
 	}
 
+	util::Box const& GetAperture() const {
+
+		return aperture;
+
+	}
+
 private:
 
 	util::Box const aperture;
@@ -0,0 +1,72 @@
+#ifndef isnp_facility_component_ImportanceRegions_hh
+#define isnp_facility_component_ImportanceRegions_hh
+
+#include <memory>
+#include <vector>
+
+#include <G4String.hh>
+#include "isnp/util/Singleton.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+class ImportanceRegionsMessenger;
+
+/**
+ * Importance of the regions along the beam for geometric importance biasing.
+ * A region starts at the given Z position in the beam coordinate system and ends
+ * where the next region starts, the last one spans to the end of the world.
+ * Space before the first region has importance 1.
+ * Regions are slices across the whole world placed in a parallel world (see ImportanceWorld),
+ * so they do not depend on the volumes of the facility.
+ */
+class ImportanceRegions: public util::Singleton<ImportanceRegions> {
+public:
+
+	struct Region {
+		G4String name;
+		G4double z;
+		G4double importance;
+	};
+
+	/**
+	 * Returns the regions ordered by Z.
+	 */
+	std::vector<Region> const& GetRegions() const {
+
+		return regions;
+
+	}
+
+	/**
+	 * Adds a region or replaces the region with the same name.
+	 */
+	void Add(G4String const& name, G4double z, G4double importance);
+	void Clear();
+
+	/**
+	 * Returns the regions as "name importance z" triples, positions in mm.
+	 */
+	G4String ToString() const;
+
+private:
+
+	friend class util::Singleton<ImportanceRegions>;
+
+	ImportanceRegions();
+
+	std::unique_ptr<ImportanceRegionsMessenger> const messenger;
+	std::vector<Region> regions;
+
+};
+
+}
+
+}
+
+}
+
+#endif	//	isnp_facility_component_ImportanceRegions_hh
@@ -0,0 +1,46 @@
+#ifndef isnp_facility_component_ImportanceWorld_hh
+#define isnp_facility_component_ImportanceWorld_hh
+
+#include <utility>
+#include <vector>
+
+#include <G4VUserParallelWorld.hh>
+#include <G4VPhysicalVolume.hh>
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+/**
+ * Parallel world holding the cells of geometric importance biasing.
+ * Every region of ImportanceRegions becomes a slice of the world across the beam,
+ * the rest of the world has importance 1.
+ * Cells are built on the master thread, every thread fills its importance store.
+ * The world is navigated only if /isnp/importanceBiasing registers the biasing physics.
+ */
+class ImportanceWorld: public G4VUserParallelWorld {
+public:
+
+	static G4String const WorldName;
+
+	ImportanceWorld();
+
+	void Construct() override;
+	void ConstructSD() override;
+
+private:
+
+	G4VPhysicalVolume* ghostWorld;
+	std::vector<std::pair<G4VPhysicalVolume const*, G4double>> cells;
+
+};
+
+}
+
+}
+
+}
+
+#endif	//	isnp_facility_component_ImportanceWorld_hh
@@ -0,0 +1,91 @@
+#ifndef isnp_facility_component_OverlapCache_hh
+#define isnp_facility_component_OverlapCache_hh
+
+#include <cstdint>
+#include <memory>
+#include <set>
+
+#include <G4String.hh>
+#include <G4VPhysicalVolume.hh>
+#include "isnp/util/Singleton.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+class OverlapCacheMessenger;
+
+/**
+ * Checks overlaps of the constructed geometry once per geometry.
+ * The volumes are placed without checks, after the construction the geometry tree
+ * (names, materials, solids and placements) is hashed and the overlaps are checked
+ * only if the cache directory holds no verdict for the hash.
+ * The verdict (the number of overlapping volumes) is written into overlaps-<hash>.txt.
+ */
+class OverlapCache: public util::Singleton<OverlapCache> {
+public:
+
+	/**
+	 * Excludes the placement from the checks, e.g. a volume overlapping others on purpose.
+	 */
+	void Exclude(G4VPhysicalVolume const* placement);
+
+	/**
+	 * Checks overlaps of the world's volumes unless the verdict is cached,
+	 * returns the number of overlapping volumes.
+	 */
+	std::size_t Validate(G4VPhysicalVolume* world);
+
+	/**
+	 * Returns the content hash of the geometry tree.
+	 */
+	static uint64_t Hash(G4VPhysicalVolume const* world);
+
+	G4bool GetEnabled() const;
+	void SetEnabled(G4bool v);
+
+	G4String const& GetDirectory() const;
+	void SetDirectory(G4String const& v);
+
+	/**
+	 * Checks the overlaps on the next construction regardless of the cache.
+	 */
+	void Revalidate();
+
+private:
+
+	friend class util::Singleton<OverlapCache>;
+
+	OverlapCache();
+
+	std::unique_ptr<OverlapCacheMessenger> const messenger;
+	G4bool enabled, forced;
+	G4String directory;
+	std::set<G4VPhysicalVolume const*> excluded;
+
+	std::size_t Check(G4LogicalVolume* volume,
+			std::set<G4LogicalVolume const*>& checked) const;
+
+	/**
+	 * Checks the daughter against its mother and the sisters not excluded.
+	 */
+	G4bool Overlaps(G4LogicalVolume const* mother,
+			G4VPhysicalVolume const* daughter) const;
+
+	/**
+	 * Writes the verdict into a temporary file renamed to the cache file.
+	 */
+	void Write(G4String const& fileName, std::size_t numOfOverlaps) const;
+	G4String FileName(uint64_t hash) const;
+
+};
+
+}
+
+}
+
+}
+
+#endif	//	isnp_facility_component_OverlapCache_hh
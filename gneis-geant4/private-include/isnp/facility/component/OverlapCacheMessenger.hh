@@ -0,0 +1,44 @@
+#ifndef	isnp_facility_component_OverlapCacheMessenger_hh
+#define	isnp_facility_component_OverlapCacheMessenger_hh
+
+#include <memory>
+
+#include <G4UImessenger.hh>
+#include <G4UIdirectory.hh>
+#include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithoutParameter.hh>
+#include "isnp/facility/component/OverlapCache.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+class OverlapCacheMessenger: public G4UImessenger {
+public:
+
+	OverlapCacheMessenger(OverlapCache& component);
+	~OverlapCacheMessenger() override;
+
+	G4String GetCurrentValue(G4UIcommand* command) override;
+	void SetNewValue(G4UIcommand*, G4String) override;
+
+private:
+
+	OverlapCache& component;
+	std::unique_ptr<G4UIdirectory> const directory;
+	std::unique_ptr<G4UIcmdWithABool> const enableCmd;
+	std::unique_ptr<G4UIcmdWithAString> const directoryCmd;
+	std::unique_ptr<G4UIcmdWithoutParameter> const revalidateCmd;
+
+};
+
+}
+
+}
+
+}
+
+#endif	//	isnp_facility_component_OverlapCacheMessenger_hh
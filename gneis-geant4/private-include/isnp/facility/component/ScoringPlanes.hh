@@ -0,0 +1,67 @@
+#ifndef isnp_facility_component_ScoringPlanes_hh
+#define isnp_facility_component_ScoringPlanes_hh
+
+#include <memory>
+#include <vector>
+
+#include <G4String.hh>
+#include "isnp/util/Singleton.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+class ScoringPlanesMessenger;
+
+/**
+ * Zero-thickness planes across the beam recording particles which cross them downstream.
+ * A plane is given by its Z position in the beam coordinate system and has no volume,
+ * so it may be put at any position of any facility without overlaps.
+ * Crossings are written into <plane>.bin files in the binary sample format
+ * with positions in the beam coordinate system, so Resampling gun loads them directly.
+ */
+class ScoringPlanes: public util::Singleton<ScoringPlanes> {
+public:
+
+	struct Plane {
+		G4String name;
+		G4double z;
+	};
+
+	std::vector<Plane> const& GetPlanes() const {
+
+		return planes;
+
+	}
+
+	/**
+	 * Adds a plane or moves the plane with the same name.
+	 */
+	void Add(G4String const& name, G4double z);
+	void Clear();
+
+	/**
+	 * Returns the planes as "name z" pairs, positions in mm.
+	 */
+	G4String ToString() const;
+
+private:
+
+	friend class util::Singleton<ScoringPlanes>;
+
+	ScoringPlanes();
+
+	std::unique_ptr<ScoringPlanesMessenger> const messenger;
+	std::vector<Plane> planes;
+
+};
+
+}
+
+}
+
+}
+
+#endif	//	isnp_facility_component_ScoringPlanes_hh
@@ -0,0 +1,42 @@
+#ifndef	isnp_facility_component_ScoringPlanesMessenger_hh
+#define	isnp_facility_component_ScoringPlanesMessenger_hh
+
+#include <memory>
+
+#include <G4UImessenger.hh>
+#include <G4UIdirectory.hh>
+#include <G4UIcommand.hh>
+#include <G4UIcmdWithoutParameter.hh>
+#include "isnp/facility/component/ScoringPlanes.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+class ScoringPlanesMessenger: public G4UImessenger {
+public:
+
+	ScoringPlanesMessenger(ScoringPlanes& component);
+	~ScoringPlanesMessenger() override;
+
+	G4String GetCurrentValue(G4UIcommand* command) override;
+	void SetNewValue(G4UIcommand*, G4String) override;
+
+private:
+
+	ScoringPlanes& component;
+	std::unique_ptr<G4UIdirectory> const directory;
+	std::unique_ptr<G4UIcommand> const addCmd;
+	std::unique_ptr<G4UIcmdWithoutParameter> const clearCmd;
+
+};
+
+}
+
+}
+
+}
+
+#endif	//	isnp_facility_component_ScoringPlanesMessenger_hh
@@ -2,6 +2,7 @@
 #define isnp_facility_component_SpallationTarget_hh
 
 #include <memory>
+#include <vector>
 
 #include <G4Transform3D.hh>
 #include <G4LogicalVolume.hh>
@@ -29,6 +30,18 @@ public:
 
 	void Place(G4LogicalVolume* destination);
 
+	/**
+	 * Returns true if the volume is a part of the last placed target:
+	 * the lead, its cooler or its supports.
+	 */
+	G4bool Contains(G4LogicalVolume const* volume) const;
+
+	std::vector<G4LogicalVolume*> const& GetVolumes() const {
+
+		return volumes;
+
+	}
+
 	G4bool GetHasCooler() const;
 	void SetHasCooler(G4bool v);
 
@@ -38,6 +51,14 @@ public:
 	G4ThreeVector GetPosition() const;
 	void SetPosition(G4ThreeVector v);
 
+	/**
+	 * If the lead is an extruded solid holding the screws and the cooler
+	 * as daughter volumes instead of a box with boolean subtractions.
+	 * Both geometries are equivalent, the native one is navigated faster.
+	 */
+	G4bool GetNative() const;
+	void SetNative(G4bool v);
+
 private:
 
 	friend class util::Singleton<SpallationTarget>;
@@ -49,6 +70,13 @@ private:
 	G4String const supportMaterial;
 	G4bool hasCooler;
 	G4ThreeVector rotation, position;
+	G4bool native;
+	std::vector<G4LogicalVolume*> volumes;
+
+	void PlaceNative(G4LogicalVolume* destination,
+			G4Transform3D const& transform);
+	void PlaceSupportPlane(G4LogicalVolume* destination,
+			G4Transform3D const& transform, G4String const& targetName);
 
 };
 
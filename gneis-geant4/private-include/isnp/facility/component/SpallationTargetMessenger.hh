@@ -30,6 +30,7 @@ private:
 	std::unique_ptr<G4UIdirectory> const directory;
 	std::unique_ptr<G4UIcmdWithABool> const hasCoolerCmd;
 	std::unique_ptr<G4UIcmdWith3VectorAndUnit> const rotationCmd, positionCmd;
+	std::unique_ptr<G4UIcmdWithABool> const nativeCmd;
 
 };
 
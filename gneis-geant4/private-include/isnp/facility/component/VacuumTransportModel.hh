@@ -0,0 +1,52 @@
+#ifndef isnp_facility_component_VacuumTransportModel_hh
+#define isnp_facility_component_VacuumTransportModel_hh
+
+#include <functional>
+
+#include <G4VFastSimulationModel.hh>
+#include <G4Material.hh>
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+/**
+ * Fast simulation of neutrons flying through evacuated volumes (the envelope region).
+ * A neutron is moved along a straight line to the exit surface of the volume in one step.
+ * Interactions with the residual gas are not simulated, the weight of the neutron
+ * is multiplied by the probability to cross the gas uncollided instead.
+ */
+class VacuumTransportModel: public G4VFastSimulationModel {
+public:
+
+	/**
+	 * Macroscopic cross section of a material at a kinetic energy of the neutron.
+	 */
+	using CrossSection = std::function<G4double(G4Material const*, G4double)>;
+
+	VacuumTransportModel(G4Envelope* envelope);
+
+	G4bool IsApplicable(G4ParticleDefinition const&) override;
+	G4bool ModelTrigger(G4FastTrack const&) override;
+	void DoIt(G4FastTrack const&, G4FastStep&) override;
+
+	/**
+	 * Replaces the total hadronic cross section of the neutron attenuating the weight.
+	 */
+	void SetCrossSection(CrossSection const& aCrossSection);
+
+private:
+
+	CrossSection crossSection;
+
+};
+
+}
+
+}
+
+}
+
+#endif	//	isnp_facility_component_VacuumTransportModel_hh
@@ -0,0 +1,43 @@
+#ifndef isnp_generator_EmulatorMessenger_hh
+#define isnp_generator_EmulatorMessenger_hh
+
+#include <memory>
+
+#include <G4UImessenger.hh>
+#include <G4UIdirectory.hh>
+#include <G4UIcommand.hh>
+#include <G4UIparameter.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithAnInteger.hh>
+
+#include "isnp/generator/Emulator.hh"
+
+namespace isnp {
+
+namespace generator {
+
+class EmulatorMessenger: public G4UImessenger {
+public:
+
+	EmulatorMessenger(Emulator& generator);
+	~EmulatorMessenger() override;
+
+	G4String GetCurrentValue(G4UIcommand*) override;
+	void SetNewValue(G4UIcommand*, G4String) override;
+
+private:
+
+	Emulator& generator;
+	std::unique_ptr<G4UIdirectory> const directory;
+	std::unique_ptr<G4UIcmdWithAnInteger> const verboseCmd;
+	std::unique_ptr<G4UIcmdWithAString> const fileCmd;
+	std::unique_ptr<G4UIcommand> const buildCmd;
+	std::unique_ptr<G4UIcommand> const binsCmd;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_generator_EmulatorMessenger_hh
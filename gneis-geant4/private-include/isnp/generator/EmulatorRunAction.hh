@@ -0,0 +1,32 @@
+#ifndef isnp_generator_EmulatorRunAction_hh
+#define isnp_generator_EmulatorRunAction_hh
+
+#include <G4UserRunAction.hh>
+
+#include "isnp/generator/Emulator.hh"
+
+namespace isnp {
+
+namespace generator {
+
+/**
+ * Master run action which loads the source table before worker threads start.
+ */
+class EmulatorRunAction: public G4UserRunAction {
+public:
+
+	EmulatorRunAction(Emulator& aGenerator);
+
+	void BeginOfRunAction(G4Run const*) override;
+
+private:
+
+	Emulator& generator;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_generator_EmulatorRunAction_hh
@@ -0,0 +1,107 @@
+#ifndef isnp_generator_EmulatorTable_hh
+#define isnp_generator_EmulatorTable_hh
+
+#include <array>
+#include <memory>
+#include <set>
+#include <iostream>
+
+#include <G4ThreeVector.hh>
+#include <G4ParticleDefinition.hh>
+
+#include "isnp/util/DataFrame.hh"
+#include "isnp/util/AliasTable.hh"
+
+namespace isnp {
+
+namespace generator {
+
+/**
+ * Double-differential table of a particle source: joint histogram of particle type,
+ * kinetic energy, polar and azimuthal angles of the direction around Z axis and
+ * the position projected along the direction onto z = 0, as Resampling does.
+ * All the quantities share one table, so their correlations are kept up to the bin size.
+ *
+ * The table is stored in the binary sample format with one row per non-empty bin
+ * holding the bin edges and the weight. Bins are drawn through an alias table built
+ * once on load, quantities are uniform within a bin (energy is log-uniform).
+ * Table is immutable and may be shared by several threads.
+ */
+class EmulatorTable {
+public:
+
+	typedef util::DataFrame::size_type size_type;
+
+	class EmptySampleException: public std::exception {
+
+	};
+
+	/**
+	 * Number of bins of every quantity, positions have the given number of bins
+	 * along both X and Y axes. Bins span the ranges of the sample values,
+	 * energy bins are logarithmic.
+	 */
+	struct Binning {
+		size_type energy, angle, azimuth, position;
+	};
+
+	struct Primary {
+		G4ParticleDefinition* particle;
+		G4double energy;
+		G4ThreeVector direction, position;
+	};
+
+	EmulatorTable(std::shared_ptr<util::DataFrame const> table);
+
+	/**
+	 * Returns the number of non-empty bins.
+	 */
+	size_type Size() const {
+
+		return size;
+
+	}
+
+	G4double GetTotalWeight() const {
+
+		return aliasTable->GetTotalWeight();
+
+	}
+
+	Primary Shoot() const;
+
+	static std::set<G4String> FloatColumns();
+	static std::set<G4String> CategoryColumns();
+
+	/**
+	 * Accumulates the rows of a sample into the bins and writes the table of the non-empty bins.
+	 * The sample has the columns of Resampling samples, the Weight column is optional.
+	 * Rows going backwards (non-positive Z direction) cannot be projected and are skipped.
+	 * Returns the number of non-empty bins.
+	 */
+	static size_type Build(util::DataFrame const& sample, Binning const& binning,
+			std::ostream& os);
+
+private:
+
+	struct Range {
+		G4float const* min;
+		G4float const* max;
+	};
+
+	std::shared_ptr<util::DataFrame const> const table;
+	size_type const size;
+	util::DataFrame::CategoryId const* const types;
+	Range const energy, cosTheta, phi, x, y;
+	std::array<G4ParticleDefinition*, 256> particles;
+	std::unique_ptr<util::AliasTable const> aliasTable;
+
+	Range MakeRange(G4String const& name) const;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_generator_EmulatorTable_hh
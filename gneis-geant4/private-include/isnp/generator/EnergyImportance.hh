@@ -0,0 +1,53 @@
+#ifndef isnp_generator_EnergyImportance_hh
+#define isnp_generator_EnergyImportance_hh
+
+#include <map>
+
+#include <G4Types.hh>
+#include <G4String.hh>
+
+namespace isnp {
+
+namespace generator {
+
+/**
+ * Piecewise constant importance of primary particles by kinetic energy.
+ * Every point sets the importance of energies from its energy up to the energy of the next point,
+ * energies below the first point have importance 1.
+ */
+class EnergyImportance {
+public:
+
+	/**
+	 * Energy is in internal units, importance must be positive.
+	 */
+	void Add(G4double energy, G4double importance);
+	void Clear();
+
+	G4bool IsEmpty() const {
+
+		return points.empty();
+
+	}
+
+	/**
+	 * Returns the importance of the energy given in internal units.
+	 */
+	G4double operator()(G4double energy) const;
+
+	/**
+	 * Returns the points as "energy importance" pairs, energies in MeV.
+	 */
+	G4String ToString() const;
+
+private:
+
+	std::map<G4double, G4double> points;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_generator_EnergyImportance_hh
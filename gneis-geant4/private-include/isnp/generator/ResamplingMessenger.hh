@@ -6,8 +6,11 @@
 #include <G4UImessenger.hh>
 #include <G4UIdirectory.hh>
 #include <G4UIcommand.hh>
+#include <G4UIparameter.hh>
 #include <G4UIcmdWithAString.hh>
 #include <G4UIcmdWithAnInteger.hh>
+#include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithoutParameter.hh>
 
 #include "isnp/generator/Resampling.hh"
 
@@ -30,6 +33,17 @@ private:
 	std::unique_ptr<G4UIdirectory> const directory;
 	std::unique_ptr<G4UIcmdWithAnInteger> const verboseCmd;
 	std::unique_ptr<G4UIcmdWithAString> const fileCmd;
+	std::unique_ptr<G4UIcommand> const convertCmd;
+	std::unique_ptr<G4UIcmdWithAString> const modeCmd;
+	std::unique_ptr<G4UIcmdWithAnInteger> const blockSizeCmd;
+	std::unique_ptr<G4UIcmdWithABool> const shuffleBlocksCmd;
+	std::unique_ptr<G4UIcommand> const importanceCmd;
+	std::unique_ptr<G4UIcmdWithoutParameter> const clearImportanceCmd;
+	std::unique_ptr<G4UIcmdWithABool> const acceptanceCmd;
+	std::unique_ptr<G4UIcmdWithABool> const projectPositionsCmd;
+
+	static G4String ModeToString(Resampling::Mode mode);
+	static Resampling::Mode StringToMode(G4String const& mode);
 
 };
 
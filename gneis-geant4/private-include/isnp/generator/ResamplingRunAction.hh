@@ -0,0 +1,33 @@
+#ifndef isnp_generator_ResamplingRunAction_hh
+#define isnp_generator_ResamplingRunAction_hh
+
+#include <G4UserRunAction.hh>
+
+#include "isnp/generator/Resampling.hh"
+
+namespace isnp {
+
+namespace generator {
+
+/**
+ * Master run action which loads the sample before worker threads start,
+ * so all the workers share a single copy of it.
+ */
+class ResamplingRunAction: public G4UserRunAction {
+public:
+
+	ResamplingRunAction(Resampling& aGenerator);
+
+	void BeginOfRunAction(G4Run const*) override;
+
+private:
+
+	Resampling& generator;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_generator_ResamplingRunAction_hh
@@ -0,0 +1,186 @@
+#ifndef isnp_generator_ResamplingSampler_hh
+#define isnp_generator_ResamplingSampler_hh
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include <G4ThreeVector.hh>
+#include <G4ParticleDefinition.hh>
+
+#include "isnp/util/DataFrame.hh"
+#include "isnp/util/AliasTable.hh"
+#include "isnp/util/ApertureChain.hh"
+#include "isnp/generator/EnergyImportance.hh"
+
+namespace isnp {
+
+namespace generator {
+
+/**
+ * View of the sample data frame bound to the columns used by Resampling.
+ * Column names, precisions and particle names are resolved once,
+ * so shooting a row does array indexing only.
+ * If the weight column is present rows are drawn with probabilities proportional
+ * to their weights using an alias table built once.
+ * If the energy importance is given energy rows are drawn with probabilities multiplied
+ * by the importance of the row energy, the bias is compensated by the row weight.
+ * If the apertures are given directions are drawn only from the rows whose directions
+ * fall into the acceptance cone of the apertures, the cone is widened by the spot of
+ * the sample positions projected onto z = 0. The bias is compensated by the weight
+ * fraction of these rows.
+ * Sampler is immutable and may be shared by several threads.
+ */
+class ResamplingSampler {
+public:
+
+	typedef util::DataFrame::size_type size_type;
+
+	ResamplingSampler(std::shared_ptr<util::DataFrame const> dataFrame,
+			G4String const& energyColumn, G4String const& directionXColumn,
+			G4String const& directionYColumn, G4String const& directionZColumn,
+			G4String const& positionXColumn, G4String const& positionYColumn,
+			G4String const& positionZColumn, G4String const& typeColumn,
+			G4String const& weightColumn, EnergyImportance const& importance,
+			util::ApertureChain const& apertures);
+
+	util::DataFrame const& GetDataFrame() const {
+
+		return *dataFrame;
+
+	}
+
+	size_type Size() const {
+
+		return size;
+
+	}
+
+	G4bool IsWeighted() const {
+
+		return static_cast<bool>(aliasTable);
+
+	}
+
+	/**
+	 * Returns the total weight of the rows, i.e. the number of rows if the sample is not weighted.
+	 */
+	G4double GetTotalWeight() const;
+
+	/**
+	 * Draws a row number, either uniformly or according to the weights.
+	 */
+	size_type ShootRow() const;
+
+	/**
+	 * Draws a row number for the energy and the position of a primary,
+	 * the same as ShootRow unless the energy importance is given.
+	 */
+	size_type ShootEnergyRow() const;
+
+	/**
+	 * Returns the weight compensating the energy importance of the row:
+	 * mean importance of the sample divided by the importance of the row.
+	 */
+	G4double EnergyRowWeight(size_type rowNo) const;
+
+	/**
+	 * Draws a row number for the direction of a primary,
+	 * the same as ShootRow unless the apertures are given.
+	 */
+	size_type ShootDirectionRow() const;
+
+	/**
+	 * Returns the weight compensating the directions out of the acceptance:
+	 * weight of the accepted rows divided by the total weight, 1 without apertures.
+	 */
+	G4double GetDirectionRowWeight() const {
+
+		return acceptance;
+
+	}
+
+	/**
+	 * Returns the number of rows whose directions are within the acceptance,
+	 * i.e. all the rows without apertures.
+	 */
+	size_type GetNumOfAcceptedRows() const {
+
+		return numOfAcceptedRows;
+
+	}
+
+	G4ParticleDefinition* Particle(size_type const rowNo) const {
+
+		return particles[types[rowNo]];
+
+	}
+
+	G4double ShootEnergy(size_type const rowNo) const {
+
+		return energy.Shoot(rowNo);
+
+	}
+
+	G4ThreeVector ShootDirection(size_type const rowNo) const {
+
+		return G4ThreeVector(directionX.Shoot(rowNo),
+				directionY.Shoot(rowNo), directionZ.Shoot(rowNo));
+
+	}
+
+	G4ThreeVector ShootPosition(size_type const rowNo) const {
+
+		return G4ThreeVector(positionX.Shoot(rowNo), positionY.Shoot(rowNo),
+				positionZ.Shoot(rowNo));
+
+	}
+
+private:
+
+	/**
+	 * Float column bound once, the locality range of a row is computed when it is shot,
+	 * so binding a memory-mapped column does not read it.
+	 */
+	class Column {
+	public:
+
+		Column(util::DataFrame const& dataFrame, G4String const& columnName);
+
+		G4double Shoot(size_type rowNo) const;
+
+		G4double Value(size_type const rowNo) const {
+
+			return values[rowNo];
+
+		}
+
+	private:
+
+		G4float const* const values;
+		unsigned const precision;
+
+	};
+
+	std::shared_ptr<util::DataFrame const> const dataFrame;
+	size_type const size;
+	Column const energy, directionX, directionY, directionZ, positionX,
+			positionY, positionZ;
+	util::DataFrame::CategoryId const* const types;
+	std::array<G4ParticleDefinition*, 256> particles;
+	std::unique_ptr<util::AliasTable const> aliasTable;
+	EnergyImportance const importance;
+	std::unique_ptr<util::AliasTable const> biasedTable;
+	G4double meanImportance;
+	std::unique_ptr<util::AliasTable const> acceptedTable;
+	size_type numOfAcceptedRows;
+	G4double acceptance;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_generator_ResamplingSampler_hh
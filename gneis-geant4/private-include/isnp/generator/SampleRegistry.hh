@@ -0,0 +1,95 @@
+#ifndef isnp_generator_SampleRegistry_hh
+#define isnp_generator_SampleRegistry_hh
+
+#include <map>
+#include <vector>
+#include <memory>
+#include <functional>
+
+#include <G4String.hh>
+#include <G4Threading.hh>
+
+#include "isnp/util/NonCopyable.hh"
+#include "isnp/generator/ResamplingSampler.hh"
+#include "isnp/generator/EmulatorTable.hh"
+#include "isnp/util/DataFrameBlockReader.hh"
+
+namespace isnp {
+
+namespace generator {
+
+/**
+ * Process-wide storage of loaded samples, sample readers and emulator tables.
+ * A sample is loaded once and shared read-only by the Resampling guns of all threads
+ * as long as at least one of them refers to it.
+ */
+class SampleRegistry: public util::NonCopyable {
+public:
+
+	typedef std::shared_ptr<ResamplingSampler const> SamplerPtr;
+	typedef std::function<SamplerPtr()> Loader;
+	typedef std::shared_ptr<util::DataFrameBlockReader const> ReaderPtr;
+	typedef std::function<ReaderPtr()> ReaderFactory;
+	typedef std::shared_ptr<std::vector<G4double> const> BlockWeightsPtr;
+	typedef std::function<BlockWeightsPtr()> BlockWeightsFactory;
+	typedef std::shared_ptr<EmulatorTable const> TablePtr;
+	typedef std::function<TablePtr()> TableLoader;
+
+	static SampleRegistry& GetInstance();
+
+	/**
+	 * Returns the sample of the given file, calls the loader if the sample is not loaded yet
+	 * or the file has been modified since it was loaded.
+	 * Concurrent callers wait until the sample is loaded.
+	 * Samples of the same file made with different settings are told apart by the variant.
+	 */
+	SamplerPtr Get(G4String const& fileName, Loader const& loader,
+			G4String const& variant = "");
+
+	/**
+	 * Returns the block reader of the given file and block size,
+	 * so a text file is indexed once for all threads.
+	 */
+	ReaderPtr GetReader(G4String const& fileName,
+			util::DataFrameBlockReader::size_type blockSize,
+			ReaderFactory const& factory);
+
+	/**
+	 * Returns the total weights of the blocks of the given file and block size,
+	 * so the file is summed up once for all threads.
+	 */
+	BlockWeightsPtr GetBlockWeights(G4String const& fileName,
+			util::DataFrameBlockReader::size_type blockSize,
+			G4String const& weightColumn, BlockWeightsFactory const& factory);
+
+	/**
+	 * Returns the emulator table of the given file, loaded once for all threads.
+	 */
+	TablePtr GetTable(G4String const& fileName, TableLoader const& loader);
+
+private:
+
+	struct Entry {
+		G4String stamp;
+		std::weak_ptr<void const> object;
+	};
+
+	G4Mutex mutex;
+	std::map<G4String, Entry> entries;
+
+	SampleRegistry();
+
+	template<typename T>
+	std::shared_ptr<T const> GetObject(G4String const& key,
+			G4String const& fileName,
+			std::function<std::shared_ptr<T const>()> const& factory);
+
+	static G4String FileStamp(G4String const& fileName);
+
+};
+
+}
+
+}
+
+#endif	//	isnp_generator_SampleRegistry_hh
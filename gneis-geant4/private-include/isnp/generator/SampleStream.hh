@@ -0,0 +1,73 @@
+#ifndef isnp_generator_SampleStream_hh
+#define isnp_generator_SampleStream_hh
+
+#include <memory>
+#include <vector>
+#include <future>
+#include <functional>
+
+#include "isnp/util/NonCopyable.hh"
+#include "isnp/util/DataFrameBlockReader.hh"
+#include "isnp/generator/ResamplingSampler.hh"
+
+namespace isnp {
+
+namespace generator {
+
+/**
+ * Source of sample rows for the streaming mode of Resampling.
+ * Sample file is read by blocks, the next block is read by a background thread
+ * while the current one is in use, so at most two blocks reside in memory.
+ * Every block is used for the number of events proportional to its weight, i.e. as many
+ * as it has rows times the ratio of its mean row weight to the one of the whole file,
+ * so events are distributed over the blocks as in the whole-file draw.
+ * Fractional numbers are rounded randomly up or down keeping the mean,
+ * blocks given no events are not read.
+ * Blocks are taken either sequentially or in random order reshuffled on every pass.
+ */
+class SampleStream: public util::NonCopyable {
+public:
+
+	typedef util::DataFrameBlockReader::size_type size_type;
+	typedef std::function<
+			std::shared_ptr<ResamplingSampler const>(util::DataFrame&&)> SamplerFactory;
+
+	/**
+	 * Block weights are the sums of the row weights of every block,
+	 * if empty every row has weight 1.
+	 */
+	SampleStream(std::shared_ptr<util::DataFrameBlockReader const> aReader,
+			std::shared_ptr<std::vector<G4double> const> aBlockWeights,
+			G4bool aShuffleBlocks, size_type firstBlockNo,
+			SamplerFactory const& aSamplerFactory);
+	~SampleStream() override;
+
+	/**
+	 * Returns the block to draw the next event from.
+	 */
+	ResamplingSampler const& Next();
+
+private:
+
+	std::shared_ptr<util::DataFrameBlockReader const> const reader;
+	std::shared_ptr<std::vector<G4double> const> const blockWeights;
+	G4double meanWeight;
+	G4bool const shuffleBlocks;
+	SamplerFactory const samplerFactory;
+	std::vector<size_type> order;
+	size_type position;
+	std::future<util::DataFrame> nextBlock;
+	size_type nextNumOfEvents;
+	std::shared_ptr<ResamplingSampler const> current;
+	size_type remaining;
+
+	void Prefetch();
+	size_type NumOfEvents(size_type blockNo) const;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_generator_SampleStream_hh
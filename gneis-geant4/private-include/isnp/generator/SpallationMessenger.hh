@@ -34,9 +34,13 @@ private:
 			yWidthCmd, positionXCmd, positionYCmd;
 	std::unique_ptr<G4UIcmdWithAnInteger> const verboseCmd;
 	std::unique_ptr<G4UIcmdWithAString> const modeCmd;
+	std::unique_ptr<G4UIcmdWithAString> const circleEngineCmd;
 
 	static G4String ModeToString(Spallation::Mode mode);
 	static Spallation::Mode StringToMode(G4String const& mode);
+	static G4String EngineToString(dist::UniformCircleProps::Engine engine);
+	static dist::UniformCircleProps::Engine StringToEngine(
+			G4String const& engine);
 
 };
 
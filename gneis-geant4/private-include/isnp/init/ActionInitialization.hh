@@ -0,0 +1,49 @@
+#ifndef isnp_init_ActionInitialization_hh
+#define isnp_init_ActionInitialization_hh
+
+#include <memory>
+#include <functional>
+
+#include <G4VUserActionInitialization.hh>
+#include <G4VUserPrimaryGeneratorAction.hh>
+
+namespace isnp {
+
+namespace init {
+
+/**
+ * Creates user actions for every worker thread (or for the only thread in sequential mode).
+ * In multithreaded mode the master thread gets its own generator instance which is never
+ * used for event generation. It provides generator's UI commands on the master thread and,
+ * for the resampling and the emulator guns, loads the sample (table) shared by the workers.
+ * Every thread gets a run action closing the output of the basic detectors.
+ * Worker threads also get stepping actions recording particles crossing the scoring planes
+ * and the next-event estimates of the flux at the point detectors, and a stacking action
+ * dropping the particles which are not scored. Numbers of the dropped particles and
+ * of the steps made by the workers are printed at the end of every run.
+ */
+class ActionInitialization: public G4VUserActionInitialization {
+public:
+
+	typedef std::function<G4VUserPrimaryGeneratorAction*()> GeneratorFactory;
+
+	ActionInitialization(GeneratorFactory const& aGeneratorFactory);
+	~ActionInitialization() override;
+
+	void BuildForMaster() const override;
+	void Build() const override;
+
+private:
+
+	GeneratorFactory const generatorFactory;
+	std::unique_ptr<G4VUserPrimaryGeneratorAction> const masterGenerator;
+
+	static bool IsMultithreaded();
+
+};
+
+}
+
+}
+
+#endif	//	isnp_init_ActionInitialization_hh
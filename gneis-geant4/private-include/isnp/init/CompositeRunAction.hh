@@ -0,0 +1,35 @@
+#ifndef isnp_init_CompositeRunAction_hh
+#define isnp_init_CompositeRunAction_hh
+
+#include <memory>
+#include <vector>
+
+#include <G4UserRunAction.hh>
+
+namespace isnp {
+
+namespace init {
+
+/**
+ * Run action calling several run actions in the order they are added,
+ * since a run manager accepts only one.
+ */
+class CompositeRunAction: public G4UserRunAction {
+public:
+
+	void Add(std::unique_ptr<G4UserRunAction>&& action);
+
+	void BeginOfRunAction(G4Run const*) override;
+	void EndOfRunAction(G4Run const*) override;
+
+private:
+
+	std::vector<std::unique_ptr<G4UserRunAction>> actions;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_init_CompositeRunAction_hh
@@ -0,0 +1,87 @@
+#ifndef isnp_init_CompositeSteppingAction_hh
+#define isnp_init_CompositeSteppingAction_hh
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <G4UserSteppingAction.hh>
+
+namespace isnp {
+
+namespace init {
+
+/**
+ * Stepping action calling several stepping actions in the order they are added,
+ * since a run manager accepts only one.
+ * It also counts the steps of the thread if requested, see StepCountRunAction.
+ */
+class CompositeSteppingAction: public G4UserSteppingAction {
+public:
+
+	/**
+	 * Tells whether an action is needed in the run, e.g. whether it has anything to score.
+	 */
+	using Condition = std::function<G4bool()>;
+
+	CompositeSteppingAction();
+
+	/**
+	 * Adds an action called in the runs for which the condition holds at their start,
+	 * an action without a condition is called in every run.
+	 */
+	void Add(std::unique_ptr<G4UserSteppingAction>&& action,
+			Condition const& condition = nullptr);
+
+	/**
+	 * Selects the actions of the run starting, see StepCountRunAction.
+	 */
+	void Prepare();
+
+	void UserSteppingAction(G4Step const*) override;
+
+	uint64_t GetNumOfSteps() const {
+
+		return numOfSteps;
+
+	}
+
+	void ResetNumOfSteps() {
+
+		numOfSteps = 0;
+
+	}
+
+	/**
+	 * Steps are counted and their number is printed at the end of every run
+	 * to benchmark the geometry and the transport options.
+	 */
+	static void SetCountSteps(G4bool v);
+
+	static G4bool GetCountSteps() {
+
+		return countSteps;
+
+	}
+
+private:
+
+	struct Entry {
+		std::unique_ptr<G4UserSteppingAction> action;
+		Condition condition;
+	};
+
+	std::vector<Entry> entries;
+	std::vector<G4UserSteppingAction*> actions;
+	uint64_t numOfSteps;
+
+	static G4bool countSteps;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_init_CompositeSteppingAction_hh
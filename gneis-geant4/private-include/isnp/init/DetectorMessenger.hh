@@ -0,0 +1,43 @@
+#ifndef isnp_init_DetectorMessenger_hh
+#define isnp_init_DetectorMessenger_hh
+
+#include <memory>
+
+#include <G4UImessenger.hh>
+#include <G4UIdirectory.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithAnInteger.hh>
+#include <G4UIcmdWithABool.hh>
+
+#include "isnp/detector/Basic.hh"
+
+namespace isnp {
+
+namespace init {
+
+class DetectorMessenger: public G4UImessenger {
+public:
+
+	DetectorMessenger();
+	~DetectorMessenger();
+
+	G4String GetCurrentValue(G4UIcommand* command) override;
+	void SetNewValue(G4UIcommand*, G4String) override;
+
+private:
+
+	std::unique_ptr<G4UIdirectory> const directory;
+	std::unique_ptr<G4UIcmdWithAString> const formatCmd;
+	std::unique_ptr<G4UIcmdWithAnInteger> const flushThresholdCmd;
+	std::unique_ptr<G4UIcmdWithABool> const writeHitsCmd;
+
+	static G4String FormatToString(detector::Basic::Format format);
+	static detector::Basic::Format StringToFormat(G4String const& format);
+
+};
+
+}
+
+}
+
+#endif	//	isnp_init_DetectorMessenger_hh
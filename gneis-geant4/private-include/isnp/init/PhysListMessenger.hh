@@ -5,13 +5,24 @@
 
 #include <G4RunManager.hh>
 #include <G4UImessenger.hh>
+#include <G4VStateDependent.hh>
 #include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithABool.hh>
+#include <G4VModularPhysicsList.hh>
+#include <G4GeometrySampler.hh>
 
 namespace isnp {
 
 namespace init {
 
-class PhysListMessenger: public G4UImessenger {
+class PhysicsTableCache;
+
+/**
+ * Physics list commands. Physics constructors needed by the facility settings
+ * are registered on /run/initialize, when the settings are known
+ * and the physics list is still open for registration.
+ */
+class PhysListMessenger: public G4UImessenger, public G4VStateDependent {
 public:
 
 	PhysListMessenger(G4RunManager& aRunManager);
@@ -20,13 +31,36 @@ public:
 	G4String GetCurrentValue(G4UIcommand* command) override;
 	void SetNewValue(G4UIcommand*, G4String) override;
 
+	G4bool Notify(G4ApplicationState requestedState) override;
+
 private:
 
 	G4RunManager& runManager;
 	std::unique_ptr<G4UIcmdWithAString> const physListCmd;
+	std::unique_ptr<G4UIcmdWithAString> const importanceBiasingCmd;
+	std::unique_ptr<G4UIcmdWithABool> const physicsCacheCmd;
+	std::unique_ptr<G4UIcmdWithAString> const physicsCacheDirCmd;
 	G4String physList;
+	G4VModularPhysicsList* physicsList;
+	G4String importanceBiasing;
+	std::unique_ptr<G4GeometrySampler> geometrySampler;
+	G4bool stepLimiterRegistered;
+	G4bool fastSimulationRegistered;
+	std::unique_ptr<PhysicsTableCache> const physicsTableCache;
 
 	void SetPhysList(G4String const& name);
+	void SetImportanceBiasing(G4String const& particleName);
+
+	/**
+	 * Registers importance biasing in the parallel importance world
+	 * once both the physics list and the biased particle are known.
+	 */
+	void RegisterImportanceBiasing();
+
+	/**
+	 * Registers the physics constructors the facility settings need.
+	 */
+	void RegisterFacilityPhysics();
 
 };
 
@@ -0,0 +1,60 @@
+#ifndef isnp_init_PhysicsTableCache_hh
+#define isnp_init_PhysicsTableCache_hh
+
+#include <G4VStateDependent.hh>
+#include <G4VUserPhysicsList.hh>
+#include <G4String.hh>
+
+namespace isnp {
+
+namespace init {
+
+/**
+ * Stores the physics tables built by the first run into a subdirectory of the cache
+ * directory and retrieves them in the following jobs with the same key:
+ * the physics list, Geant4 version, the materials, the production cuts
+ * and the geometry. The key is taken at the end of /run/initialize.
+ */
+class PhysicsTableCache: public G4VStateDependent {
+public:
+
+	PhysicsTableCache();
+
+	G4bool Notify(G4ApplicationState requestedState) override;
+
+	/**
+	 * Sets the physics list, the description is a part of the key,
+	 * e.g. the name of the list and the options changing its processes.
+	 */
+	void SetPhysicsList(G4VUserPhysicsList* list, G4String const& description);
+
+	G4bool GetEnabled() const;
+	void SetEnabled(G4bool v);
+
+	G4String const& GetDirectory() const;
+	void SetDirectory(G4String const& v);
+
+	/**
+	 * Returns the key of the current physics list, materials, cuts and geometry.
+	 */
+	G4String MakeKey() const;
+
+private:
+
+	G4VUserPhysicsList* physicsList;
+	G4String description;
+	G4bool enabled;
+	G4String directory;
+	G4bool initializing;
+	G4String pendingDirectory;
+
+	void Prepare();
+	void Store();
+
+};
+
+}
+
+}
+
+#endif	//	isnp_init_PhysicsTableCache_hh
@@ -0,0 +1,44 @@
+#ifndef isnp_init_ScoreMessenger_hh
+#define isnp_init_ScoreMessenger_hh
+
+#include <memory>
+#include <istream>
+
+#include <G4UImessenger.hh>
+#include <G4UIdirectory.hh>
+#include <G4UIcommand.hh>
+#include <G4UIcmdWithoutParameter.hh>
+
+#include "isnp/detector/Histogram.hh"
+
+namespace isnp {
+
+namespace init {
+
+class ScoreMessenger: public G4UImessenger {
+public:
+
+	ScoreMessenger();
+	~ScoreMessenger();
+
+	void SetNewValue(G4UIcommand*, G4String) override;
+
+private:
+
+	std::unique_ptr<G4UIdirectory> const directory;
+	std::unique_ptr<G4UIcommand> const histogram1DCmd, histogram2DCmd,
+			particleCmd, valueCmd, nextEventCmd;
+	std::unique_ptr<G4UIcmdWithoutParameter> const clearCmd, clearNextEventCmd;
+
+	static detector::Histogram::Axis ReadAxis(std::istream&);
+	static detector::Histogram::Quantity StringToQuantity(
+			G4String const& quantity);
+	static detector::Histogram::Scale StringToScale(G4String const& scale);
+
+};
+
+}
+
+}
+
+#endif	//	isnp_init_ScoreMessenger_hh
@@ -0,0 +1,108 @@
+#ifndef isnp_init_StackingAction_hh
+#define isnp_init_StackingAction_hh
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+#include <G4UserStackingAction.hh>
+#include <G4ParticleDefinition.hh>
+#include <G4Track.hh>
+
+namespace isnp {
+
+namespace init {
+
+/**
+ * Stacking action dropping secondary particles the study does not score:
+ * particles of the kill list, particles below the kinetic energy floor of their type
+ * and, in the neutrons only mode, all the particles but neutrons created
+ * outside the spallation target. Primary particles are never dropped.
+ * Dropped particles are counted (number and kinetic energy by particle type),
+ * the counters of all the threads are summed up and printed at the end of a run
+ * by StackingRunAction.
+ */
+class StackingAction: public G4UserStackingAction {
+public:
+
+	struct Count {
+		uint64_t tracks;
+		G4double energy;
+	};
+
+	typedef std::map<G4String, Count> Counts;
+
+	StackingAction();
+	~StackingAction() override;
+
+	static void Kill(G4String const& particleName);
+
+	static G4bool IsKilled(G4String const& particleName);
+
+	/**
+	 * Sets the kinetic energy below which particles of the type are dropped,
+	 * zero removes the floor.
+	 */
+	static void SetEnergyFloor(G4String const& particleName, G4double energy);
+
+	static G4double GetEnergyFloor(G4String const& particleName);
+
+	static void SetNeutronsOnlyOutsideTarget(G4bool v);
+
+	static G4bool GetNeutronsOnlyOutsideTarget() {
+
+		return neutronsOnlyOutsideTarget;
+
+	}
+
+	/**
+	 * Clears the kill list and the energy floors, turns off the neutrons only mode.
+	 */
+	static void Clear();
+
+	/**
+	 * Resets the counters and takes the current configuration,
+	 * called at the beginning of every run.
+	 */
+	void Prepare();
+
+	G4ClassificationOfNewTrack ClassifyNewTrack(G4Track const*) override;
+
+	uint64_t GetNumOfNewTracks() const {
+
+		return numOfNewTracks;
+
+	}
+
+	/**
+	 * Returns dropped particles by particle name.
+	 */
+	Counts GetCulled() const;
+
+private:
+
+	struct Rule {
+		G4bool kill;
+		G4double floor;
+	};
+
+	static std::set<G4String> killed;
+	static std::map<G4String, G4double> energyFloors;
+	static G4bool neutronsOnlyOutsideTarget;
+
+	// rules and counters by particle type, to avoid name lookups for every track
+	std::unordered_map<G4ParticleDefinition const*, Rule> rules;
+	std::unordered_map<G4ParticleDefinition const*, Count> culled;
+	uint64_t numOfNewTracks;
+
+	Rule const& RuleOf(G4ParticleDefinition const*);
+	G4bool IsOutsideTarget(G4Track const*) const;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_init_StackingAction_hh
@@ -0,0 +1,38 @@
+#ifndef isnp_init_StackingRunAction_hh
+#define isnp_init_StackingRunAction_hh
+
+#include <G4UserRunAction.hh>
+
+#include "isnp/init/StackingAction.hh"
+
+namespace isnp {
+
+namespace init {
+
+/**
+ * Prepares the stacking action of a worker thread at the beginning of every run
+ * and adds its counters of dropped particles to the run totals at the end.
+ * The master thread's instance (without a stacking action) prints the totals
+ * when all the workers have finished.
+ */
+class StackingRunAction: public G4UserRunAction {
+public:
+
+	StackingRunAction(StackingAction* anAction = nullptr);
+
+	void BeginOfRunAction(G4Run const*) override;
+	void EndOfRunAction(G4Run const*) override;
+
+private:
+
+	StackingAction* const action;
+
+	static void Print();
+
+};
+
+}
+
+}
+
+#endif	//	isnp_init_StackingRunAction_hh
@@ -0,0 +1,37 @@
+#ifndef isnp_init_StepCountRunAction_hh
+#define isnp_init_StepCountRunAction_hh
+
+#include <G4UserRunAction.hh>
+
+#include "isnp/init/CompositeSteppingAction.hh"
+
+namespace isnp {
+
+namespace init {
+
+/**
+ * Selects the stepping actions of a worker thread for the run starting.
+ * Adds the number of steps made by a worker thread to the run total.
+ * The master thread's instance (without a stepping action) prints the total
+ * and the number of steps per event when all the workers have finished
+ * if the steps are counted, see CompositeSteppingAction::SetCountSteps.
+ */
+class StepCountRunAction: public G4UserRunAction {
+public:
+
+	StepCountRunAction(CompositeSteppingAction* anAction = nullptr);
+
+	void BeginOfRunAction(G4Run const*) override;
+	void EndOfRunAction(G4Run const*) override;
+
+private:
+
+	CompositeSteppingAction* const action;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_init_StepCountRunAction_hh
@@ -5,7 +5,11 @@
 
 #include <G4RunManager.hh>
 #include <G4UImessenger.hh>
+#include <G4UIdirectory.hh>
+#include <G4UIcommand.hh>
 #include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithoutParameter.hh>
 
 namespace isnp {
 
@@ -24,6 +28,12 @@ private:
 
 	G4RunManager& runManager;
 	std::unique_ptr<G4UIcmdWithAString> const userActionCmd;
+	std::unique_ptr<G4UIdirectory> const stackingDirectory;
+	std::unique_ptr<G4UIcmdWithAString> const killCmd;
+	std::unique_ptr<G4UIcommand> const energyFloorCmd;
+	std::unique_ptr<G4UIcmdWithABool> const neutronsOutsideTargetCmd;
+	std::unique_ptr<G4UIcmdWithoutParameter> const clearStackingCmd;
+	std::unique_ptr<G4UIcmdWithABool> const countStepsCmd;
 	G4String userAction;
 
 	void SetUserAction(G4String const& name);
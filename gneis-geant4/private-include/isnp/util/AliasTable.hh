@@ -0,0 +1,89 @@
+#ifndef isnp_util_AliasTable_hh
+#define isnp_util_AliasTable_hh
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+#include <G4Types.hh>
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Vose alias table drawing row numbers with probabilities proportional to the row weights
+ * in constant time.
+ * Rows are split into chunks of equal size whose tables are built in parallel,
+ * an extra table over the chunk weights selects a chunk.
+ * Table is immutable and may be shared by several threads.
+ */
+class AliasTable {
+public:
+
+	class InvalidWeightException: public std::exception {
+
+	};
+
+	typedef std::size_t size_type;
+
+	static size_type const DefaultChunkSize = 1 << 20;
+
+	/**
+	 * Throws InvalidWeightException if a weight is negative or not finite
+	 * or all the weights are zero.
+	 * @param numOfThreads maximal number of building threads, 0 means the number of CPU cores
+	 */
+	AliasTable(G4float const* weights, size_type size, size_type chunkSize =
+			DefaultChunkSize, unsigned numOfThreads = 0);
+
+	size_type Size() const {
+
+		return entries.size();
+
+	}
+
+	G4double GetTotalWeight() const {
+
+		return totalWeight;
+
+	}
+
+	/**
+	 * Draws a row number using the engine of the current thread.
+	 */
+	size_type Shoot() const;
+
+	/**
+	 * Returns a row number for the given uniform random numbers from [0, 1).
+	 * The second number is used only if the table has several chunks.
+	 */
+	size_type Sample(G4double u, G4double v) const;
+
+private:
+
+	// probability to keep the drawn slot and the slot to jump to otherwise,
+	// alias of a row is relative to its chunk
+	struct Entry {
+		G4float probability;
+		uint32_t alias;
+	};
+
+	size_type const chunkSize;
+	std::vector<Entry> entries;
+	std::vector<Entry> chunkEntries;
+	G4double totalWeight;
+
+	template<typename T>
+	static G4double Build(T const* weights, size_type size, Entry* result);
+
+	static size_type Pick(Entry const* table, size_type size, G4double u);
+
+};
+
+}
+
+}
+
+#endif	//	isnp_util_AliasTable_hh
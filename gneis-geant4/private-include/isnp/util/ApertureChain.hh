@@ -0,0 +1,74 @@
+#ifndef isnp_util_ApertureChain_hh
+#define isnp_util_ApertureChain_hh
+
+#include <vector>
+
+#include <G4Types.hh>
+#include <G4String.hh>
+#include <G4ThreeVector.hh>
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Sequence of apertures along Z axis of the beam, e.g. collimator holes.
+ * Positions are in the beam coordinate system, particles start at z = 0.
+ */
+class ApertureChain {
+public:
+
+	G4bool IsEmpty() const {
+
+		return apertures.empty();
+
+	}
+
+	void Clear();
+
+	/**
+	 * Adds a rectangular aperture occupying [z, z + length] along Z axis.
+	 */
+	void AddRectangle(G4double z, G4double length, G4double width,
+			G4double height);
+
+	/**
+	 * Adds a round aperture occupying [z, z + length] along Z axis.
+	 */
+	void AddCircle(G4double z, G4double length, G4double diameter);
+
+	/**
+	 * Removes the apertures ending beyond the given Z position.
+	 */
+	void RemoveBeyond(G4double z);
+
+	/**
+	 * Returns true if a particle starting at z = 0 within the rectangular spot
+	 * |x| <= spotHalfWidth, |y| <= spotHalfHeight with the given direction may pass all the apertures.
+	 * The check is conservative: every direction which passes the apertures
+	 * from some point of the spot is accepted.
+	 */
+	G4bool IsInCone(G4ThreeVector const& direction, G4double spotHalfWidth,
+			G4double spotHalfHeight) const;
+
+	/**
+	 * Returns the apertures as text, apertures of equal chains have equal text.
+	 */
+	G4String ToString() const;
+
+private:
+
+	struct Aperture {
+		G4double end, halfWidth, halfHeight;
+		G4bool round;
+	};
+
+	std::vector<Aperture> apertures;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_util_ApertureChain_hh
@@ -0,0 +1,35 @@
+#ifndef isnp_util_ContentHash_hh
+#define isnp_util_ContentHash_hh
+
+#include <cstdint>
+#include <string>
+
+#include <G4String.hh>
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Hash of a text description used as a key of cached data on disk,
+ * unlike std::hash it is the same in all the runs and builds (FNV-1a).
+ */
+class ContentHash final {
+public:
+
+	ContentHash() = delete;
+
+	static uint64_t Of(std::string const& text);
+
+	/**
+	 * Returns the hash as 16 hexadecimal digits.
+	 */
+	static G4String ToString(uint64_t hash);
+
+};
+
+}
+
+}
+
+#endif	//	isnp_util_ContentHash_hh
@@ -0,0 +1,99 @@
+#ifndef isnp_util_DataFrameBlockReader_hh
+#define isnp_util_DataFrameBlockReader_hh
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "isnp/util/NonCopyable.hh"
+#include "isnp/util/DataFrame.hh"
+#include "isnp/util/DataFrameFormat.hh"
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Reads a sample file (either text or binary) by blocks of rows,
+ * so the whole sample never has to reside in memory.
+ * Text files are indexed once on construction.
+ * Precision of float columns is the one of the whole file rather than of a block.
+ */
+class DataFrameBlockReader: public NonCopyable {
+public:
+
+	typedef DataFrame::size_type size_type;
+
+	/**
+	 * Optional float columns are read if the file has them.
+	 */
+	DataFrameBlockReader(G4String const& fileName,
+			std::set<G4String> const& aFloatColumns,
+			std::set<G4String> const& aCategoryColumns, size_type aBlockSize,
+			std::set<G4String> const& anOptionalFloatColumns =
+					std::set<G4String>());
+	~DataFrameBlockReader() override;
+
+	size_type GetNumOfRows() const {
+
+		return numOfRows;
+
+	}
+
+	size_type GetBlockSize() const {
+
+		return blockSize;
+
+	}
+
+	size_type GetNumOfBlocks() const {
+
+		return (numOfRows + blockSize - 1) / blockSize;
+
+	}
+
+	/**
+	 * Reads the block with the given number.
+	 * Safe to call from several threads simultaneously.
+	 */
+	DataFrame Read(size_type blockNo) const;
+
+	/**
+	 * Reads the whole file and returns the sum of the float column over every block,
+	 * empty if the file has no such column.
+	 * Safe to call from several threads simultaneously.
+	 */
+	std::vector<G4double> SumByBlocks(G4String const& columnName) const;
+
+private:
+
+	std::set<G4String> const floatColumns, categoryColumns,
+			optionalFloatColumns;
+	size_type const blockSize;
+	int fd;
+	uint64_t fileSize;
+	bool binary;
+	size_type numOfRows;
+
+	// binary file
+	DataFrameFormat::Frames frames;
+
+	// text file
+	std::string header;
+	std::vector<uint64_t> blockOffsets;
+	std::map<G4String, unsigned> precisions;
+
+	void ReadAt(uint64_t offset, void* buffer, std::size_t size) const;
+	void IndexText();
+	DataFrame ReadBinary(size_type blockNo) const;
+	DataFrame ReadText(size_type blockNo) const;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_util_DataFrameBlockReader_hh
@@ -0,0 +1,156 @@
+#ifndef isnp_util_DataFrameFormat_hh
+#define isnp_util_DataFrameFormat_hh
+
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include <G4String.hh>
+
+#include "isnp/util/DataFrameLoader.hh"
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Layout of the binary (columnar) sample file.
+ *
+ * A file consists of a header, a column directory and column data.
+ * Every directory entry holds column's type, precision, name,
+ * category dictionary (for category columns) and an offset of column data
+ * relative to the beginning of the header.
+ * Column data are contiguous arrays of float32, uint8 or int32 values
+ * aligned to DataAlignment bytes. All numbers are stored in the byte order
+ * of the writer, a reader rejects files written with a different byte order.
+ *
+ * Such a header with its directory and data is called a frame. A file may consist
+ * of several frames written one after another (e.g. by a detector flushing its hits
+ * by chunks), all frames have the same columns. Category dictionaries of the frames
+ * are merged by category name.
+ */
+class DataFrameFormat {
+public:
+
+	DataFrameFormat() = delete;
+
+	enum class ColumnType
+		: uint8_t {
+			Float = 0, Category = 1, Integer = 2
+	};
+
+	struct Header {
+		char magic[8];
+		uint32_t byteOrder;
+		uint32_t version;
+		uint64_t rowCount;
+		uint32_t columnCount;
+		uint32_t reserved;
+	};
+
+	struct ColumnEntry {
+		uint8_t type;
+		uint8_t reserved[3];
+		uint32_t precision;
+		uint32_t nameLength;
+		uint32_t categoryCount;
+		uint64_t dataOffset;
+	};
+
+	struct CategoryEntry {
+		uint8_t id;
+		uint8_t reserved[3];
+		uint32_t nameLength;
+	};
+
+	class FormatException: public DataFrameLoader::LoaderException {
+
+	};
+
+	/**
+	 * Column as described in the directory, data offset is absolute.
+	 */
+	struct Column {
+		G4String name;
+		ColumnType type;
+		unsigned precision;
+		std::map<DataFrame::CategoryId, G4String> categoryNames;
+		uint64_t dataOffset;
+	};
+
+	struct Directory {
+		uint64_t rowCount;
+		std::vector<Column> columns;
+		// absolute offset of the next frame
+		uint64_t endOffset;
+	};
+
+	typedef std::map<DataFrame::CategoryId, G4String> CategoryNames;
+
+	/**
+	 * Function reading the given number of bytes at the given offset.
+	 * Throws FormatException if the bytes are beyond the end of the file.
+	 */
+	typedef std::function<void(uint64_t offset, void* buffer, std::size_t size)> Reader;
+
+	static char const Magic[8];
+	static uint32_t const ByteOrder;
+	static uint32_t const Version;
+	static std::size_t const DataAlignment;
+	// number of distinct values a category column can hold
+	static std::size_t const MaxCategories;
+
+	static std::size_t Align(std::size_t offset);
+
+	static std::size_t ElementSize(ColumnType type);
+
+	/**
+	 * All frames of a file.
+	 */
+	struct Frames {
+		uint64_t rowCount;
+		std::vector<Directory> directories;
+		// number of the first row of every frame
+		std::vector<uint64_t> firstRows;
+		// dictionaries merged by name, ids of the first frame are kept
+		std::map<G4String, CategoryNames> categoryNames;
+		// translation of category ids of every frame into the merged dictionary
+		std::map<G4String, std::vector<std::vector<DataFrame::CategoryId>>> categoryIds;
+
+		/**
+		 * Reads the given rows of the column with the given number into the buffer.
+		 * Rows may span several frames, category ids are translated.
+		 */
+		void ReadColumn(Reader const& read, std::size_t columnNo, uint64_t first,
+				std::size_t count, void* buffer) const;
+	};
+
+	/**
+	 * Reads and validates the header and the column directory
+	 * of the frame starting at the given offset.
+	 */
+	static Directory ReadDirectory(Reader const& read, uint64_t fileSize,
+			uint64_t frameOffset = 0);
+
+	/**
+	 * Reads and validates directories of all the frames of a file.
+	 */
+	static Frames ReadFrames(Reader const& read, uint64_t fileSize);
+
+	/**
+	 * Checks whether the stream starts with the binary format signature.
+	 * Stream position is restored.
+	 */
+	static bool IsBinary(std::istream& is);
+	static bool IsBinary(G4String const& fileName);
+
+};
+
+}
+
+}
+
+#endif	//	isnp_util_DataFrameFormat_hh
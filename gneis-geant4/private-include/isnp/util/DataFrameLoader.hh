@@ -13,7 +13,8 @@ namespace isnp {
 namespace util {
 
 /**
- * Loads DataFrame from a stream.
+ * Loads DataFrame from a tab-separated text.
+ * Text is split into chunks at line boundaries which are parsed in parallel.
  */
 class DataFrameLoader {
 
@@ -23,6 +24,10 @@ public:
 
 	};
 
+	class FileException: public LoaderException {
+
+	};
+
 	class NoColumnException: public LoaderException {
 	public:
 
@@ -64,15 +69,47 @@ public:
 
 	};
 
+	/**
+	 * Optional float columns are loaded if the text has them.
+	 */
 	DataFrameLoader(std::set<G4String> const& aFloatColumns,
-			std::set<G4String> const& aCategoryColumns);
+			std::set<G4String> const& aCategoryColumns,
+			std::set<G4String> const& anOptionalFloatColumns =
+					std::set<G4String>());
 
 	DataFrame load(std::istream&);
 
+	/**
+	 * Loads the file mapping it into memory instead of reading through a stream.
+	 */
+	DataFrame load(G4String const& fileName);
+
+	/**
+	 * Loads the text stored in the memory block.
+	 */
+	DataFrame load(char const* begin, char const* end);
+
+	unsigned GetNumOfThreads() const {
+
+		return numOfThreads;
+
+	}
+
+	/**
+	 * Sets maximal number of parsing threads, 0 means the number of CPU cores.
+	 */
+	void SetNumOfThreads(unsigned const aNumOfThreads) {
+
+		numOfThreads = aNumOfThreads;
+
+	}
+
 private:
 
-	std::set<G4String> const floatColumns, categoryColumns;
+	std::set<G4String> const floatColumns, categoryColumns,
+			optionalFloatColumns;
 	char const commentChar, separatorChar;
+	unsigned numOfThreads;
 
 };
 
@@ -0,0 +1,45 @@
+#ifndef isnp_util_DataFrameMapper_hh
+#define isnp_util_DataFrameMapper_hh
+
+#include <set>
+
+#include "isnp/util/DataFrame.hh"
+#include "isnp/util/DataFrameLoader.hh"
+#include "isnp/util/DataFrameFormat.hh"
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Maps DataFrame from a binary sample file (see DataFrameFormat) without copying column data.
+ * A file of several frames is copied into memory.
+ */
+class DataFrameMapper {
+
+public:
+
+	typedef DataFrameFormat::FormatException FormatException;
+
+	/**
+	 * Optional float columns are mapped if the file has them.
+	 */
+	DataFrameMapper(std::set<G4String> const& aFloatColumns,
+			std::set<G4String> const& aCategoryColumns,
+			std::set<G4String> const& anOptionalFloatColumns =
+					std::set<G4String>());
+
+	DataFrame map(G4String const& fileName);
+
+private:
+
+	std::set<G4String> const floatColumns, categoryColumns,
+			optionalFloatColumns;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_util_DataFrameMapper_hh
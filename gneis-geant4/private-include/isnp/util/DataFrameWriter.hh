@@ -0,0 +1,66 @@
+#ifndef isnp_util_DataFrameWriter_hh
+#define isnp_util_DataFrameWriter_hh
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "isnp/util/DataFrame.hh"
+#include "isnp/util/DataFrameFormat.hh"
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Writes columns into a stream in the binary sample format (see DataFrameFormat).
+ * Column values are not copied, they must stay valid until Write is called.
+ */
+class DataFrameWriter {
+public:
+
+	typedef std::map<DataFrame::CategoryId, G4String> CategoryNames;
+
+	DataFrameWriter(std::ostream&);
+
+	void AddFloatColumn(G4String const& columnName, unsigned precision,
+			G4float const* values);
+	void AddCategoryColumn(G4String const& columnName,
+			CategoryNames const& names, DataFrame::CategoryId const* values);
+
+	/**
+	 * Integer columns are not loaded into DataFrame, they carry auxiliary data
+	 * like event numbers.
+	 */
+	void AddIntegerColumn(G4String const& columnName, int32_t const* values);
+
+	/**
+	 * Writes the added columns as one frame of the given number of rows.
+	 */
+	void Write(DataFrame::size_type rowCount);
+
+	/**
+	 * Writes all the columns of the data frame.
+	 */
+	static void Write(DataFrame const&, std::ostream&);
+
+private:
+
+	struct Column {
+		G4String name;
+		DataFrameFormat::ColumnType type;
+		unsigned precision;
+		CategoryNames names;
+		void const* values;
+	};
+
+	std::ostream& os;
+	std::vector<Column> columns;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_util_DataFrameWriter_hh
@@ -0,0 +1,53 @@
+#ifndef isnp_util_MappedFile_hh
+#define isnp_util_MappedFile_hh
+
+#include <cstddef>
+#include <exception>
+
+#include <G4String.hh>
+
+#include "isnp/util/NonCopyable.hh"
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Read-only memory mapping of a whole disk file.
+ * Pages are shared with the page cache, so all threads and processes
+ * mapping the same file use a single copy of its content.
+ */
+class MappedFile: public NonCopyable {
+public:
+
+	class OpenException: public std::exception {
+
+	};
+
+	MappedFile(G4String const& fileName);
+	~MappedFile() override;
+
+	char const* GetData() const {
+
+		return data;
+
+	}
+
+	std::size_t GetSize() const {
+
+		return size;
+
+	}
+
+private:
+
+	char const* data;
+	std::size_t size;
+
+};
+
+}
+
+}
+
+#endif	//	isnp_util_MappedFile_hh
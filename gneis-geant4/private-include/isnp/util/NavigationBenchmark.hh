@@ -0,0 +1,37 @@
+#ifndef isnp_util_NavigationBenchmark_hh
+#define isnp_util_NavigationBenchmark_hh
+
+#include <cstdint>
+
+#include <G4Types.hh>
+#include <G4ThreeVector.hh>
+#include <G4VPhysicalVolume.hh>
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Shoots geantino rays through a geometry and measures the time spent by the navigator.
+ * Every ray starts at the origin and goes along Z axis of the world deviated by a random
+ * angle up to the spread, the ray ends at the world boundary.
+ * An open geometry is closed with optimisation for the benchmark and reopened after it.
+ */
+class NavigationBenchmark {
+public:
+
+	struct Result {
+		uint64_t numOfRays, numOfSteps;
+		G4double length, time;
+	};
+
+	static Result Run(G4VPhysicalVolume* world, G4ThreeVector const& origin,
+			G4double spread, uint64_t numOfRays);
+
+};
+
+}
+
+}
+
+#endif	//	isnp_util_NavigationBenchmark_hh
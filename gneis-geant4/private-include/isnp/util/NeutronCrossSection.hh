@@ -0,0 +1,30 @@
+#ifndef isnp_util_NeutronCrossSection_hh
+#define isnp_util_NeutronCrossSection_hh
+
+#include <G4Material.hh>
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Cross sections of neutrons taken from the hadronic processes of the physics list.
+ */
+class NeutronCrossSection final {
+public:
+
+	NeutronCrossSection() = delete;
+
+	/**
+	 * Returns the macroscopic cross section of the elastic scattering, inelastic
+	 * interactions, capture and fission in the material.
+	 */
+	static G4double Total(G4Material const* material, G4double kineticEnergy);
+
+};
+
+}
+
+}
+
+#endif	//	isnp_util_NeutronCrossSection_hh
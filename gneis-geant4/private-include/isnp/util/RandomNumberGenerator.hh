@@ -1,6 +1,8 @@
 #ifndef isnp_utl_RandomNumberGenerator_hh
 #define isnp_utl_RandomNumberGenerator_hh
 
+#include <cstddef>
+
 #include <G4Types.hh>
 
 namespace isnp {
@@ -18,6 +20,20 @@ public:
 
 	static G4double locality(G4double significant, unsigned precision);
 
+	/**
+	 * Fills the array with uniformly distributed numbers in (0, 1)
+	 * drawn from the engine in bulk rather than one by one.
+	 */
+	static void flatArray(G4double* v, std::size_t n);
+
+private:
+
+	/**
+	 * Returns decimal exponent of the locality range of the given number,
+	 * i.e. locality range is 10^exponent.
+	 */
+	static G4double localityExponent(G4double significant, unsigned precision);
+
 };
 
 }
@@ -1,22 +1,139 @@
-#include <fstream>
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <utility>
 #include <G4SystemOfUnits.hh>
+#include <G4EventManager.hh>
+#include <G4AutoLock.hh>
 #include "isnp/detector/Basic.hh"
+#include "isnp/detector/ShardMerger.hh"
 #include "isnp/util/FileNameBuilder.hh"
+#include "isnp/util/DataFrameWriter.hh"
 #include "isnp/info/Version.hh"
 #include "isnp/info/Geant4Version.hh"
 
+// size of the user-space buffer of an output file
+static std::size_t const BUFFER_SIZE = 4 * 1024 * 1024;
+
+// number of significant digits in the output file
+static unsigned const PRECISION = 6;
+
+// number of rows in a frame of a merged binary file
+static std::size_t const MERGE_FRAME_SIZE = 1024 * 1024;
+
+static G4String const EVENT_COLUMN = "Event";
+
+// detectors of the calling thread
+static G4ThreadLocal std::vector<isnp::detector::Basic*>* threadDetectors =
+		nullptr;
+
+// histograms of all the threads by detector names
+static std::map<G4String, std::vector<isnp::detector::Histogram>> histogramTotals;
+
+// real time and number of events of the runs accumulated into the histograms, in seconds
+static G4double histogramTime = 0.0;
+static uint64_t histogramEvents = 0;
+
+// output files and their shards written during the current run
+struct BasicOutput {
+	isnp::detector::Basic::Format format;
+	std::vector<G4String> shards;
+};
+
+static G4Mutex outputsMutex = G4MUTEX_INITIALIZER;
+static std::map<G4String, BasicOutput> outputs;
+static std::set<G4String> mergedOutputs;
+
+isnp::detector::Basic::Format isnp::detector::Basic::format =
+		isnp::detector::Basic::Format::Text;
+
+std::size_t isnp::detector::Basic::flushThreshold = 0;
+
+G4bool isnp::detector::Basic::writeHits = true;
+
+std::vector<isnp::detector::Histogram> isnp::detector::Basic::histogramDefinitions;
+
 isnp::detector::Basic::Basic() :
-		G4VSensitiveDetector("detector") {
+		Basic("detector") {
 
 }
 
 isnp::detector::Basic::Basic(const G4String& name) :
-		G4VSensitiveDetector(name) {
+		Basic(name, format, false) {
+
+}
+
+isnp::detector::Basic::Basic(const G4String& name, Format const aFormat) :
+		Basic(name, aFormat, true) {
+
+}
+
+isnp::detector::Basic::Basic(const G4String& name, Format const aFormat,
+		G4bool const aFormatFixed) :
+		G4VSensitiveDetector(name), shardNo(G4Threading::G4GetThreadId()), formatFixed(
+				aFormatFixed), histogramsPrepared(false), histogramEvent(-1), fileFormat(aFormat), fileWritten(
+				false) {
+
+	if (!threadDetectors) {
+		threadDetectors = new std::vector<Basic*>;
+	}
+	threadDetectors->push_back(this);
 
 }
 
 isnp::detector::Basic::~Basic() {
 	flush();
+
+	threadDetectors->erase(
+			std::remove(std::begin(*threadDetectors),
+					std::end(*threadDetectors), this),
+			std::end(*threadDetectors));
+}
+
+void isnp::detector::Basic::SetFormat(Format const aFormat) {
+	format = aFormat;
+}
+
+void isnp::detector::Basic::SetFlushThreshold(
+		std::size_t const aFlushThreshold) {
+	flushThreshold = aFlushThreshold;
+}
+
+void isnp::detector::Basic::SetWriteHits(G4bool const aWriteHits) {
+	writeHits = aWriteHits;
+}
+
+void isnp::detector::Basic::AddHistogram(Histogram const& histogram) {
+
+	auto const existing = FindHistogram(histogram.GetName());
+	if (existing) {
+		*existing = histogram;
+	} else {
+		histogramDefinitions.push_back(histogram);
+	}
+
+}
+
+isnp::detector::Histogram* isnp::detector::Basic::FindHistogram(
+		G4String const& name) {
+
+	auto const it = std::find_if(std::begin(histogramDefinitions),
+			std::end(histogramDefinitions), [&name](auto const& h) {
+				return h.GetName() == name;
+			});
+	return it == std::end(histogramDefinitions) ? nullptr : &*it;
+
+}
+
+void isnp::detector::Basic::ClearHistograms() {
+
+	histogramDefinitions.clear();
+
+	G4AutoLock lock(&outputsMutex);
+	histogramTotals.clear();
+	histogramTime = 0.0;
+	histogramEvents = 0;
+
 }
 
 G4bool isnp::detector::Basic::ProcessHits(G4Step* const aStep,
@@ -24,54 +141,473 @@ G4bool isnp::detector::Basic::ProcessHits(G4Step* const aStep,
 
 	const auto track = aStep->GetTrack();
 	const auto dp = track->GetDynamicParticle();
-	Data data;
 
-	auto const particleName = dp->GetParticleDefinition()->GetParticleName();
-	auto const findResult = keyMap.find(particleName);
+	Record(dp->GetParticleDefinition(), dp->GetTotalEnergy(),
+			dp->GetKineticEnergy(), dp->GetProperTime(),
+			dp->GetMomentumDirection(), aStep->GetPreStepPoint()->GetPosition(),
+			track->GetWeight());
+
+	aStep->GetTrack()->SetTrackStatus(fStopAndKill);
+	return true;
+}
+
+void isnp::detector::Basic::Record(G4ParticleDefinition const* const particle,
+		G4double const totalEnergy, G4double const kineticEnergy,
+		G4double const time, G4ThreeVector const& direction,
+		G4ThreeVector const& position, G4double const weight) {
+
+	if (!histogramsPrepared) {
+		histograms = histogramDefinitions;
+		histogramsPrepared = true;
+	}
+
+	if (!histograms.empty()) {
+		auto const event =
+				G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
+		if (event != histogramEvent) {
+			for (auto& h : histograms) {
+				h.EndHistory();
+			}
+			histogramEvent = event;
+		}
+
+		Histogram::Values values;
+		values[Histogram::Index(Histogram::Quantity::Energy)] = kineticEnergy
+				/ MeV;
+		values[Histogram::Index(Histogram::Quantity::Angle)] = direction.theta()
+				/ deg;
+		values[Histogram::Index(Histogram::Quantity::X)] = position.getX() / mm;
+		values[Histogram::Index(Histogram::Quantity::Y)] = position.getY() / mm;
+		values[Histogram::Index(Histogram::Quantity::Time)] = time / ns;
+
+		for (auto& h : histograms) {
+			h.Fill(particle, values, weight);
+		}
+	}
+
+	if (writeHits) {
+		hits.types.push_back(GetKey(particle));
+		hits.events.push_back(
+				G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID());
+		hits.totalEnergies.push_back(totalEnergy / MeV);
+		hits.kineticEnergies.push_back(kineticEnergy / MeV);
+		hits.times.push_back(time / ns);
+
+		hits.directionsX.push_back(direction.getX());
+		hits.directionsY.push_back(direction.getY());
+		hits.directionsZ.push_back(direction.getZ());
+
+		hits.positionsX.push_back(position.getX() / mm);
+		hits.positionsY.push_back(position.getY() / mm);
+		hits.positionsZ.push_back(position.getZ() / mm);
+
+		hits.weights.push_back(weight);
+
+		if (flushThreshold > 0 && hits.types.size() >= flushThreshold) {
+			StartWrite();
+		}
+	}
+
+}
+
+void isnp::detector::Basic::CloseRun() {
+
+	if (threadDetectors) {
+		for (auto const detector : *threadDetectors) {
+			detector->flush();
+			if (detector->shardNo >= 0) {
+				detector->CloseFile();
+			}
+			detector->MergeHistograms();
+		}
+	}
+
+}
+
+void isnp::detector::Basic::MergeRun(G4double const realTime,
+		G4int const numOfEvents) {
+
+	G4AutoLock lock(&outputsMutex);
+
+	histogramTime += realTime;
+	histogramEvents += numOfEvents;
+
+	for (auto const& totals : histogramTotals) {
+		for (auto const& h : totals.second) {
+			auto const name = totals.first + "." + h.GetName();
+			std::ofstream file(isnp::util::FileNameBuilder::Make(name, ".txt"));
+			h.Write(file);
+
+			// figure of merit 1 / (R^2 T) compares the efficiency of biased and analog runs,
+			// R is computed over the events since hits of one event are correlated
+			auto const total = h.GetTotal();
+			auto const error = total.RelativeError(histogramEvents);
+			if (error > 0 && histogramTime > 0) {
+				G4cout << "Detector: histogram " << name << ", weight "
+						<< total.weight << ", relative error " << error
+						<< ", figure of merit "
+						<< 1.0 / (error * error * histogramTime) << " 1/s\n";
+			}
+		}
+	}
+
+	for (auto& output : outputs) {
+		auto const& fileName = output.first;
+		auto& shards = output.second.shards;
+		if (shards.empty()) {
+			continue;
+		}
+
+		auto const binary = output.second.format == Format::Binary;
+		auto const first = mergedOutputs.insert(fileName).second;
+		auto const mode = (binary ? std::ios::binary : std::ios::openmode())
+				| (first ? std::ios::trunc : std::ios::app);
+
+		std::vector<char> buffer(BUFFER_SIZE);
+		std::ofstream file;
+		file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+		file.open(fileName, std::ios::out | mode);
+
+		try {
+			if (binary) {
+				ShardMerger::MergeBinary(shards, EVENT_COLUMN, file,
+						MERGE_FRAME_SIZE);
+			} else {
+				if (first) {
+					WriteTextHeader(file);
+				}
+				ShardMerger::MergeText(shards, file);
+			}
+		} catch (ShardMerger::MergeException const&) {
+			G4cerr << "Detector: cannot merge shards of " << fileName
+					<< ", shards are kept\n";
+			shards.clear();
+			continue;
+		}
+
+		for (auto const& shard : shards) {
+			std::remove(shard.c_str());
+		}
+		shards.clear();
+	}
+
+}
+
+void isnp::detector::Basic::Hits::Clear() {
+
+	types.clear();
+	events.clear();
+	totalEnergies.clear();
+	kineticEnergies.clear();
+	times.clear();
+	directionsX.clear();
+	directionsY.clear();
+	directionsZ.clear();
+	positionsX.clear();
+	positionsY.clear();
+	positionsZ.clear();
+	weights.clear();
+
+}
+
+isnp::detector::Basic::key_type isnp::detector::Basic::GetKey(
+		G4ParticleDefinition const* const particle) {
+
+	auto const findResult = keyMap.find(particle);
 	if (findResult != std::end(keyMap)) {
-		data.nameKey = findResult->second;
-	} else {
-		auto const key = keyMap.size();
-		keyMap[particleName] = key;
-		nameMap[key] = particleName;
-		data.nameKey = key;
+		return findResult->second;
 	}
 
-	data.totalEnergy = dp->GetTotalEnergy();
-	data.kineticEnergy = dp->GetKineticEnergy();
-	data.time = dp->GetProperTime();
-	data.direction = dp->GetMomentumDirection();
-	data.position = aStep->GetPreStepPoint()->GetPosition();
-	accum.push_back(data);
+	auto const key = names.size();
+	keyMap[particle] = key;
+	names.push_back(particle->GetParticleName());
+	return key;
+
+}
+
+void isnp::detector::Basic::StartWrite() {
+
+	// the buffers are swapped only when the previous chunk is written,
+	// so no more than two chunks reside in memory
+	WaitWrite();
+	std::swap(hits, pendingHits);
+	hits.Clear();
+
+	// particle names are copied since new ones may appear during writing
+	pendingWrite = std::async(std::launch::async,
+			[this](std::vector<G4String> const& typeNames) {
+				return Write(pendingHits, typeNames);
+			}, names);
+
+}
+
+void isnp::detector::Basic::WaitWrite() {
+
+	if (pendingWrite.valid()) {
+		Report(pendingWrite.get());
+	}
 
-	aStep->GetTrack()->SetTrackStatus(fStopAndKill);
-	return true;
 }
 
 void isnp::detector::Basic::flush() {
-	std::ofstream file(isnp::util::FileNameBuilder::Make(GetName(), ".txt"));
-	file << "# geant4 " << info::Geant4Version::GetAsString() << " "
+
+	WaitWrite();
+
+	if ((!fileWritten && writeHits) || !hits.types.empty()) {
+		Report(Write(hits, names));
+	}
+
+	hits.Clear();
+
+}
+
+void isnp::detector::Basic::Report(
+		std::vector<G4String> const& messages) const {
+
+	for (auto const& message : messages) {
+		G4cerr << "Detector " << GetName() << ": " << message << "\n";
+	}
+
+}
+
+std::vector<G4String> isnp::detector::Basic::Write(Hits const& chunk,
+		std::vector<G4String> const& typeNames) {
+
+	// may run on the background thread, so nothing is printed here
+	std::vector<G4String> messages;
+
+	if (!file.is_open()) {
+		OpenFile(typeNames, messages);
+	}
+	fileWritten = true;
+
+	if (fileFormat == Format::Binary) {
+		WriteBinary(chunk, typeNames, messages);
+	} else {
+		WriteText(file, chunk, typeNames);
+	}
+
+	// every written chunk leaves the file valid
+	file.flush();
+	if (!file) {
+		messages.push_back("cannot write " + MakeFileName(shardNo >= 0));
+	}
+
+	return messages;
+
+}
+
+void isnp::detector::Basic::OpenFile(std::vector<G4String> const& typeNames,
+		std::vector<G4String>& messages) {
+
+	if (!formatFixed) {
+		fileFormat = format;
+	}
+	if (fileFormat == Format::Binary
+			&& typeNames.size() > util::DataFrameFormat::MaxCategories) {
+		messages.push_back(
+				std::to_string(typeNames.size())
+						+ " particle types do not fit into the binary format, writing text");
+		fileFormat = Format::Text;
+	}
+
+	buffer.resize(BUFFER_SIZE);
+	file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+
+	if (fileFormat == Format::Binary) {
+		file.open(MakeFileName(shardNo >= 0), std::ios::binary);
+	} else {
+		file.open(MakeFileName(shardNo >= 0));
+		WriteTextHeader(file);
+	}
+
+	if (!file) {
+		messages.push_back("cannot open " + MakeFileName(shardNo >= 0));
+	}
+
+}
+
+void isnp::detector::Basic::CloseFile() {
+
+	if (!file.is_open()) {
+		return;
+	}
+
+	file.close();
+	RegisterShard(fileFormat);
+
+	if (overflowFile.is_open()) {
+		overflowFile.close();
+		RegisterShard(Format::Text);
+	}
+
+}
+
+void isnp::detector::Basic::RegisterShard(Format const shardFormat) {
+
+	G4AutoLock lock(&outputsMutex);
+	auto& output = outputs[MakeFileName(false, shardFormat)];
+	output.format = shardFormat;
+	output.shards.push_back(MakeFileName(true, shardFormat));
+
+}
+
+void isnp::detector::Basic::MergeHistograms() {
+
+	// the last event of the run ends its history
+	for (auto& h : histograms) {
+		h.EndHistory();
+	}
+	histogramEvent = -1;
+
+	G4AutoLock lock(&outputsMutex);
+
+	auto& totals = histogramTotals[GetName()];
+	for (auto const& h : histograms) {
+		auto const it = std::find_if(std::begin(totals), std::end(totals),
+				[&h](auto const& t) {
+					return t.GetName() == h.GetName();
+				});
+
+		if (it == std::end(totals)) {
+			totals.push_back(h);
+		} else {
+			try {
+				it->Merge(h);
+			} catch (Histogram::MismatchException const&) {
+				// definition has been changed since the previous run
+				*it = h;
+			}
+		}
+	}
+
+	// definitions are taken again on the next run
+	histograms.clear();
+	histogramsPrepared = false;
+
+}
+
+G4String isnp::detector::Basic::MakeFileName(G4bool const shard) const {
+
+	return MakeFileName(shard, fileFormat);
+
+}
+
+G4String isnp::detector::Basic::MakeFileName(G4bool const shard,
+		Format const aFormat) const {
+
+	auto const suffix = aFormat == Format::Binary ? ".bin" : ".txt";
+	return shard ?
+			isnp::util::FileNameBuilder::MakeShard(GetName(), shardNo, suffix) :
+			isnp::util::FileNameBuilder::Make(GetName(), suffix);
+
+}
+
+void isnp::detector::Basic::WriteTextHeader(std::ostream& os) {
+
+	os << "# geant4 " << info::Geant4Version::GetAsString() << " "
 			<< info::Geant4Version::GetDateAsString() << " isnp-exp-lib "
 			<< info::Version::GetAsString() << " "
 			<< info::Version::GetDateAsString() << "\n"
-			<< "Type\tTotalEnergy\tKineticEnergy\tTime\tDirectionX\tDirectionY\tDirectionZ\tPositionX\tPositionY\tPositionZ\n";
+			<< "Type\tTotalEnergy\tKineticEnergy\tTime\tDirectionX\tDirectionY\tDirectionZ\tPositionX\tPositionY\tPositionZ\tWeight\t"
+			<< EVENT_COLUMN << "\n";
+
+}
+
+void isnp::detector::Basic::WriteText(std::ostream& os, Hits const& chunk,
+		std::vector<G4String> const& typeNames) {
+
+	for (std::size_t i = 0; i < chunk.types.size(); i++) {
+		os << typeNames[chunk.types[i]]
+
+		<< '\t' << chunk.totalEnergies[i] << '\t' << chunk.kineticEnergies[i]
 
-	std::for_each(std::begin(accum), std::end(accum), [&](auto i) {
-		file << nameMap[i.nameKey]
+		<< '\t' << chunk.times[i]
 
-		<< '\t' << i.totalEnergy / MeV << '\t' << i.kineticEnergy / MeV
+		<< '\t' << chunk.directionsX[i] << '\t' << chunk.directionsY[i] << '\t'
+				<< chunk.directionsZ[i]
 
-		<< '\t' << i.time / ns
+				<< '\t' << chunk.positionsX[i] << '\t' << chunk.positionsY[i]
+				<< '\t' << chunk.positionsZ[i]
 
-		<< '\t' << i.direction.getX() << '\t' << i.direction.getY() << '\t'
-		<< i.direction.getZ()
+				<< '\t' << chunk.weights[i]
 
-		<< '\t' << i.position.getX() / mm << '\t'
-		<< i.position.getY() / mm << '\t' << i.position.getZ() / mm
+				<< '\t' << chunk.events[i]
 
-		<< '\n';
-	});
+				<< '\n';
+	}
 
-	accum.clear();
 }
 
+void isnp::detector::Basic::WriteBinary(Hits const& aChunk,
+		std::vector<G4String> const& typeNames,
+		std::vector<G4String>& messages) {
+
+	// particle types appeared after the binary file is started may not fit
+	// into the category column, hits of such types go to a text file
+	auto const maxKey = util::DataFrameFormat::MaxCategories;
+	Hits fitting, overflow;
+	auto const* chunk = &aChunk;
+	if (typeNames.size() > maxKey) {
+		for (std::size_t i = 0; i < aChunk.types.size(); i++) {
+			auto& target = aChunk.types[i] < maxKey ? fitting : overflow;
+			target.types.push_back(aChunk.types[i]);
+			target.events.push_back(aChunk.events[i]);
+			target.totalEnergies.push_back(aChunk.totalEnergies[i]);
+			target.kineticEnergies.push_back(aChunk.kineticEnergies[i]);
+			target.times.push_back(aChunk.times[i]);
+			target.directionsX.push_back(aChunk.directionsX[i]);
+			target.directionsY.push_back(aChunk.directionsY[i]);
+			target.directionsZ.push_back(aChunk.directionsZ[i]);
+			target.positionsX.push_back(aChunk.positionsX[i]);
+			target.positionsY.push_back(aChunk.positionsY[i]);
+			target.positionsZ.push_back(aChunk.positionsZ[i]);
+			target.weights.push_back(aChunk.weights[i]);
+		}
+
+		if (!overflow.types.empty()) {
+			auto const fileName = MakeFileName(shardNo >= 0, Format::Text);
+			if (!overflowFile.is_open()) {
+				overflowFile.open(fileName);
+				WriteTextHeader(overflowFile);
+				messages.push_back(
+						"particle types beyond the binary format limit are written to "
+								+ fileName);
+			}
+			WriteText(overflowFile, overflow, typeNames);
+			overflowFile.flush();
+			if (!overflowFile) {
+				messages.push_back("cannot write " + fileName);
+			}
+		}
+
+		chunk = &fitting;
+	}
+
+	util::DataFrameWriter::CategoryNames categoryNames;
+	for (key_type key = 0; key < std::min(typeNames.size(), maxKey); key++) {
+		categoryNames[key] = typeNames[key];
+	}
+
+	std::vector<util::DataFrame::CategoryId> const categories(
+			std::begin(chunk->types), std::end(chunk->types));
+
+	// every chunk is a self-contained frame appended to the file
+	util::DataFrameWriter writer(file);
+	writer.AddCategoryColumn("Type", categoryNames, categories.data());
+	writer.AddFloatColumn("TotalEnergy", PRECISION,
+			chunk->totalEnergies.data());
+	writer.AddFloatColumn("KineticEnergy", PRECISION,
+			chunk->kineticEnergies.data());
+	writer.AddFloatColumn("Time", PRECISION, chunk->times.data());
+	writer.AddFloatColumn("DirectionX", PRECISION, chunk->directionsX.data());
+	writer.AddFloatColumn("DirectionY", PRECISION, chunk->directionsY.data());
+	writer.AddFloatColumn("DirectionZ", PRECISION, chunk->directionsZ.data());
+	writer.AddFloatColumn("PositionX", PRECISION, chunk->positionsX.data());
+	writer.AddFloatColumn("PositionY", PRECISION, chunk->positionsY.data());
+	writer.AddFloatColumn("PositionZ", PRECISION, chunk->positionsZ.data());
+	writer.AddFloatColumn("Weight", PRECISION, chunk->weights.data());
+	writer.AddIntegerColumn(EVENT_COLUMN, chunk->events.data());
+	writer.Write(chunk->types.size());
+
+}
@@ -0,0 +1,31 @@
+#include <G4Run.hh>
+#include <G4Threading.hh>
+
+#include "isnp/detector/BasicRunAction.hh"
+#include "isnp/detector/Basic.hh"
+
+namespace isnp {
+
+namespace detector {
+
+void BasicRunAction::BeginOfRunAction(G4Run const*) {
+
+	timer.Start();
+
+}
+
+void BasicRunAction::EndOfRunAction(G4Run const* const run) {
+
+	Basic::CloseRun();
+
+	// master's run ends when all the workers have closed their shards
+	if (G4Threading::IsMasterThread()) {
+		timer.Stop();
+		Basic::MergeRun(timer.GetRealElapsed(), run->GetNumberOfEvent());
+	}
+
+}
+
+}
+
+}
@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "isnp/detector/Histogram.hh"
+
+namespace isnp {
+
+namespace detector {
+
+std::size_t const Histogram::NumOfQuantities;
+
+Histogram::Axis::Axis(Quantity const aQuantity, std::size_t const aNumOfBins,
+		G4double const aMin, G4double const aMax, Scale const aScale) :
+		quantity(aQuantity), numOfBins(aNumOfBins), min(aMin), max(aMax), scale(
+				aScale), low(0), binsPerUnit(0) {
+
+	if (numOfBins == 0 || !(max > min) || (scale == Scale::Log && !(min > 0))) {
+		throw InvalidAxisException();
+	}
+
+	low = scale == Scale::Log ? Log(min) : min;
+	auto const high = scale == Scale::Log ? Log(max) : max;
+	binsPerUnit = numOfBins / (high - low);
+
+}
+
+G4double Histogram::Axis::LowerEdge(std::size_t const bin) const {
+
+	auto const edge = low + bin / binsPerUnit;
+	return scale == Scale::Log ? std::pow(10.0, edge) : edge;
+
+}
+
+bool Histogram::Axis::operator==(Axis const& a) const {
+
+	return quantity == a.quantity && numOfBins == a.numOfBins && min == a.min
+			&& max == a.max && scale == a.scale;
+
+}
+
+G4double Histogram::Axis::Log(G4double const value) {
+
+	return value > 0 ?
+			std::log10(value) : -std::numeric_limits<G4double>::infinity();
+
+}
+
+void Histogram::Bin::EndHistory() {
+
+	weight2 += history * history;
+	history = 0.0;
+
+}
+
+void Histogram::Bin::Merge(Bin const& b) {
+
+	if (b.count == 0) {
+		return;
+	}
+
+	// Chan et al. parallel variant of Welford's algorithm
+	auto const w = weight + b.weight;
+	auto const delta = b.mean - mean;
+	mean += delta * b.weight / w;
+	m2 += b.m2 + delta * delta * weight * b.weight / w;
+	weight = w;
+	weight2 += b.weight2;
+	count += b.count;
+
+}
+
+G4double Histogram::Bin::Variance() const {
+
+	// reduces to the sample variance if all the weights are equal
+	return count > 1 ? m2 / weight * count / (count - 1) : 0.0;
+
+}
+
+G4double Histogram::Bin::RelativeError(uint64_t const numOfHistories) const {
+
+	if (!(weight > 0) || numOfHistories == 0) {
+		return 0.0;
+	}
+
+	// R^2 = sum x^2 / (sum x)^2 - 1 / N over the histories
+	auto const r2 = weight2 / (weight * weight) - 1.0 / numOfHistories;
+	return r2 > 0 ? std::sqrt(r2) : 0.0;
+
+}
+
+Histogram::Histogram(G4String const& aName, Axis const& anX) :
+		name(aName), axes( { anX }), particleName(""), value(Quantity::Energy), bins(
+				anX.GetNumOfBins(), Bin { 0, 0.0, 0.0, 0.0, 0.0, 0.0 }), outOfRange(0), total(
+				Bin { 0, 0.0, 0.0, 0.0, 0.0, 0.0 }) {
+
+}
+
+Histogram::Histogram(G4String const& aName, Axis const& anX, Axis const& aY) :
+		name(aName), axes( { anX, aY }), particleName(""), value(
+				Quantity::Energy), bins(anX.GetNumOfBins() * aY.GetNumOfBins(),
+				Bin { 0, 0.0, 0.0, 0.0, 0.0, 0.0 }), outOfRange(0), total(
+				Bin { 0, 0.0, 0.0, 0.0, 0.0, 0.0 }) {
+
+}
+
+void Histogram::SetParticleName(G4String const& aParticleName) {
+
+	particleName = aParticleName;
+	Reset();
+
+}
+
+void Histogram::SetValue(Quantity const aValue) {
+
+	value = aValue;
+	Reset();
+
+}
+
+Histogram::Bin const& Histogram::GetBin(std::size_t const x,
+		std::size_t const y) const {
+
+	return bins.at(IsTwoDimensional() ? x * GetY().GetNumOfBins() + y : x);
+
+}
+
+void Histogram::EndHistory() {
+
+	for (auto const bin : touched) {
+		bins[bin].EndHistory();
+	}
+	touched.clear();
+	total.EndHistory();
+
+}
+
+Histogram::Bin Histogram::GetTotal() const {
+
+	Bin result { 0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	for (auto const& b : bins) {
+		result.Merge(b);
+	}
+	result.weight2 = total.weight2;
+	return result;
+
+}
+
+void Histogram::Merge(Histogram const& h) {
+
+	if (!(axes == h.axes) || particleName != h.particleName
+			|| value != h.value) {
+		throw MismatchException();
+	}
+
+	for (std::size_t i = 0; i < bins.size(); i++) {
+		bins[i].Merge(h.bins[i]);
+	}
+	outOfRange += h.outOfRange;
+	total.weight2 += h.total.weight2;
+
+}
+
+void Histogram::Reset() {
+
+	std::fill(std::begin(bins), std::end(bins), Bin { 0, 0.0, 0.0, 0.0, 0.0, 0.0 });
+	outOfRange = 0;
+	total = Bin { 0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	touched.clear();
+
+}
+
+void Histogram::Write(std::ostream& os) const {
+
+	auto const& valueName = QuantityName(value);
+
+	os << "# histogram " << name << ", particle "
+			<< (particleName.isNull() ? G4String("all") : particleName)
+			<< ", out of range " << outOfRange << "\n";
+
+	for (auto const& axis : axes) {
+		auto const& n = QuantityName(axis.GetQuantity());
+		os << n << "Min\t" << n << "Max\t";
+	}
+	os << "Count\tWeight\tMean" << valueName << "\tVariance" << valueName << "\n";
+
+	auto const ny = IsTwoDimensional() ? GetY().GetNumOfBins() : 1;
+	for (std::size_t i = 0; i < bins.size(); i++) {
+		auto const x = i / ny;
+		os << GetX().LowerEdge(x) << '\t' << GetX().LowerEdge(x + 1) << '\t';
+		if (IsTwoDimensional()) {
+			auto const y = i % ny;
+			os << GetY().LowerEdge(y) << '\t' << GetY().LowerEdge(y + 1)
+					<< '\t';
+		}
+		os << bins[i].count << '\t' << bins[i].weight << '\t' << bins[i].mean << '\t'
+				<< bins[i].Variance() << '\n';
+	}
+
+}
+
+G4String const& Histogram::QuantityName(Quantity const q) {
+
+	static G4String const names[NumOfQuantities] = { "Energy", "Angle", "X",
+			"Y", "Time" };
+	return names[Index(q)];
+
+}
+
+}
+
+}
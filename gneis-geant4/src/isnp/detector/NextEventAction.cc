@@ -0,0 +1,330 @@
+#include <algorithm>
+#include <cmath>
+
+#include <G4Step.hh>
+#include <G4Track.hh>
+#include <G4VProcess.hh>
+#include <G4HadronicProcess.hh>
+#include <G4NucleiProperties.hh>
+#include <G4Neutron.hh>
+#include <G4TransportationManager.hh>
+#include <G4PhysicalConstants.hh>
+#include <G4SystemOfUnits.hh>
+
+#include "isnp/detector/NextEventAction.hh"
+#include "isnp/facility/component/BeamPointer.hh"
+#include "isnp/util/Convert.hh"
+#include "isnp/util/NeutronCrossSection.hh"
+
+namespace isnp {
+
+namespace detector {
+
+// contributions attenuated more are negligible and are not recorded
+static G4double const MAX_OPTICAL_DEPTH = 50.0;
+
+// limits the number of boundaries of a ray cast through a broken geometry
+static int const MAX_RAY_STEPS = 100000;
+
+std::vector<NextEventAction::Point> NextEventAction::points;
+
+NextEventAction::NextEventAction() :
+		crossSection(util::NeutronCrossSection::Total), normal(0, 0, 1) {
+}
+
+NextEventAction::~NextEventAction() {
+}
+
+void NextEventAction::AddPoint(Point const& point) {
+
+	auto const it = std::find_if(std::begin(points), std::end(points),
+			[&point](Point const& p) {
+				return p.name == point.name;
+			});
+
+	if (it == std::end(points)) {
+		points.push_back(point);
+	} else {
+		*it = point;
+	}
+
+}
+
+void NextEventAction::ClearPoints() {
+
+	points.clear();
+
+}
+
+void NextEventAction::Prepare() {
+
+	auto const bp = facility::component::BeamPointer::GetInstance();
+	auto const beamTransform = util::Convert::VectorsToTransform(
+			bp->GetRotation(), bp->GetPosition());
+	normal = beamTransform.getRotation() * G4ThreeVector(0, 0, 1);
+
+	SetWorldVolume(
+			G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume());
+
+	// writers of removed detectors are kept since their output is merged at the end of a run
+	targets.clear();
+	for (auto const& p : points) {
+		auto& writer = writers[p.name];
+		if (!writer) {
+			writer = std::make_unique < Basic > (p.name);
+		}
+		targets.push_back(
+				Target { p, beamTransform.getRotation() * p.position
+						+ beamTransform.getTranslation(), writer.get() });
+	}
+
+}
+
+void NextEventAction::UserSteppingAction(G4Step const* const aStep) {
+
+	if (targets.empty()) {
+		return;
+	}
+
+	auto const neutron = G4Neutron::Definition();
+	auto const track = aStep->GetTrack();
+	auto const pre = aStep->GetPreStepPoint();
+
+	// primaries reach the detectors uncollided along their initial directions
+	if (track->GetParentID() == 0 && track->GetCurrentStepNumber() == 1
+			&& track->GetDefinition() == neutron) {
+		EstimateUncollided(pre->GetPosition(), pre->GetMomentumDirection(),
+				pre->GetKineticEnergy(), pre->GetProperTime(),
+				pre->GetWeight());
+	}
+
+	auto const post = aStep->GetPostStepPoint();
+	auto const process = post->GetProcessDefinedStep();
+	if (!process || process->GetProcessType() != fHadronic) {
+		return;
+	}
+
+	// the scattered neutron continues the track
+	if (track->GetDefinition() == neutron
+			&& track->GetTrackStatus() == fAlive) {
+		Emission emission { post->GetPosition(), post->GetKineticEnergy(),
+				post->GetProperTime(), post->GetWeight(),
+				pre->GetMomentumDirection(), pre->GetKineticEnergy(), 0.0 };
+
+		auto const target =
+				process->GetProcessName() == "hadElastic" ?
+						static_cast<G4HadronicProcess const*>(process)->GetTargetNucleus() :
+						nullptr;
+		if (target) {
+			emission.massRatio = G4NucleiProperties::GetNuclearMass(
+					target->GetA_asInt(), target->GetZ_asInt())
+					/ neutron->GetPDGMass();
+		}
+
+		Estimate(emission);
+	}
+
+	for (auto const secondary : *aStep->GetSecondaryInCurrentStep()) {
+		if (secondary->GetDefinition() == neutron) {
+			Estimate(Emission { secondary->GetPosition(),
+					secondary->GetKineticEnergy(), secondary->GetProperTime(),
+					secondary->GetWeight(), G4ThreeVector(), 0.0, 0.0 });
+		}
+	}
+
+}
+
+void NextEventAction::SetWorldVolume(G4VPhysicalVolume* const world) {
+
+	navigator.SetWorldVolume(world);
+
+}
+
+void NextEventAction::SetCrossSection(CrossSection const& aCrossSection) {
+
+	crossSection = aCrossSection;
+
+}
+
+G4double NextEventAction::ElasticDensity(G4double const massRatio,
+		G4double const cosine, G4double& energyRatio) {
+
+	energyRatio = 0.0;
+
+	// cosine of the centre of mass angle scattering into the laboratory one,
+	// backward directions are out of reach of a target as heavy as a neutron
+	auto const g = 1.0 / std::max(massRatio, 1.0);
+	auto const sin2 = 1.0 - cosine * cosine;
+	auto const root = 1.0 - g * g * sin2;
+	if (root < 0 || (g >= 1.0 && cosine <= 0)) {
+		return 0.0;
+	}
+	auto const cm = -g * sin2 + cosine * std::sqrt(root);
+
+	// solid angle of the centre of mass frame per the laboratory one
+	auto const q = 1.0 + g * g + 2 * g * cm;
+	energyRatio = q / ((1.0 + g) * (1.0 + g));
+	return q * std::sqrt(q) / std::fabs(1.0 + g * cm) / (4 * pi);
+
+}
+
+G4double NextEventAction::Contribution(Emission const& emission,
+		G4ThreeVector const& target, G4double const radius,
+		G4ThreeVector const& aNormal, G4double& kineticEnergy) {
+
+	kineticEnergy = 0.0;
+
+	auto const path = target - emission.position;
+	auto const distance = path.mag();
+	if (!(distance > 0)) {
+		return 0.0;
+	}
+	auto const direction = path / distance;
+
+	auto density = 1.0 / (4 * pi);
+	kineticEnergy = emission.kineticEnergy;
+	if (emission.massRatio > 0) {
+		G4double energyRatio;
+		density = ElasticDensity(emission.massRatio,
+				emission.incidentDirection.dot(direction), energyRatio);
+		kineticEnergy = emission.incidentEnergy * energyRatio;
+	}
+	if (!(density > 0) || !(kineticEnergy > 0)) {
+		return 0.0;
+	}
+
+	// solid angle of the detector, or fluence per mm^2 of a point
+	auto const r2 = distance * distance;
+	auto const geometry =
+			radius > 0 ?
+					pi * radius * radius * std::fabs(aNormal.dot(direction))
+							/ std::max(r2, radius * radius) :
+					1.0 / (r2 / (mm * mm));
+
+	auto const tau = OpticalDepth(emission.position, direction, distance,
+			kineticEnergy);
+	if (tau > MAX_OPTICAL_DEPTH) {
+		return 0.0;
+	}
+
+	return density * geometry * std::exp(-tau);
+
+}
+
+G4double NextEventAction::Uncollided(G4ThreeVector const& position,
+		G4ThreeVector const& direction, G4double const kineticEnergy,
+		G4ThreeVector const& target, G4double const radius,
+		G4ThreeVector const& aNormal, G4double& distance) {
+
+	distance = 0.0;
+
+	auto const cosine = aNormal.dot(direction);
+	if (!(radius > 0) || cosine == 0) {
+		return 0.0;
+	}
+
+	auto const d = aNormal.dot(target - position) / cosine;
+	if (!(d > 0) || (position + d * direction - target).mag() > radius) {
+		return 0.0;
+	}
+
+	auto const tau = OpticalDepth(position, direction, d, kineticEnergy);
+	if (tau > MAX_OPTICAL_DEPTH) {
+		return 0.0;
+	}
+
+	distance = d;
+	return std::exp(-tau);
+
+}
+
+void NextEventAction::Estimate(Emission const& emission) {
+
+	auto const neutron = G4Neutron::Definition();
+	auto const mass = neutron->GetPDGMass();
+
+	for (auto const& t : targets) {
+		G4double kineticEnergy;
+		auto const contribution = Contribution(emission, t.globalPosition,
+				t.point.radius, normal, kineticEnergy);
+		if (!(contribution > 0)) {
+			continue;
+		}
+
+		auto const totalEnergy = kineticEnergy + mass;
+		auto const gamma = totalEnergy / mass;
+		auto const speed = c_light * std::sqrt(1.0 - 1.0 / (gamma * gamma));
+		auto const path = t.globalPosition - emission.position;
+
+		t.writer->Record(neutron, totalEnergy, kineticEnergy,
+				emission.time + path.mag() / (gamma * speed), path.unit(),
+				t.globalPosition, emission.weight * contribution);
+	}
+
+}
+
+void NextEventAction::EstimateUncollided(G4ThreeVector const& position,
+		G4ThreeVector const& direction, G4double const kineticEnergy,
+		G4double const time, G4double const weight) {
+
+	if (!(kineticEnergy > 0)) {
+		return;
+	}
+
+	auto const neutron = G4Neutron::Definition();
+	auto const mass = neutron->GetPDGMass();
+	auto const totalEnergy = kineticEnergy + mass;
+	auto const gamma = totalEnergy / mass;
+	auto const speed = c_light * std::sqrt(1.0 - 1.0 / (gamma * gamma));
+
+	for (auto const& t : targets) {
+		G4double distance;
+		auto const probability = Uncollided(position, direction, kineticEnergy,
+				t.globalPosition, t.point.radius, normal, distance);
+		if (!(probability > 0)) {
+			continue;
+		}
+
+		t.writer->Record(neutron, totalEnergy, kineticEnergy,
+				time + distance / (gamma * speed), direction,
+				position + distance * direction, weight * probability);
+	}
+
+}
+
+G4double NextEventAction::OpticalDepth(G4ThreeVector const& from,
+		G4ThreeVector const& direction, G4double const distance,
+		G4double const kineticEnergy) {
+
+	G4double tau = 0.0;
+	G4double remaining = distance;
+	auto point = from;
+	auto volume = navigator.LocateGlobalPointAndSetup(point, &direction, false,
+			false);
+
+	for (int i = 0; volume && remaining > 0 && i < MAX_RAY_STEPS; i++) {
+		G4double safety;
+		auto step = navigator.ComputeStep(point, direction, remaining, safety);
+		step = std::min(step, remaining);
+
+		auto const material = volume->GetLogicalVolume()->GetMaterial();
+		if (material && step > 0) {
+			tau += crossSection(material, kineticEnergy) * step;
+			if (tau > MAX_OPTICAL_DEPTH) {
+				break;
+			}
+		}
+
+		remaining -= step;
+		point += direction * step;
+		navigator.SetGeometricallyLimitedStep();
+		volume = navigator.LocateGlobalPointAndSetup(point, &direction, true);
+	}
+
+	return tau;
+
+}
+
+}
+
+}
@@ -0,0 +1,19 @@
+#include "isnp/detector/NextEventRunAction.hh"
+
+namespace isnp {
+
+namespace detector {
+
+NextEventRunAction::NextEventRunAction(NextEventAction& anAction) :
+		action(anAction) {
+}
+
+void NextEventRunAction::BeginOfRunAction(G4Run const*) {
+
+	action.Prepare();
+
+}
+
+}
+
+}
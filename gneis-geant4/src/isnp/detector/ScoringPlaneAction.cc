@@ -0,0 +1,67 @@
+#include <G4Step.hh>
+#include <G4Track.hh>
+
+#include "isnp/detector/ScoringPlaneAction.hh"
+#include "isnp/facility/component/BeamPointer.hh"
+#include "isnp/facility/component/ScoringPlanes.hh"
+#include "isnp/util/Convert.hh"
+
+namespace isnp {
+
+namespace detector {
+
+ScoringPlaneAction::ScoringPlaneAction() {
+}
+
+ScoringPlaneAction::~ScoringPlaneAction() {
+}
+
+void ScoringPlaneAction::Prepare() {
+
+	auto const bp = facility::component::BeamPointer::GetInstance();
+	auto const beamTransform = util::Convert::VectorsToTransform(
+			bp->GetRotation(), bp->GetPosition());
+	rotation = beamTransform.getRotation().inverse();
+	origin = beamTransform.getTranslation();
+
+	// writers of removed planes are kept since their output is merged at the end of a run
+	planes.clear();
+	for (auto const& p : facility::component::ScoringPlanes::GetInstance()->GetPlanes()) {
+		auto& writer = writers[p.name];
+		if (!writer) {
+			writer = std::make_unique < Basic > (p.name, Basic::Format::Binary);
+		}
+		planes.push_back(Plane { p.z, writer.get() });
+	}
+
+}
+
+void ScoringPlaneAction::UserSteppingAction(G4Step const* const aStep) {
+
+	if (planes.empty()) {
+		return;
+	}
+
+	auto const pre = aStep->GetPreStepPoint();
+	auto const from = rotation * (pre->GetPosition() - origin);
+	auto const to = rotation * (aStep->GetPostStepPoint()->GetPosition() - origin);
+
+	for (auto const& p : planes) {
+		if (from.getZ() < p.z && to.getZ() >= p.z) {
+			auto const t = (p.z - from.getZ()) / (to.getZ() - from.getZ());
+			auto position = from + (to - from) * t;
+			position.setZ(p.z);
+
+			p.writer->Record(aStep->GetTrack()->GetParticleDefinition(),
+					pre->GetTotalEnergy(), pre->GetKineticEnergy(),
+					pre->GetProperTime(),
+					rotation * pre->GetMomentumDirection(), position,
+					pre->GetWeight());
+		}
+	}
+
+}
+
+}
+
+}
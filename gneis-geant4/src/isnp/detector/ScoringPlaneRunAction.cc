@@ -0,0 +1,19 @@
+#include "isnp/detector/ScoringPlaneRunAction.hh"
+
+namespace isnp {
+
+namespace detector {
+
+ScoringPlaneRunAction::ScoringPlaneRunAction(ScoringPlaneAction& anAction) :
+		action(anAction) {
+}
+
+void ScoringPlaneRunAction::BeginOfRunAction(G4Run const*) {
+
+	action.Prepare();
+
+}
+
+}
+
+}
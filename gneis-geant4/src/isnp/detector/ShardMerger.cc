@@ -0,0 +1,329 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+
+#include "isnp/detector/ShardMerger.hh"
+#include "isnp/util/DataFrameFormat.hh"
+#include "isnp/util/DataFrameWriter.hh"
+#include "isnp/util/MappedFile.hh"
+
+namespace isnp {
+
+namespace detector {
+
+// number of rows of a binary shard read at once
+static std::size_t const BLOCK_SIZE = 64 * 1024;
+
+// event number of the current row and shard number
+typedef std::pair<int32_t, std::size_t> MergePosition;
+typedef std::priority_queue<MergePosition, std::vector<MergePosition>,
+		std::greater<MergePosition>> MergeQueue;
+
+struct TextShard {
+	std::ifstream is;
+	std::string line;
+	int32_t event;
+};
+
+struct BinaryShard {
+	std::unique_ptr<util::MappedFile const> file;
+	util::DataFrameFormat::Reader read;
+	util::DataFrameFormat::Frames frames;
+
+	// rows being merged, by columns
+	std::vector<std::vector<char>> block;
+	uint64_t blockFirst, blockRows, row;
+
+	// translation of category ids into the merged dictionaries, by columns
+	std::vector<std::vector<util::DataFrame::CategoryId>> categoryIds;
+};
+
+/**
+ * Reads the next non-empty line which is not a comment.
+ */
+static bool NextLine(TextShard& shard) {
+
+	while (std::getline(shard.is, shard.line)) {
+		if (!shard.line.empty() && shard.line[0] != '#') {
+			return true;
+		}
+	}
+
+	return false;
+
+}
+
+static bool NextRow(TextShard& shard) {
+
+	if (!NextLine(shard)) {
+		return false;
+	}
+
+	auto const pos = shard.line.rfind('\t');
+	if (pos == std::string::npos) {
+		throw ShardMerger::MergeException();
+	}
+
+	char const* const begin = shard.line.c_str() + pos + 1;
+	char* end;
+	shard.event = std::strtol(begin, &end, 10);
+	if (end == begin) {
+		throw ShardMerger::MergeException();
+	}
+
+	return true;
+
+}
+
+void ShardMerger::MergeText(std::vector<G4String> const& shards,
+		std::ostream& os) {
+
+	std::vector<std::unique_ptr<TextShard>> inputs;
+	MergeQueue queue;
+
+	for (std::size_t i = 0; i < shards.size(); i++) {
+		auto input = std::make_unique<TextShard>();
+		input->is.open(shards[i]);
+		if (!input->is) {
+			throw MergeException();
+		}
+
+		// skip column names
+		if (NextLine(*input) && NextRow(*input)) {
+			queue.emplace(input->event, i);
+		}
+
+		inputs.push_back(std::move(input));
+	}
+
+	while (!queue.empty()) {
+		auto const i = queue.top().second;
+		queue.pop();
+
+		auto& input = *inputs[i];
+		os << input.line << '\n';
+		if (NextRow(input)) {
+			queue.emplace(input.event, i);
+		}
+	}
+
+}
+
+static void ReadBlock(BinaryShard& shard) {
+
+	auto const& columns = shard.frames.directories[0].columns;
+
+	shard.blockFirst = shard.row;
+	shard.blockRows = std::min<uint64_t>(BLOCK_SIZE,
+			shard.frames.rowCount - shard.row);
+
+	for (std::size_t i = 0; i < columns.size(); i++) {
+		shard.block[i].resize(
+				shard.blockRows
+						* util::DataFrameFormat::ElementSize(columns[i].type));
+		shard.frames.ReadColumn(shard.read, i, shard.blockFirst,
+				shard.blockRows, shard.block[i].data());
+	}
+
+}
+
+static int32_t EventOf(BinaryShard const& shard, std::size_t const columnNo) {
+
+	int32_t result;
+	std::memcpy(&result,
+			shard.block[columnNo].data()
+					+ (shard.row - shard.blockFirst) * sizeof(result),
+			sizeof(result));
+	return result;
+
+}
+
+void ShardMerger::MergeBinary(std::vector<G4String> const& shards,
+		G4String const& eventColumn, std::ostream& os,
+		std::size_t const frameSize) {
+
+	typedef util::DataFrameFormat Format;
+
+	std::vector<std::unique_ptr<BinaryShard>> inputs;
+	for (auto const& shard : shards) {
+		auto input = std::make_unique<BinaryShard>();
+
+		try {
+			input->file = std::make_unique<util::MappedFile const>(shard);
+			auto const file = input->file.get();
+			input->read = [file](uint64_t const offset, void* const buffer,
+					std::size_t const size) {
+				if (offset > file->GetSize()
+						|| size > file->GetSize() - offset) {
+					throw Format::FormatException();
+				}
+				std::memcpy(buffer, file->GetData() + offset, size);
+			};
+			input->frames = Format::ReadFrames(input->read,
+					input->file->GetSize());
+		} catch (util::MappedFile::OpenException const&) {
+			throw MergeException();
+		} catch (Format::FormatException const&) {
+			throw MergeException();
+		}
+
+		inputs.push_back(std::move(input));
+	}
+
+	if (inputs.empty()) {
+		return;
+	}
+
+	// all the shards are written by the same detector and have the same columns
+	auto const& columns = inputs[0]->frames.directories[0].columns;
+	for (auto const& input : inputs) {
+		auto const& c = input->frames.directories[0].columns;
+		if (!std::equal(std::begin(columns), std::end(columns), std::begin(c),
+				std::end(c), [](auto const& a, auto const& b) {
+					return a.name == b.name && a.type == b.type;
+				})) {
+			throw MergeException();
+		}
+	}
+
+	auto const eventColumnNo = std::find_if(std::begin(columns),
+			std::end(columns), [&eventColumn](auto const& c) {
+				return c.name == eventColumn
+				&& c.type == Format::ColumnType::Integer;
+			}) - std::begin(columns);
+	if (static_cast<std::size_t>(eventColumnNo) == columns.size()) {
+		throw MergeException();
+	}
+
+	// merge category dictionaries by name
+	std::vector<Format::CategoryNames> categoryNames(columns.size());
+	for (auto const& input : inputs) {
+		input->categoryIds.resize(columns.size());
+
+		for (std::size_t i = 0; i < columns.size(); i++) {
+			if (columns[i].type != Format::ColumnType::Category) {
+				continue;
+			}
+
+			auto& names = categoryNames[i];
+			auto& ids = input->categoryIds[i];
+			ids.resize(Format::MaxCategories);
+
+			for (auto const& n : input->frames.categoryNames[columns[i].name]) {
+				auto const it = std::find_if(std::begin(names), std::end(names),
+						[&n](auto const& m) {
+							return m.second == n.second;
+						});
+				if (it != std::end(names)) {
+					ids[n.first] = it->first;
+				} else if (names.size() < Format::MaxCategories) {
+					std::size_t id = 0;
+					while (names.count(id)) {
+						id++;
+					}
+					names[id] = n.second;
+					ids[n.first] = id;
+				} else {
+					throw MergeException();
+				}
+			}
+		}
+	}
+
+	// merged rows, by columns
+	std::vector<std::vector<char>> output(columns.size());
+	std::size_t outputRows = 0;
+	bool written = false;
+
+	auto const writeFrame = [&] {
+		util::DataFrameWriter writer(os);
+
+		for (std::size_t i = 0; i < columns.size(); i++) {
+			auto const& c = columns[i];
+			auto const values = output[i].data();
+
+			switch (c.type) {
+			case Format::ColumnType::Float:
+				writer.AddFloatColumn(c.name, c.precision,
+						reinterpret_cast<G4float const*>(values));
+				break;
+
+			case Format::ColumnType::Category:
+				writer.AddCategoryColumn(c.name, categoryNames[i],
+						reinterpret_cast<util::DataFrame::CategoryId const*>(values));
+				break;
+
+			case Format::ColumnType::Integer:
+				writer.AddIntegerColumn(c.name,
+						reinterpret_cast<int32_t const*>(values));
+				break;
+			}
+		}
+
+		writer.Write(outputRows);
+
+		for (auto& o : output) {
+			o.clear();
+		}
+		outputRows = 0;
+		written = true;
+	};
+
+	MergeQueue queue;
+	for (std::size_t i = 0; i < inputs.size(); i++) {
+		auto& input = *inputs[i];
+		input.block.resize(columns.size());
+		input.row = 0;
+
+		if (input.frames.rowCount > 0) {
+			ReadBlock(input);
+			queue.emplace(EventOf(input, eventColumnNo), i);
+		}
+	}
+
+	while (!queue.empty()) {
+		auto const shardNo = queue.top().second;
+		queue.pop();
+
+		auto& input = *inputs[shardNo];
+		auto const rowNo = input.row - input.blockFirst;
+
+		for (std::size_t i = 0; i < columns.size(); i++) {
+			auto const size = Format::ElementSize(columns[i].type);
+			auto const value = input.block[i].data() + rowNo * size;
+
+			if (columns[i].type == Format::ColumnType::Category) {
+				output[i].push_back(
+						input.categoryIds[i][static_cast<util::DataFrame::CategoryId>(*value)]);
+			} else {
+				output[i].insert(std::end(output[i]), value, value + size);
+			}
+		}
+
+		if (++outputRows == frameSize) {
+			writeFrame();
+		}
+
+		if (++input.row < input.frames.rowCount) {
+			if (input.row - input.blockFirst == input.blockRows) {
+				ReadBlock(input);
+			}
+			queue.emplace(EventOf(input, eventColumnNo), shardNo);
+		}
+	}
+
+	if (outputRows > 0 || !written) {
+		writeFrame();
+	}
+
+}
+
+}
+
+}
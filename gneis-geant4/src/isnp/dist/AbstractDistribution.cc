@@ -0,0 +1,20 @@
+#include "isnp/dist/AbstractDistribution.hh"
+
+namespace isnp {
+
+namespace dist {
+
+void AbstractDistribution::GenerateN(G4double* const x, G4double* const y,
+		std::size_t const n) const {
+
+	for (std::size_t i = 0; i < n; i++) {
+		auto const pos = Generate();
+		x[i] = pos.getX();
+		y[i] = pos.getY();
+	}
+
+}
+
+}
+
+}
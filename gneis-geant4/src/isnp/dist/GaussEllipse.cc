@@ -2,6 +2,7 @@
 #include <G4SystemOfUnits.hh>
 #include <Randomize.hh>
 #include "isnp/dist/GaussEllipse.hh"
+#include "isnp/util/RandomNumberGenerator.hh"
 
 namespace isnp {
 
@@ -20,6 +21,25 @@ G4ThreeVector GaussEllipse::Generate() const {
 
 }
 
+void GaussEllipse::GenerateN(G4double* const x, G4double* const y,
+		std::size_t const n) const {
+
+	util::RandomNumberGenerator::flatArray(x, n);
+	util::RandomNumberGenerator::flatArray(y, n);
+
+	G4double const xSigma = GetProps().GetXWidth() * FWHM;
+	G4double const ySigma = GetProps().GetYWidth() * FWHM;
+
+	// Box-Muller transform gives a pair of independent normal numbers
+	for (std::size_t i = 0; i < n; i++) {
+		G4double const r = std::sqrt(-2 * std::log(1.0 - x[i]));
+		G4double const phi = CLHEP::twopi * y[i];
+		x[i] = r * std::cos(phi) * xSigma;
+		y[i] = r * std::sin(phi) * ySigma;
+	}
+
+}
+
 }
 
 }
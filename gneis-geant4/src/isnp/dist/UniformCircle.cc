@@ -1,13 +1,29 @@
+#include <algorithm>
+#include <cmath>
+
 #include <G4SystemOfUnits.hh>
 #include <Randomize.hh>
 #include "isnp/dist/UniformCircle.hh"
+#include "isnp/util/RandomNumberGenerator.hh"
 
 namespace isnp {
 
 namespace dist {
 
-UniformCircleProps::UniformCircleProps(G4double const aDiameter) :
-		diameter(aDiameter) {
+UniformCircleProps::UniformCircleProps(G4double const aDiameter,
+		Engine const anEngine) :
+		diameter(aDiameter), engine(anEngine) {
+}
+
+// maps a pair of uniform numbers onto the circle keeping the area density uniform
+static inline void Polar(G4double const u, G4double const v,
+		G4double const radius, G4double& x, G4double& y) {
+
+	G4double const r = radius * std::sqrt(u);
+	G4double const phi = CLHEP::twopi * v;
+	x = r * std::cos(phi);
+	y = r * std::sin(phi);
+
 }
 
 G4ThreeVector UniformCircle::Generate() const {
@@ -16,6 +32,13 @@ G4ThreeVector UniformCircle::Generate() const {
 
 		return G4ThreeVector(0, 0, 0);
 
+	} else if (GetProps().GetEngine() == UniformCircleProps::Engine::Analytic) {
+
+		G4double x, y;
+		Polar(CLHEP::RandFlat::shoot(), CLHEP::RandFlat::shoot(),
+				GetProps().GetDiameter() / 2, x, y);
+		return G4ThreeVector(x, y, 0);
+
 	} else {
 
 		G4double const maxValue = GetProps().GetDiameter() / 2;
@@ -34,6 +57,50 @@ G4ThreeVector UniformCircle::Generate() const {
 
 }
 
+void UniformCircle::GenerateN(G4double* const x, G4double* const y,
+		std::size_t const n) const {
+
+	if (GetProps().GetDiameter() < 1.0 * angstrom) {
+		std::fill(x, x + n, 0.0);
+		std::fill(y, y + n, 0.0);
+		return;
+	}
+
+	G4double const diameter = GetProps().GetDiameter();
+
+	if (GetProps().GetEngine() == UniformCircleProps::Engine::Analytic) {
+		util::RandomNumberGenerator::flatArray(x, n);
+		util::RandomNumberGenerator::flatArray(y, n);
+
+		G4double const radius = diameter / 2;
+		for (std::size_t i = 0; i < n; i++) {
+			Polar(x[i], y[i], radius, x[i], y[i]);
+		}
+		return;
+	}
+
+	std::size_t const batchSize = 128;
+	G4double const maxValue = diameter / 2;
+	G4double const maxValue2 = maxValue * maxValue;
+	G4double candidates[2 * batchSize];
+
+	std::size_t i = 0;
+	while (i < n) {
+		auto const m = std::min(n - i, batchSize);
+		util::RandomNumberGenerator::flatArray(candidates, 2 * m);
+
+		// candidate is always written, but is kept only if it falls within the circle
+		for (std::size_t j = 0; j < m; j++) {
+			G4double const cx = candidates[2 * j] * diameter - maxValue;
+			G4double const cy = candidates[2 * j + 1] * diameter - maxValue;
+			x[i] = cx;
+			y[i] = cy;
+			i += cx * cx + cy * cy < maxValue2 ? 1 : 0;
+		}
+	}
+
+}
+
 }
 
 }
@@ -1,6 +1,9 @@
+#include <algorithm>
+
 #include <G4SystemOfUnits.hh>
 #include <Randomize.hh>
 #include "isnp/dist/UniformRectangle.hh"
+#include "isnp/util/RandomNumberGenerator.hh"
 
 namespace isnp {
 
@@ -23,6 +26,29 @@ G4ThreeVector UniformRectangle::Generate() const {
 
 }
 
+static void Scale(G4double* const v, std::size_t const n,
+		G4double const width) {
+
+	if (width < 1.0 * angstrom) {
+		std::fill(v, v + n, 0.0);
+	} else {
+		util::RandomNumberGenerator::flatArray(v, n);
+		G4double const halfWidth = width / 2;
+		for (std::size_t i = 0; i < n; i++) {
+			v[i] = v[i] * width - halfWidth;
+		}
+	}
+
+}
+
+void UniformRectangle::GenerateN(G4double* const x, G4double* const y,
+		std::size_t const n) const {
+
+	Scale(x, n, GetProps().GetXWidth());
+	Scale(y, n, GetProps().GetYWidth());
+
+}
+
 }
 
 }
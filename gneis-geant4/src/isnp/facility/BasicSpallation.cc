@@ -7,12 +7,17 @@
 #include <G4VisAttributes.hh>
 #include <G4PVPlacement.hh>
 #include <G4SDManager.hh>
+#include <G4RunManager.hh>
 #include "G4Threading.hh"
 
 #include "isnp/facility/BasicSpallation.hh"
 #include "isnp/facility/BasicSpallationMessenger.hh"
 #include "isnp/facility/component/SpallationTarget.hh"
 #include "isnp/facility/component/BeamPointer.hh"
+#include "isnp/facility/component/ScoringPlanes.hh"
+#include "isnp/facility/component/ImportanceRegions.hh"
+#include "isnp/facility/component/ImportanceWorld.hh"
+#include "isnp/facility/component/OverlapCache.hh"
 #include "isnp/detector/Basic.hh"
 
 namespace isnp {
@@ -26,7 +31,7 @@ static G4double Square(G4double const x) {
 }
 
 BasicSpallation::BasicSpallation() :
-		detector(nullptr), messenger(
+		detectorFactory(MakeDefaultDetector), detectorVolume(nullptr), messenger(
 				std::make_unique < BasicSpallationMessenger > (*this)), worldRadius(
 				0.0), xAngle(-2.0 * deg), yAngle(-32.0 * deg), distance(
 				1.0 * m), detectorWidth(10 * cm), detectorHeight(10 * cm), detectorLength(
@@ -34,6 +39,12 @@ BasicSpallation::BasicSpallation() :
 				DEFAULT_WORLD_MATERIAL), logicWorld(nullptr) {
 
 	component::SpallationTarget::GetInstance();
+	component::ScoringPlanes::GetInstance();
+	component::ImportanceRegions::GetInstance();
+	component::OverlapCache::GetInstance();
+
+	// cells are built only if importance regions are defined
+	RegisterParallelWorld(new component::ImportanceWorld);
 
 }
 
@@ -52,7 +63,8 @@ G4VPhysicalVolume* BasicSpallation::Construct() {
 	G4RotationMatrix* const noRotation = nullptr;
 	G4bool const single = false;
 	G4int const numOfCopies = 0;
-	G4bool const checkOverlaps = true;
+	// overlaps are checked by OverlapCache when the geometry is complete
+	G4bool const checkOverlaps = false;
 
 	if (worldRadius < 1 * mm) {
 		// auto-calculate
@@ -91,13 +103,10 @@ G4VPhysicalVolume* BasicSpallation::Construct() {
 		auto const bp = component::BeamPointer::GetInstance();
 		bp->SetRotation(G4ThreeVector());
 		bp->SetPosition(G4ThreeVector());
+		bp->SetApertures(util::ApertureChain());
 
 	}
 
-	if (!detector) {
-		detector = MakeDefaultDetector();
-	}
-
 	if (verboseLevel >= 1 && G4Threading::IsMasterThread()) {
 		G4cout << "BasicSpallation: creating detector, width="
 				<< GetDetectorWidth() / mm << " mm, height="
@@ -113,15 +122,16 @@ G4VPhysicalVolume* BasicSpallation::Construct() {
 			nist->FindOrBuildMaterial("G4_Galactic"), name);
 	logicTarget->SetVisAttributes(G4VisAttributes(G4Colour::Red()));
 
-	const auto sdMan = G4SDManager::GetSDMpointer();
-	sdMan->AddNewDetector(detector);
-	logicTarget->SetSensitiveDetector(detector);
+	// detectors are created per thread by ConstructSDandField
+	detectorVolume = logicTarget;
 
 	new G4PVPlacement(noRotation,
 			G4ThreeVector(0, 0, GetDistance() + HalfOf(GetDetectorLength())),
 			logicTarget, logicTarget->GetName(), logicWorld, single,
 			numOfCopies, checkOverlaps);
 
+	component::OverlapCache::GetInstance()->Validate(physWorld);
+
 	return physWorld;
 
 }
@@ -204,15 +214,16 @@ void BasicSpallation::SetWorldMaterial(const G4String& aWorldMaterial) {
 
 }
 
-G4VSensitiveDetector* BasicSpallation::GetDetector() const {
+BasicSpallation::DetectorFactory const& BasicSpallation::GetDetectorFactory() const {
 
-	return detector;
+	return detectorFactory;
 
 }
 
-void BasicSpallation::SetDetector(G4VSensitiveDetector* const aDetector) {
+void BasicSpallation::SetDetectorFactory(
+		DetectorFactory const& aDetectorFactory) {
 
-	detector = aDetector;
+	detectorFactory = aDetectorFactory;
 
 }
 
@@ -222,6 +233,21 @@ G4double BasicSpallation::HalfOf(G4double const v) {
 
 }
 
+void BasicSpallation::ConstructSDandField() {
+
+	// the master thread of a multithreaded run processes no events
+	auto const runManager = G4RunManager::GetRunManager();
+	if (!detectorVolume
+			|| runManager->GetRunManagerType() == G4RunManager::masterRM) {
+		return;
+	}
+
+	auto const detector = detectorFactory();
+	G4SDManager::GetSDMpointer()->AddNewDetector(detector);
+	SetSensitiveDetector(detectorVolume, detector);
+
+}
+
 G4VSensitiveDetector* BasicSpallation::MakeDefaultDetector() {
 
 	return new isnp::detector::Basic;
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cfloat>
+
 #include <G4RunManager.hh>
 #include <G4NistManager.hh>
 #include <G4Box.hh>
@@ -13,6 +16,12 @@
 #include <G4VisAttributes.hh>
 #include <G4SDManager.hh>
 #include <G4RotationMatrix.hh>
+#include <G4Region.hh>
+#include <G4RegionStore.hh>
+#include <G4ProductionCuts.hh>
+#include <G4ProductionCutsTable.hh>
+#include <G4UserLimits.hh>
+#include <G4TransportationManager.hh>
 #include "G4Threading.hh"
 
 #include "isnp/facility/Beam5.hh"
@@ -24,17 +33,27 @@
 #include "isnp/facility/component/CollimatorC4.hh"
 #include "isnp/facility/component/CollimatorC5.hh"
 #include "isnp/facility/component/BeamPointer.hh"
+#include "isnp/facility/component/ScoringPlanes.hh"
+#include "isnp/facility/component/ImportanceRegions.hh"
+#include "isnp/facility/component/ImportanceWorld.hh"
+#include "isnp/facility/component/VacuumTransportModel.hh"
+#include "isnp/facility/component/OverlapCache.hh"
 #include "isnp/detector/Basic.hh"
 #include "isnp/util/NameBuilder.hh"
+#include "isnp/util/ApertureChain.hh"
+#include "isnp/util/NavigationBenchmark.hh"
 #include "isnp/repository/Colours.hh"
 
 namespace isnp {
 
 namespace facility {
 
+std::size_t const Beam5::NumOfRegions;
+
 Beam5::Beam5() :
 		G4VUserDetectorConstruction(), messenger(
-				std::make_unique < Beam5Messenger > (*this)), detector(nullptr), zeroPosition(
+				std::make_unique < Beam5Messenger > (*this)), detectorFactory(
+				MakeDefaultDetector), detectorVolume(nullptr), zeroPosition(
 				0.5 * m), worldLength(50.5 * m), xAngle(-2. * deg), yAngle(
 				-32.0 * deg), hasSpallationTarget(true), c5Diameter(100 * mm), verboseLevel(
 				0), ntubeInnerRadius(120 * mm), ntubeOuterRadius(130 * mm), ntubeFlangeThickness(
@@ -43,9 +62,17 @@ Beam5::Beam5() :
 				2. * mm), detectorZPosition(36. * m), ntubeMaterial("DUR_AMG3"), ntubeFlangeMaterial(
 				"G4_Al"), ntubeInnerMaterial("FOREVACUUM_100"), wallMaterial(
 				"G4_CONCRETE"), worldMaterial("G4_AIR"), windowMaterial(
-				"G4_Al"), c5Material("BR05C5S5"), worldRadius(200. * mm) {
+				"G4_Al"), c5Material("BR05C5S5"), worldRadius(200. * mm), regionSettings(), fastVacuum(
+				false), c1Native(false), c2Native(false), hasSections(false), sectionSmartless(
+				4.), sections() {
 
 	component::SpallationTarget::GetInstance();
+	component::ScoringPlanes::GetInstance();
+	component::ImportanceRegions::GetInstance();
+	component::OverlapCache::GetInstance();
+
+	// cells are built only if importance regions are defined
+	RegisterParallelWorld(new component::ImportanceWorld);
 
 }
 
@@ -61,7 +88,20 @@ G4VPhysicalVolume* Beam5::Construct() {
 	G4RotationMatrix* const noRotation = nullptr;
 	G4bool const single = false;
 	G4int const numOfCopies = 0;
-	G4bool const checkOverlaps = true;
+	// overlaps are checked by OverlapCache when the geometry is complete
+	G4bool const checkOverlaps = false;
+
+	for (auto& volumes : regionVolumes) {
+		volumes.clear();
+	}
+	vacuumVolumes.clear();
+	sections.clear();
+
+	// positions of the beamline parts along the beam
+	G4double const chamberLength = 5.4 * m;
+	G4double const c1Position = 5.9 * m;
+	G4double const wallPosition = 23.2 * m;
+	G4double const ntube5Position = 37.4 * m;
 
 	G4String const nameWorld = "World";
 	auto const solidWorld = MakeCylinder(nameWorld, zeroPosition + worldLength);
@@ -73,6 +113,27 @@ G4VPhysicalVolume* Beam5::Construct() {
 	auto const physWorld = new G4PVPlacement(noRotation, G4ThreeVector(),
 			logicWorld, nameWorld, nullptr, single, numOfCopies, checkOverlaps);
 
+	if (hasSections) {
+		component::CollimatorC1 const c1;
+		component::CollimatorC2 const c2;
+		G4double const c2Position = c1Position + c1.GetLength() + ntube1Length;
+		G4double const ntube4Position = wallPosition + wallLength
+				+ 2 * ntubeFlangeThickness;
+		G4double const ntube4End = ntube4Position + ntube4Length
+				+ 2 * ntubeFlangeThickness;
+
+		AddSection(logicWorld, "targetHall", -zeroPosition, c1Position);
+		AddSection(logicWorld, "c1", c1Position, c2Position);
+		AddSection(logicWorld, "c2", c2Position,
+				c2Position + c2.GetLength() + ntube2Length);
+		AddSection(logicWorld, "wall", wallPosition, ntube4Position);
+		AddSection(logicWorld, "ntube4", ntube4Position, ntube4End);
+		AddSection(logicWorld, "ntube5", ntube4End, worldLength);
+	}
+
+	// apertures of the collimators in the beam coordinate system
+	util::ApertureChain apertures;
+
 	{
 		auto const pos = G4ThreeVector(0, 0,
 				0.5 * (zeroPosition - worldLength));
@@ -84,9 +145,15 @@ G4VPhysicalVolume* Beam5::Construct() {
 			spallationTarget->SetRotation(
 					spallationTarget->GetRotation()
 							+ G4ThreeVector(-xAngle, -yAngle, 0.));
+			G4double origin;
+			auto const mother = MotherAt(logicWorld, 0., 0., origin);
 			spallationTarget->SetPosition(
-					spallationTarget->GetPosition() + pos);
-			spallationTarget->Place(logicWorld);
+					spallationTarget->GetPosition()
+							+ G4ThreeVector(0, 0, origin));
+			spallationTarget->Place(mother);
+			for (auto const volume : spallationTarget->GetVolumes()) {
+				AddToRegion(Region::Target, volume);
+			}
 		}
 
 		// Beam position
@@ -95,7 +162,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 		bp->SetPosition(pos);
 	}
 
-	G4double zPos = 5.4 * m;
+	G4double zPos = chamberLength;
 
 	{
 		// vacuum chamber
@@ -107,6 +174,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 				nist->FindOrBuildMaterial("G4_Galactic"), sChamber);
 		logicChamber->SetVisAttributes(G4VisAttributes(false));
 		PlaceComponent(logicWorld, logicChamber, 0., zPos, false);
+		AddToVacuum(logicChamber);
 
 	}
 
@@ -121,9 +189,10 @@ G4VPhysicalVolume* Beam5::Construct() {
 		logicWindow->SetVisAttributes(
 				G4VisAttributes(repository::Colours::Aluminium()));
 		PlaceComponent(logicWorld, logicWindow, zPos, windowThickness);
+		AddToRegion(Region::VacuumTubes, logicWindow);
 	}
 
-	zPos = 5.9 * m;
+	zPos = c1Position;
 
 	{
 		// Collimator #1
@@ -132,8 +201,14 @@ G4VPhysicalVolume* Beam5::Construct() {
 		}
 
 		component::CollimatorC1 const c;
-		auto const logicC1 = c.AsCylinder(worldRadius);
+		auto const logicC1 =
+				c1Native ?
+						c.AsNativeCylinder(worldRadius,
+								nist->FindOrBuildMaterial(worldMaterial)) :
+						c.AsCylinder(worldRadius);
 		PlaceCollimator(logicWorld, logicC1, zPos, c.GetLength());
+		apertures.AddRectangle(zPos, c.GetLength(), c.GetAperture().GetWidth(),
+				c.GetAperture().GetHeight());
 		zPos += c.GetLength();
 	}
 
@@ -153,8 +228,14 @@ G4VPhysicalVolume* Beam5::Construct() {
 		}
 
 		component::CollimatorC2 const c;
-		auto const logicC2 = c.AsCylinder(worldRadius);
+		auto const logicC2 =
+				c2Native ?
+						c.AsNativeCylinder(worldRadius,
+								nist->FindOrBuildMaterial(worldMaterial)) :
+						c.AsCylinder(worldRadius);
 		PlaceCollimator(logicWorld, logicC2, zPos, c.GetLength());
+		apertures.AddRectangle(zPos, c.GetLength(), c.GetAperture().GetWidth(),
+				c.GetAperture().GetHeight());
 		zPos += c.GetLength();
 	}
 
@@ -168,7 +249,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 		zPos += ntube2Length;
 	}
 
-	zPos = 23.2 * m;
+	zPos = wallPosition;
 
 	{
 		// concrete wall with collimatots #3 and #4
@@ -186,6 +267,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 		component::CollimatorC3 const c;
 		auto const logicC3 = c.AsCylinder();
 		PlaceCollimator(logicWorld, logicC3, zPos, c.GetLength());
+		apertures.AddCircle(zPos, c.GetLength(), 2 * c.GetInnerRadius());
 
 		{
 			G4String const sInner = util::NameBuilder::Make(c.GetDefaultName(),
@@ -197,6 +279,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 			logicInner->SetVisAttributes(
 					G4VisAttributes(repository::Colours::Air()));
 			PlaceComponent(logicWorld, logicInner, zPos, c.GetLength());
+			AddToVacuum(logicInner);
 		}
 
 		{
@@ -209,6 +292,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 			logicOuter->SetVisAttributes(
 					G4VisAttributes(repository::Colours::Concrete()));
 			PlaceComponent(logicWorld, logicOuter, zPos, c.GetLength());
+			AddToRegion(Region::Shielding, logicOuter);
 		}
 
 		zPos += c.GetLength();
@@ -226,6 +310,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 			logicInner->SetVisAttributes(
 					G4VisAttributes(repository::Colours::Air()));
 			PlaceComponent(logicWorld, logicInner, zPos, wall1Length);
+			AddToVacuum(logicInner);
 		}
 
 		{
@@ -238,6 +323,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 			logicOuter->SetVisAttributes(
 					G4VisAttributes(repository::Colours::Concrete()));
 			PlaceComponent(logicWorld, logicOuter, zPos, wall1Length);
+			AddToRegion(Region::Shielding, logicOuter);
 		}
 
 		zPos += wall1Length;
@@ -263,6 +349,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 			logicInner->SetVisAttributes(
 					G4VisAttributes(repository::Colours::Air()));
 			PlaceComponent(logicWorld, logicInner, zPos, wall2Length);
+			AddToVacuum(logicInner);
 		}
 
 		{
@@ -275,12 +362,14 @@ G4VPhysicalVolume* Beam5::Construct() {
 			logicOuter->SetVisAttributes(
 					G4VisAttributes(repository::Colours::Concrete()));
 			PlaceComponent(logicWorld, logicOuter, zPos, wall2Length);
+			AddToRegion(Region::Shielding, logicOuter);
 		}
 
 		zPos += wall2Length;
 
 		auto const logicC4 = c.AsCylinder();
 		PlaceCollimator(logicWorld, logicC4, zPos, c.GetLength());
+		apertures.AddCircle(zPos, c.GetLength(), 2 * c.GetInnerRadius());
 
 		{
 			G4String const sInner = util::NameBuilder::Make(c.GetDefaultName(),
@@ -292,6 +381,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 			logicInner->SetVisAttributes(
 					G4VisAttributes(repository::Colours::Air()));
 			PlaceComponent(logicWorld, logicInner, zPos, c.GetLength());
+			AddToVacuum(logicInner);
 		}
 
 		{
@@ -304,6 +394,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 			logicOuter->SetVisAttributes(
 					G4VisAttributes(repository::Colours::Concrete()));
 			PlaceComponent(logicWorld, logicOuter, zPos, c.GetLength());
+			AddToRegion(Region::Shielding, logicOuter);
 		}
 
 		zPos += c.GetLength();
@@ -342,6 +433,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 			logicOuter->SetVisAttributes(
 					G4VisAttributes(repository::Colours::Aluminium()));
 			PlaceComponent(logicWorld, logicOuter, zPos, ntube4Length);
+			AddToRegion(Region::VacuumTubes, logicOuter);
 		}
 
 		G4double const innerLength = ntube4Length - c.GetLength();
@@ -358,12 +450,14 @@ G4VPhysicalVolume* Beam5::Construct() {
 			logicInner->SetVisAttributes(
 					G4VisAttributes(repository::Colours::Air()));
 			PlaceComponent(logicWorld, logicInner, zPos, innerLength);
+			AddToVacuum(logicInner);
 		}
 
 		zPos += innerLength;
 
 		auto const logicC5 = c.AsCylinder();
 		PlaceCollimator(logicWorld, logicC5, zPos, c.GetLength());
+		apertures.AddCircle(zPos, c.GetLength(), 2 * c.GetInnerRadius());
 
 		{
 			G4String const sInner = util::NameBuilder::Make(c.GetDefaultName(),
@@ -375,6 +469,7 @@ G4VPhysicalVolume* Beam5::Construct() {
 			logicInner->SetVisAttributes(
 					G4VisAttributes(repository::Colours::Air()));
 			PlaceComponent(logicWorld, logicInner, zPos, c.GetLength());
+			AddToVacuum(logicInner);
 		}
 
 		zPos += c.GetLength();
@@ -385,17 +480,13 @@ G4VPhysicalVolume* Beam5::Construct() {
 		zPos += ntubeFlangeThickness;
 	}
 
-	zPos = 37.4 * m;
+	zPos = ntube5Position;
 
 	{
 		// neutron tube #5
 		AddNTube(logicWorld, ntube5Length, zPos, 5);
 	}
 
-	if (!detector) {
-		detector = MakeDefaultDetector();
-	}
-
 	if (verboseLevel >= 1 && G4Threading::IsMasterThread()) {
 		G4cout << "Beam5: creating detector\n";
 	}
@@ -409,13 +500,21 @@ G4VPhysicalVolume* Beam5::Construct() {
 				nist->FindOrBuildMaterial("G4_Galactic"), name);
 		logicTarget->SetVisAttributes(G4VisAttributes(G4Colour::Green()));
 
-		const auto sdMan = G4SDManager::GetSDMpointer();
-		sdMan->AddNewDetector(detector);
-		logicTarget->SetSensitiveDetector(detector);
+		// detectors are created per thread by ConstructSDandField
+		detectorVolume = logicTarget;
 
 		PlaceComponent(logicWorld, logicTarget, detectorZPosition, 10. * mm);
 	}
 
+	// particles reaching the detector do not pass the collimators behind it
+	apertures.RemoveBeyond(detectorZPosition);
+	apertures.AddCircle(detectorZPosition, 0., 2 * worldRadius);
+	component::BeamPointer::GetInstance()->SetApertures(apertures);
+
+	ConstructRegions();
+
+	component::OverlapCache::GetInstance()->Validate(physWorld);
+
 	return physWorld;
 
 }
@@ -432,6 +531,126 @@ void Beam5::SetHasSpallationTarget(G4bool const v) {
 
 }
 
+Beam5::RegionSettings const& Beam5::GetRegionSettings(
+		Region const region) const {
+
+	return regionSettings[static_cast<std::size_t>(region)];
+
+}
+
+void Beam5::SetRegionSettings(Region const region,
+		RegionSettings const& settings) {
+
+	regionSettings[static_cast<std::size_t>(region)] = settings;
+
+}
+
+G4bool Beam5::HasTrackLimits() const {
+
+	return std::any_of(std::begin(regionSettings), std::end(regionSettings),
+			[](RegionSettings const& settings) {
+				return settings.maxTime > 0 || settings.minKineticEnergy > 0;
+			});
+
+}
+
+G4String const& Beam5::RegionName(Region const region) {
+
+	static G4String const names[NumOfRegions] = { "target", "vacuumTubes",
+			"collimators", "shielding" };
+	return names[static_cast<std::size_t>(region)];
+
+}
+
+G4String const& Beam5::VacuumEnvelopeName() {
+
+	static G4String const name = "vacuumEnvelope";
+	return name;
+
+}
+
+G4bool Beam5::GetFastVacuum() const {
+
+	return fastVacuum;
+
+}
+
+void Beam5::SetFastVacuum(G4bool const v) {
+
+	fastVacuum = v;
+
+}
+
+G4bool Beam5::GetC1Native() const {
+
+	return c1Native;
+
+}
+
+void Beam5::SetC1Native(G4bool const v) {
+
+	c1Native = v;
+
+}
+
+G4bool Beam5::GetC2Native() const {
+
+	return c2Native;
+
+}
+
+void Beam5::SetC2Native(G4bool const v) {
+
+	c2Native = v;
+
+}
+
+G4bool Beam5::GetHasSections() const {
+
+	return hasSections;
+
+}
+
+void Beam5::SetHasSections(G4bool const v) {
+
+	hasSections = v;
+
+}
+
+G4double Beam5::GetSectionSmartless() const {
+
+	return sectionSmartless;
+
+}
+
+void Beam5::SetSectionSmartless(G4double const v) {
+
+	sectionSmartless = v;
+
+}
+
+void Beam5::RunNavigationBenchmark(G4int const numOfRays) const {
+
+	auto const world =
+			G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
+	if (!world) {
+		G4cout << "Beam5: the geometry is not constructed" << G4endl;
+		return;
+	}
+
+	// the rays reach the far end of the world near its side surface
+	auto const result = util::NavigationBenchmark::Run(world,
+			component::BeamPointer::GetInstance()->GetPosition(),
+			worldRadius / (zeroPosition + worldLength), numOfRays);
+
+	G4cout << "Beam5: navigation of " << result.numOfRays << " rays, "
+			<< result.length / m << " m, " << result.numOfSteps << " steps, "
+			<< result.time / s << " s, "
+			<< (result.length > 0 ? result.time / ns / (result.length / m) : 0.)
+			<< " ns per metre" << G4endl;
+
+}
+
 G4double Beam5::GetXAngle() const {
 
 	return xAngle;
@@ -476,9 +695,9 @@ void Beam5::SetVerboseLevel(G4int const aVerboseLevel) {
 	verboseLevel = aVerboseLevel;
 }
 
-void Beam5::SetDetector(G4VSensitiveDetector* aDetector) {
+void Beam5::SetDetectorFactory(DetectorFactory const& aDetectorFactory) {
 
-	detector = aDetector;
+	detectorFactory = aDetectorFactory;
 
 }
 
@@ -506,9 +725,9 @@ void Beam5::SetC5Material(G4String const& aMaterial) {
 
 }
 
-G4VSensitiveDetector* Beam5::GetDetector() const {
+Beam5::DetectorFactory const& Beam5::GetDetectorFactory() const {
 
-	return detector;
+	return detectorFactory;
 
 }
 
@@ -520,11 +739,55 @@ void Beam5::PlaceComponent(G4LogicalVolume* const world,
 	G4bool const single = false;
 	G4int const numOfCopies = 0;
 
-	new G4PVPlacement(noRotation,
-			G4ThreeVector(0, 0,
-					0.5 * (zeroPosition - worldLength) + position
-							+ componentLength / 2), component,
-			component->GetName(), world, single, numOfCopies, checkOverlaps);
+	G4double origin;
+	auto const mother = MotherAt(world, position, componentLength, origin);
+
+	// overlaps are checked by OverlapCache when the geometry is complete
+	auto const placement = new G4PVPlacement(noRotation,
+			G4ThreeVector(0, 0, origin + position + componentLength / 2),
+			component, component->GetName(), mother, single, numOfCopies,
+			false);
+	if (!checkOverlaps) {
+		component::OverlapCache::GetInstance()->Exclude(placement);
+	}
+
+}
+
+void Beam5::AddSection(G4LogicalVolume* const world, G4String const& name,
+		G4double const begin, G4double const end) {
+
+	auto const nist = G4NistManager::Instance();
+
+	G4String const sSection = util::NameBuilder::Make("section", name.c_str());
+	auto const logicSection = new G4LogicalVolume(
+			MakeCylinder(sSection, end - begin),
+			nist->FindOrBuildMaterial(worldMaterial), sSection);
+	logicSection->SetVisAttributes(G4VisAttributes(false));
+	logicSection->SetSmartless(sectionSmartless);
+
+	// the section is placed in the world before it is known as a mother volume
+	PlaceComponent(world, logicSection, begin, end - begin);
+	sections.push_back(Section { begin, end, logicSection });
+
+}
+
+G4LogicalVolume* Beam5::MotherAt(G4LogicalVolume* const world,
+		G4double const position, G4double const length,
+		G4double& origin) const {
+
+	// positions of the components are sums of lengths with rounding errors
+	G4double const tolerance = 1. * um;
+
+	for (auto const& section : sections) {
+		if (position >= section.begin - tolerance
+				&& position + length <= section.end + tolerance) {
+			origin = -0.5 * (section.begin + section.end);
+			return section.volume;
+		}
+	}
+
+	origin = 0.5 * (zeroPosition - worldLength);
+	return world;
 
 }
 
@@ -533,6 +796,7 @@ void Beam5::PlaceCollimator(G4LogicalVolume* const world,
 		G4double const collimatorLength) {
 
 	PlaceComponent(world, collimator, position, collimatorLength);
+	AddToRegion(Region::Collimators, collimator);
 
 }
 
@@ -542,6 +806,32 @@ G4VSolid* Beam5::MakeCylinder(G4String const &name, G4double const len) {
 
 }
 
+void Beam5::ConstructSDandField() {
+
+	// the master thread of a multithreaded run processes no events
+	auto const runManager = G4RunManager::GetRunManager();
+	if (runManager->GetRunManagerType() == G4RunManager::masterRM) {
+		return;
+	}
+
+	if (detectorVolume) {
+		auto const detector = detectorFactory();
+		G4SDManager::GetSDMpointer()->AddNewDetector(detector);
+		SetSensitiveDetector(detectorVolume, detector);
+	}
+
+	if (fastVacuum) {
+		auto const region = G4RegionStore::GetInstance()->GetRegion(
+				util::NameBuilder::Make("beam5", VacuumEnvelopeName().c_str()),
+				false);
+		if (region) {
+			// the model is owned by the fast simulation manager of the thread
+			new component::VacuumTransportModel(region);
+		}
+	}
+
+}
+
 G4VSensitiveDetector* Beam5::MakeDefaultDetector() {
 
 	return new isnp::detector::Basic;
@@ -560,6 +850,7 @@ G4LogicalVolume* Beam5::MakeFlange(G4int const ntubeNo, G4int const flangeNo) {
 			nist->FindOrBuildMaterial(ntubeFlangeMaterial), sFlange);
 	logicFlange->SetVisAttributes(
 			G4VisAttributes(repository::Colours::Aluminium()));
+	AddToRegion(Region::VacuumTubes, logicFlange);
 	return logicFlange;
 
 }
@@ -587,6 +878,7 @@ void Beam5::AddNTube(G4LogicalVolume* const logicWorld,
 		logicInner->SetVisAttributes(
 				G4VisAttributes(repository::Colours::Air()));
 		PlaceComponent(logicWorld, logicInner, innerPos, innerLength);
+		AddToVacuum(logicInner);
 	}
 
 	{
@@ -599,6 +891,7 @@ void Beam5::AddNTube(G4LogicalVolume* const logicWorld,
 		logicOuter->SetVisAttributes(
 				G4VisAttributes(repository::Colours::Aluminium()));
 		PlaceComponent(logicWorld, logicOuter, innerPos, innerLength);
+		AddToRegion(Region::VacuumTubes, logicOuter);
 	}
 
 	{
@@ -608,6 +901,106 @@ void Beam5::AddNTube(G4LogicalVolume* const logicWorld,
 
 }
 
+void Beam5::AddToRegion(Region const region, G4LogicalVolume* const volume) {
+
+	regionVolumes[static_cast<std::size_t>(region)].push_back(volume);
+
+}
+
+void Beam5::AddToVacuum(G4LogicalVolume* const volume) {
+
+	vacuumVolumes.push_back(volume);
+
+}
+
+void Beam5::ConstructRegions() {
+
+	for (std::size_t i = 0; i < NumOfRegions; i++) {
+		auto const region = static_cast<Region>(i);
+		auto volumes = regionVolumes[i];
+
+		// with the fast vacuum the evacuated volumes are the envelope of the model
+		if (region == Region::VacuumTubes && !fastVacuum) {
+			volumes.insert(std::end(volumes), std::begin(vacuumVolumes),
+					std::end(vacuumVolumes));
+		}
+
+		ConstructRegion(
+				util::NameBuilder::Make("beam5", RegionName(region).c_str()),
+				volumes, regionSettings[i]);
+	}
+
+	if (fastVacuum) {
+		ConstructRegion(
+				util::NameBuilder::Make("beam5", VacuumEnvelopeName().c_str()),
+				vacuumVolumes, GetRegionSettings(Region::VacuumTubes));
+	}
+
+}
+
+void Beam5::ConstructRegion(G4String const& name,
+		std::vector<G4LogicalVolume*> const& volumes,
+		RegionSettings const& settings) {
+
+	auto const store = G4RegionStore::GetInstance();
+	auto region = store->GetRegion(name, false);
+
+	// the volumes of a previous construction are not in the geometry any more
+	if (region) {
+		std::vector<G4LogicalVolume*> const staleVolumes(
+				region->GetRootLogicalVolumeIterator(),
+				region->GetRootLogicalVolumeIterator()
+						+ region->GetNumberOfRootVolumes());
+		for (auto const volume : staleVolumes) {
+			region->RemoveRootLogicalVolume(volume);
+		}
+	}
+
+	if (volumes.empty()) {
+		return;
+	}
+
+	if (!region) {
+		region = new G4Region(name);
+	}
+
+	for (auto const volume : volumes) {
+		region->AddRootLogicalVolume(volume);
+	}
+
+	if (settings.productionCut > 0) {
+		auto& cuts = productionCuts[name];
+		if (!cuts) {
+			cuts = new G4ProductionCuts;
+		}
+		cuts->SetProductionCut(settings.productionCut);
+		region->SetProductionCuts(cuts);
+	} else {
+		// the default cuts follow /run/setCut
+		region->SetProductionCuts(
+				G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts());
+	}
+
+	// limits are applied by G4UserSpecialCuts registered with the physics list
+	if (settings.maxTime > 0 || settings.minKineticEnergy > 0) {
+		region->SetUserLimits(
+				new G4UserLimits(DBL_MAX, DBL_MAX,
+						settings.maxTime > 0 ? settings.maxTime : DBL_MAX,
+						settings.minKineticEnergy));
+	} else {
+		region->SetUserLimits(nullptr);
+	}
+
+	if (verboseLevel >= 1 && G4Threading::IsMasterThread()) {
+		G4cout << "Beam5: region " << name << " of " << volumes.size()
+				<< " volumes, production cut " << settings.productionCut / mm
+				<< " mm, max time " << settings.maxTime / ns
+				<< " ns, min kinetic energy " << settings.minKineticEnergy / MeV
+				<< " MeV" << G4endl;
+	}
+
+}
+
 }
 
 }
@@ -5,6 +5,7 @@
 #include <G4UIcmdWithADoubleAndUnit.hh>
 #include "G4UIcmdWithABool.hh"
 #include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
 
 #include "isnp/facility/Beam5Messenger.hh"
 
@@ -110,11 +111,158 @@ static std::unique_ptr<G4UIcmdWithABool> MakeHasTarget(
 
 }
 
+static std::unique_ptr<G4UIcmdWithABool> MakeFastVacuum(
+		Beam5Messenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithABool
+			> (DIR "fastVacuum", inst);
+	result->SetGuidance(
+			"Move neutrons through the vacuum tubes straight to the exit in one step.");
+	result->SetGuidance(
+			"  the residual gas is taken into account by the weight of a neutron");
+	result->SetGuidance("Choice : true, 1, false, 0");
+	result->SetParameterName("value", true);
+	result->SetDefaultValue("true");
+	result->AvailableForStates(G4State_PreInit);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithABool> MakeNative(
+		Beam5Messenger* const inst, char const* const name,
+		char const* const guidance) {
+
+	auto result = std::make_unique < G4UIcmdWithABool > (name, inst);
+	result->SetGuidance(guidance);
+	result->SetGuidance(
+			"  the aperture is a daughter volume instead of a boolean subtraction");
+	result->SetGuidance("Choice : true, 1, false, 0");
+	result->SetParameterName("value", true);
+	result->SetDefaultValue("true");
+	result->AvailableForStates(G4State_PreInit);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithABool> MakeHasSections(
+		Beam5Messenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithABool > (DIR "sections", inst);
+	result->SetGuidance(
+			"Place the components in envelopes, one per section of the beamline.");
+	result->SetGuidance("  the geometry is the same, the navigation is faster");
+	result->SetGuidance("Choice : true, 1, false, 0");
+	result->SetParameterName("value", true);
+	result->SetDefaultValue("true");
+	result->AvailableForStates(G4State_PreInit);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithADouble> MakeSectionSmartless(
+		Beam5Messenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithADouble
+			> (DIR "sectionSmartless", inst);
+	result->SetGuidance(
+			"Set the number of voxels per daughter volume of the section envelopes.");
+	result->SetParameterName("smartless", false);
+	result->SetRange("smartless > 0");
+	result->AvailableForStates(G4State_PreInit);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithAnInteger> MakeNavigationBenchmark(
+		Beam5Messenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAnInteger
+			> (DIR "navigationBenchmark", inst);
+	result->SetGuidance(
+			"Shoot geantino rays along the beam and print the navigation time per metre.");
+	result->SetParameterName("numOfRays", true);
+	result->SetDefaultValue(1000);
+	result->SetRange("numOfRays > 0");
+	result->AvailableForStates(G4State_Idle);
+	// the geometry is shared by all the threads
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIdirectory> MakeRegionDirectory() {
+
+	auto result = std::make_unique < G4UIdirectory > (DIR "region/");
+	result->SetGuidance(
+			"ISNP Beam #5 Region Commands: production cuts and track limits");
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeRegionCommand(
+		Beam5Messenger* const inst, char const* const name,
+		char const* const guidance, char const* const unitCategory,
+		char const* const defaultUnit) {
+
+	auto result = std::make_unique < G4UIcommand > (name, inst);
+	result->SetGuidance(guidance);
+	result->SetGuidance("  zero means the default (no limit)");
+	result->AvailableForStates(G4State_PreInit);
+
+	auto const region = new G4UIparameter("region", 's', false);
+	region->SetGuidance("Region name");
+	G4String candidates;
+	for (std::size_t i = 0; i < Beam5::NumOfRegions; i++) {
+		if (i > 0) {
+			candidates += " ";
+		}
+		candidates += Beam5::RegionName(static_cast<Beam5::Region>(i));
+	}
+	region->SetParameterCandidates(candidates);
+	result->SetParameter(region);
+
+	auto const value = new G4UIparameter("value", 'd', false);
+	value->SetGuidance("Value");
+	value->SetParameterRange("value >= 0");
+	result->SetParameter(value);
+
+	auto const unit = new G4UIparameter("unit", 's', true);
+	unit->SetGuidance("Unit");
+	unit->SetDefaultValue(defaultUnit);
+	unit->SetParameterCandidates(G4UIcommand::UnitsList(unitCategory));
+	result->SetParameter(unit);
+
+	return result;
+
+}
+
 Beam5Messenger::Beam5Messenger(Beam5& facility_) :
 		facility(facility_), directory(MakeDirectory()), c5DiameterCmd(
 				MakeC5Diameter(this)), xAngleCmd(MakeXAngle(this)), yAngleCmd(
 				MakeYAngle(this)), verboseCmd(MakeVerboseLevel(this)), c5MaterialCmd(
-				MakeC5Material(this)), hasTargetCmd(MakeHasTarget(this)) {
+				MakeC5Material(this)), hasTargetCmd(MakeHasTarget(this)), fastVacuumCmd(
+				MakeFastVacuum(this)), c1NativeCmd(
+				MakeNative(this, DIR "c1/native",
+						"Build collimator #1 of native solids.")), c2NativeCmd(
+				MakeNative(this, DIR "c2/native",
+						"Build collimator #2 of native solids.")), hasSectionsCmd(
+				MakeHasSections(this)), sectionSmartlessCmd(
+				MakeSectionSmartless(this)), navigationBenchmarkCmd(
+				MakeNavigationBenchmark(this)), regionDirectory(
+				MakeRegionDirectory()), regionCutCmd(
+				MakeRegionCommand(this, DIR "region/cut",
+						"Set the production cut of a region", "Length", "mm")), regionMaxTimeCmd(
+				MakeRegionCommand(this, DIR "region/maxTime",
+						"Kill tracks in a region after the global time", "Time",
+						"ns")), regionMinEnergyCmd(
+				MakeRegionCommand(this, DIR "region/minEnergy",
+						"Kill tracks in a region below the kinetic energy",
+						"Energy", "MeV")) {
 
 }
 
@@ -138,6 +286,17 @@ G4String Beam5Messenger::GetCurrentValue(G4UIcommand* const command) {
 		ans = facility.GetC5Material();
 	} else if (command == hasTargetCmd.get()) {
 		ans = hasTargetCmd->ConvertToString(facility.GetHasSpallationTarget());
+	} else if (command == fastVacuumCmd.get()) {
+		ans = fastVacuumCmd->ConvertToString(facility.GetFastVacuum());
+	} else if (command == c1NativeCmd.get()) {
+		ans = c1NativeCmd->ConvertToString(facility.GetC1Native());
+	} else if (command == c2NativeCmd.get()) {
+		ans = c2NativeCmd->ConvertToString(facility.GetC2Native());
+	} else if (command == hasSectionsCmd.get()) {
+		ans = hasSectionsCmd->ConvertToString(facility.GetHasSections());
+	} else if (command == sectionSmartlessCmd.get()) {
+		ans = sectionSmartlessCmd->ConvertToString(
+				facility.GetSectionSmartless());
 	}
 
 	return ans;
@@ -160,8 +319,55 @@ void Beam5Messenger::SetNewValue(G4UIcommand* const command,
 	} else if (command == hasTargetCmd.get()) {
 		facility.SetHasSpallationTarget(
 				hasTargetCmd->GetNewBoolValue(newValue));
+	} else if (command == fastVacuumCmd.get()) {
+		facility.SetFastVacuum(fastVacuumCmd->GetNewBoolValue(newValue));
+	} else if (command == c1NativeCmd.get()) {
+		facility.SetC1Native(c1NativeCmd->GetNewBoolValue(newValue));
+	} else if (command == c2NativeCmd.get()) {
+		facility.SetC2Native(c2NativeCmd->GetNewBoolValue(newValue));
+	} else if (command == hasSectionsCmd.get()) {
+		facility.SetHasSections(hasSectionsCmd->GetNewBoolValue(newValue));
+	} else if (command == sectionSmartlessCmd.get()) {
+		facility.SetSectionSmartless(
+				sectionSmartlessCmd->GetNewDoubleValue(newValue));
+	} else if (command == navigationBenchmarkCmd.get()) {
+		facility.RunNavigationBenchmark(
+				navigationBenchmarkCmd->GetNewIntValue(newValue));
+	} else if (command == regionCutCmd.get()
+			|| command == regionMaxTimeCmd.get()
+			|| command == regionMinEnergyCmd.get()) {
+		std::istringstream is(newValue);
+		G4String name, unit;
+		G4double value;
+		is >> name >> value >> unit;
+		value *= G4UIcommand::ValueOf(unit);
+
+		auto const region = StringToRegion(name);
+		auto settings = facility.GetRegionSettings(region);
+		if (command == regionCutCmd.get()) {
+			settings.productionCut = value;
+		} else if (command == regionMaxTimeCmd.get()) {
+			settings.maxTime = value;
+		} else {
+			settings.minKineticEnergy = value;
+		}
+		facility.SetRegionSettings(region, settings);
+	}
+
+}
+
+Beam5::Region Beam5Messenger::StringToRegion(G4String const& name) {
+
+	for (std::size_t i = 0; i < Beam5::NumOfRegions; i++) {
+		auto const region = static_cast<Beam5::Region>(i);
+		if (name == Beam5::RegionName(region)) {
+			return region;
+		}
 	}
 
+	// names are checked by the parameter candidates
+	return Beam5::Region::Target;
+
 }
 
 }
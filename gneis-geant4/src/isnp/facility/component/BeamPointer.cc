@@ -37,6 +37,18 @@ void BeamPointer::SetPosition(G4ThreeVector const v) {
 
 }
 
+util::ApertureChain const& BeamPointer::GetApertures() const {
+
+	return apertures;
+
+}
+
+void BeamPointer::SetApertures(util::ApertureChain const& anApertures) {
+
+	apertures = anApertures;
+
+}
+
 }
 
 }
@@ -2,6 +2,8 @@
 #include <G4Tubs.hh>
 #include <G4Box.hh>
 #include <G4SubtractionSolid.hh>
+#include <G4PVPlacement.hh>
+#include <G4VisAttributes.hh>
 #include "isnp/facility/component/BoxComponent.hh"
 
 namespace isnp {
@@ -40,6 +42,25 @@ G4VSolid* BoxComponent::SolidWithAperture(const G4String &name,
 
 }
 
+void BoxComponent::PlaceAperture(const G4String &name,
+		G4LogicalVolume* const component, util::Box const& aperture,
+		G4Material* const material) {
+
+	G4bool const single = false;
+	G4int const numOfCopies = 0;
+	// overlaps are checked by OverlapCache when the geometry is complete
+	G4bool const checkOverlaps = false;
+
+	auto const solid = new G4Box(util::NameBuilder::Make(name, "Aperture"),
+			aperture.GetHalfWidth(), aperture.GetHalfHeight(),
+			aperture.GetHalfLength());
+	auto const logic = new G4LogicalVolume(solid, material, solid->GetName());
+	logic->SetVisAttributes(G4VisAttributes(false));
+	new G4PVPlacement(G4Transform3D(), logic, logic->GetName(), component,
+			single, numOfCopies, checkOverlaps);
+
+}
+
 }
 
 }
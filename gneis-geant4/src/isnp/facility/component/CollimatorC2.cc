@@ -32,6 +32,22 @@ G4LogicalVolume* CollimatorC2::AsCylinder(const G4String &name,
 
 }
 
+G4LogicalVolume* CollimatorC2::AsNativeCylinder(G4double const outerRadius,
+		G4Material* const apertureMaterial) const {
+
+	const auto nist = G4NistManager::Instance();
+	auto const name = GetDefaultName();
+
+	const auto logic = new G4LogicalVolume(
+			MakeCylinder(name, aperture.GetLength(), outerRadius),
+			nist->FindOrBuildMaterial("G4_STAINLESS-STEEL"), name);
+	logic->SetVisAttributes(G4VisAttributes(repository::Colours::Steel()));
+	PlaceAperture(name, logic, aperture, apertureMaterial);
+
+	return logic;
+
+}
+
 G4LogicalVolume* CollimatorC2::Instance(G4VSolid* const outer) const {
 
 	return Instance(GetDefaultName(), outer);
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <sstream>
+
+#include <G4SystemOfUnits.hh>
+
+#include "isnp/facility/component/ImportanceRegions.hh"
+#include "isnp/facility/component/ImportanceRegionsMessenger.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+ImportanceRegions::ImportanceRegions() :
+		messenger(std::make_unique < ImportanceRegionsMessenger > (*this)) {
+}
+
+void ImportanceRegions::Add(G4String const& name, G4double const z,
+		G4double const importance) {
+
+	regions.erase(
+			std::remove_if(std::begin(regions), std::end(regions),
+					[&name](Region const& r) {
+						return r.name == name;
+					}), std::end(regions));
+
+	auto const it = std::upper_bound(std::begin(regions), std::end(regions), z,
+			[](G4double const v, Region const& r) {
+				return v < r.z;
+			});
+	regions.insert(it, Region { name, z, importance });
+
+}
+
+void ImportanceRegions::Clear() {
+
+	regions.clear();
+
+}
+
+G4String ImportanceRegions::ToString() const {
+
+	std::ostringstream os;
+	os.precision(10);
+	char const* separator = "";
+	for (auto const& r : regions) {
+		os << separator << r.name << ' ' << r.importance << ' ' << r.z / mm;
+		separator = " ";
+	}
+	return os.str();
+
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,111 @@
+#include <sstream>
+
+#include "isnp/facility/component/ImportanceRegionsMessenger.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+#define DIR "/isnp/facility/component/importance/"
+
+static std::unique_ptr<G4UIdirectory> MakeDirectory() {
+
+	auto result = std::make_unique < G4UIdirectory > (DIR);
+	result->SetGuidance("Geometric Importance Commands");
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeAdd(
+		ImportanceRegionsMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand > (DIR "add", inst);
+	result->SetGuidance(
+			"Add a region of the given importance starting at the given position");
+	result->SetGuidance(
+			"  position is Z coordinate in the beam coordinate system,");
+	result->SetGuidance("  region ends where the next region starts");
+	result->SetGuidance(
+			"  effective with /isnp/importanceBiasing only");
+
+	auto const name = new G4UIparameter("name", 's', false);
+	name->SetGuidance("Name of the region");
+	result->SetParameter(name);
+
+	auto const importance = new G4UIparameter("importance", 'd', false);
+	importance->SetGuidance("Importance of the region");
+	importance->SetParameterRange("importance > 0");
+	result->SetParameter(importance);
+
+	auto const z = new G4UIparameter("z", 'd', false);
+	z->SetGuidance("Position of the region start");
+	result->SetParameter(z);
+
+	auto const unit = new G4UIparameter("unit", 's', true);
+	unit->SetGuidance("Length unit");
+	unit->SetDefaultValue("mm");
+	unit->SetParameterCandidates(G4UIcommand::UnitsList("Length"));
+	result->SetParameter(unit);
+
+	result->AvailableForStates(G4State_PreInit);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithoutParameter> MakeClear(
+		ImportanceRegionsMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithoutParameter
+			> (DIR "clear", inst);
+	result->SetGuidance("Remove all the importance regions");
+	result->AvailableForStates(G4State_PreInit);
+
+	return result;
+
+}
+
+ImportanceRegionsMessenger::ImportanceRegionsMessenger(
+		ImportanceRegions& aComponent) :
+		component(aComponent), directory(MakeDirectory()), addCmd(
+				MakeAdd(this)), clearCmd(MakeClear(this)) {
+}
+
+ImportanceRegionsMessenger::~ImportanceRegionsMessenger() {
+}
+
+G4String ImportanceRegionsMessenger::GetCurrentValue(
+		G4UIcommand* const command) {
+
+	G4String ans;
+
+	if (command == addCmd.get()) {
+		ans = component.ToString();
+	}
+
+	return ans;
+
+}
+
+void ImportanceRegionsMessenger::SetNewValue(G4UIcommand* const command,
+		G4String const newValue) {
+
+	if (command == addCmd.get()) {
+		std::istringstream is(newValue);
+		G4String name, unit;
+		G4double z, importance;
+		is >> name >> importance >> z >> unit;
+		component.Add(name, z * G4UIcommand::ValueOf(unit), importance);
+	} else if (command == clearCmd.get()) {
+		component.Clear();
+	}
+
+}
+
+}
+
+}
+
+}
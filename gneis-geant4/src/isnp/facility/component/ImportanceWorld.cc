@@ -0,0 +1,93 @@
+#include <algorithm>
+
+#include <G4Box.hh>
+#include <G4IntersectionSolid.hh>
+#include <G4LogicalVolume.hh>
+#include <G4PVPlacement.hh>
+#include <G4IStore.hh>
+#include <G4VisAttributes.hh>
+
+#include "isnp/facility/component/ImportanceWorld.hh"
+#include "isnp/facility/component/ImportanceRegions.hh"
+#include "isnp/facility/component/BeamPointer.hh"
+#include "isnp/util/Convert.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+G4String const ImportanceWorld::WorldName = "importanceWorld";
+
+ImportanceWorld::ImportanceWorld() :
+		G4VUserParallelWorld(WorldName), ghostWorld(nullptr) {
+
+}
+
+void ImportanceWorld::Construct() {
+
+	ghostWorld = GetWorld();
+	cells.clear();
+
+	auto const& regions = ImportanceRegions::GetInstance()->GetRegions();
+	if (regions.empty()) {
+		return;
+	}
+
+	auto const logicWorld = ghostWorld->GetLogicalVolume();
+	auto const solidWorld = logicWorld->GetSolid();
+
+	// beam pointer is set by the mass world constructed before
+	auto const bp = BeamPointer::GetInstance();
+	auto const beamTransform = util::Convert::VectorsToTransform(
+			bp->GetRotation(), bp->GetPosition());
+
+	// slices are cut of the world, so their sizes only have to exceed the world ones
+	auto const size = 2 * (solidWorld->GetExtent().GetExtentRadius()
+			+ bp->GetPosition().mag());
+
+	for (std::size_t i = 0; i < regions.size(); i++) {
+		auto const& r = regions[i];
+		auto const zFrom = std::max(r.z, -size);
+		auto const zTo = i + 1 < regions.size() ? regions[i + 1].z : size;
+		if (!(zTo > zFrom)) {
+			continue;
+		}
+
+		auto const slice = new G4Box(r.name + ".slice", size, size,
+				(zTo - zFrom) / 2);
+		auto const solid = new G4IntersectionSolid(r.name, solidWorld, slice,
+				beamTransform
+						* G4Translate3D(G4ThreeVector(0, 0, (zFrom + zTo) / 2)));
+
+		// material of the mass world is used by the tracking
+		auto const logic = new G4LogicalVolume(solid, nullptr, r.name);
+		logic->SetVisAttributes(G4VisAttributes(false));
+
+		auto const phys = new G4PVPlacement(nullptr, G4ThreeVector(), logic,
+				r.name, logicWorld, false, 0, false);
+		cells.emplace_back(phys, r.importance);
+	}
+
+}
+
+void ImportanceWorld::ConstructSD() {
+
+	if (!ghostWorld) {
+		return;
+	}
+
+	auto const store = G4IStore::GetInstance(WorldName);
+	store->AddImportanceGeometryCell(1, *ghostWorld);
+	for (auto const& cell : cells) {
+		store->AddImportanceGeometryCell(cell.second, *cell.first);
+	}
+
+}
+
+}
+
+}
+
+}
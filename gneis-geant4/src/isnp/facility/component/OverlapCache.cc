@@ -0,0 +1,241 @@
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <G4AffineTransform.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Material.hh>
+#include <G4VSolid.hh>
+
+#include "isnp/facility/component/OverlapCache.hh"
+#include "isnp/facility/component/OverlapCacheMessenger.hh"
+#include "isnp/util/ContentHash.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+static void Describe(G4VPhysicalVolume const* const placement,
+		std::ostream& os) {
+
+	os << placement->GetName() << ' ' << placement->GetCopyNo() << ' '
+			<< placement->GetTranslation();
+	if (auto const rotation = placement->GetRotation()) {
+		os << ' ' << rotation->xx() << ' ' << rotation->xy() << ' '
+				<< rotation->xz() << ' ' << rotation->yx() << ' '
+				<< rotation->yy() << ' ' << rotation->yz() << ' '
+				<< rotation->zx() << ' ' << rotation->zy() << ' '
+				<< rotation->zz();
+	}
+
+	auto const logical = placement->GetLogicalVolume();
+	os << '\n' << logical->GetName() << ' '
+			<< logical->GetMaterial()->GetName() << '\n';
+	logical->GetSolid()->StreamInfo(os);
+
+	for (std::size_t i = 0; i < logical->GetNoDaughters(); i++) {
+		Describe(logical->GetDaughter(i), os);
+	}
+
+}
+
+OverlapCache::OverlapCache() :
+		messenger(std::make_unique < OverlapCacheMessenger > (*this)), enabled(
+				true), forced(false), directory("isnp-cache") {
+}
+
+void OverlapCache::Exclude(G4VPhysicalVolume const* const placement) {
+
+	excluded.insert(placement);
+
+}
+
+std::size_t OverlapCache::Validate(G4VPhysicalVolume* const world) {
+
+	auto const hash = Hash(world);
+	auto const fileName = FileName(hash);
+
+	std::size_t result = 0;
+
+	std::ifstream is;
+	if (enabled && !forced) {
+		is.open(fileName);
+	}
+
+	if (is >> result) {
+		G4cout << "OverlapCache: the geometry "
+				<< util::ContentHash::ToString(hash) << " was checked before, "
+				<< result << " overlapping volumes" << G4endl;
+	} else {
+		std::set<G4LogicalVolume const*> checked;
+		result = Check(world->GetLogicalVolume(), checked);
+
+		if (enabled) {
+			Write(fileName, result);
+		}
+	}
+
+	excluded.clear();
+	forced = false;
+
+	return result;
+
+}
+
+uint64_t OverlapCache::Hash(G4VPhysicalVolume const* const world) {
+
+	std::ostringstream os;
+	os << std::setprecision(17);
+	Describe(world, os);
+
+	return util::ContentHash::Of(os.str());
+
+}
+
+G4bool OverlapCache::GetEnabled() const {
+
+	return enabled;
+
+}
+
+void OverlapCache::SetEnabled(G4bool const v) {
+
+	enabled = v;
+
+}
+
+G4String const& OverlapCache::GetDirectory() const {
+
+	return directory;
+
+}
+
+void OverlapCache::SetDirectory(G4String const& v) {
+
+	directory = v;
+
+}
+
+void OverlapCache::Revalidate() {
+
+	forced = true;
+
+}
+
+std::size_t OverlapCache::Check(G4LogicalVolume* const volume,
+		std::set<G4LogicalVolume const*>& checked) const {
+
+	// daughters of a volume placed many times are checked once
+	if (!checked.insert(volume).second) {
+		return 0;
+	}
+
+	std::size_t result = 0;
+
+	for (std::size_t i = 0; i < volume->GetNoDaughters(); i++) {
+		auto const daughter = volume->GetDaughter(i);
+		if (excluded.count(daughter) == 0 && Overlaps(volume, daughter)) {
+			result++;
+		}
+		result += Check(daughter->GetLogicalVolume(), checked);
+	}
+
+	return result;
+
+}
+
+G4bool OverlapCache::Overlaps(G4LogicalVolume const* const mother,
+		G4VPhysicalVolume const* const daughter) const {
+
+	// points on the surface as G4PVPlacement::CheckOverlaps takes by default,
+	// which would not skip the excluded sisters
+	G4int const numOfPoints = 1000;
+
+	auto const solid = daughter->GetLogicalVolume()->GetSolid();
+	G4AffineTransform const transform(daughter->GetRotation(),
+			daughter->GetTranslation());
+
+	for (G4int n = 0; n < numOfPoints; n++) {
+		auto const point = transform.TransformPoint(solid->GetPointOnSurface());
+
+		if (mother->GetSolid()->Inside(point) == kOutside) {
+			G4cout << "OverlapCache: " << daughter->GetName()
+					<< " protrudes from " << mother->GetName() << G4endl;
+			return true;
+		}
+
+		for (std::size_t i = 0; i < mother->GetNoDaughters(); i++) {
+			auto const sister = mother->GetDaughter(i);
+			if (sister == daughter || excluded.count(sister) != 0) {
+				continue;
+			}
+
+			auto const sisterSolid = sister->GetLogicalVolume()->GetSolid();
+			G4AffineTransform const sisterTransform(sister->GetRotation(),
+					sister->GetTranslation());
+			auto overlaps = sisterSolid->Inside(
+					sisterTransform.Inverse().TransformPoint(point)) == kInside;
+
+			// a sister inside the volume has no points of its surface in the sister
+			if (!overlaps && n == 0) {
+				auto const sisterPoint = sisterTransform.TransformPoint(
+						sisterSolid->GetPointOnSurface());
+				overlaps = solid->Inside(
+						transform.Inverse().TransformPoint(sisterPoint)) == kInside;
+			}
+
+			if (overlaps) {
+				G4cout << "OverlapCache: " << daughter->GetName()
+						<< " overlaps " << sister->GetName() << " in "
+						<< mother->GetName() << G4endl;
+				return true;
+			}
+		}
+	}
+
+	return false;
+
+}
+
+void OverlapCache::Write(G4String const& fileName,
+		std::size_t const numOfOverlaps) const {
+
+	::mkdir(directory.c_str(), 0777);
+
+	// jobs sharing the directory never see a partially written verdict
+	std::string temporary = fileName + ".XXXXXX";
+	auto const fd = ::mkstemp(&temporary[0]);
+	if (fd < 0) {
+		G4cerr << "OverlapCache: cannot write " << fileName << G4endl;
+		return;
+	}
+	::close(fd);
+
+	std::ofstream os(temporary);
+	os << numOfOverlaps << '\n';
+	os.close();
+
+	if (!os || std::rename(temporary.c_str(), fileName.c_str()) != 0) {
+		G4cerr << "OverlapCache: cannot write " << fileName << G4endl;
+		std::remove(temporary.c_str());
+	}
+
+}
+
+G4String OverlapCache::FileName(uint64_t const hash) const {
+
+	return directory + "/overlaps-" + util::ContentHash::ToString(hash)
+			+ ".txt";
+
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,105 @@
+#include "isnp/facility/component/OverlapCacheMessenger.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+#define DIR "/isnp/facility/component/overlapCache/"
+
+static std::unique_ptr<G4UIdirectory> MakeDirectory() {
+
+	auto result = std::make_unique < G4UIdirectory > (DIR);
+	result->SetGuidance("Overlap Check Cache Commands");
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithABool> MakeEnable(
+		OverlapCacheMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithABool > (DIR "enable", inst);
+	result->SetGuidance(
+			"Check overlaps of a geometry only if its verdict is not cached.");
+	result->SetGuidance(
+			"  otherwise overlaps are checked on every construction");
+	result->SetGuidance("Choice : true, 1, false, 0");
+	result->SetParameterName("value", true);
+	result->SetDefaultValue("true");
+	result->AvailableForStates(G4State_PreInit);
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithAString> MakeDirectoryCmd(
+		OverlapCacheMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAString
+			> (DIR "directory", inst);
+	result->SetGuidance("Set the directory of the cached verdicts.");
+	result->SetParameterName("directory", false);
+	result->AvailableForStates(G4State_PreInit);
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithoutParameter> MakeRevalidate(
+		OverlapCacheMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithoutParameter
+			> (DIR "revalidate", inst);
+	result->SetGuidance(
+			"Check overlaps on the next construction regardless of the cache.");
+	result->AvailableForStates(G4State_PreInit, G4State_Idle);
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+OverlapCacheMessenger::OverlapCacheMessenger(OverlapCache& aComponent) :
+		component(aComponent), directory(MakeDirectory()), enableCmd(
+				MakeEnable(this)), directoryCmd(MakeDirectoryCmd(this)), revalidateCmd(
+				MakeRevalidate(this)) {
+}
+
+OverlapCacheMessenger::~OverlapCacheMessenger() {
+}
+
+G4String OverlapCacheMessenger::GetCurrentValue(G4UIcommand* const command) {
+
+	G4String ans;
+
+	if (command == enableCmd.get()) {
+		ans = enableCmd->ConvertToString(component.GetEnabled());
+	} else if (command == directoryCmd.get()) {
+		ans = component.GetDirectory();
+	}
+
+	return ans;
+
+}
+
+void OverlapCacheMessenger::SetNewValue(G4UIcommand* const command,
+		G4String const newValue) {
+
+	if (command == enableCmd.get()) {
+		component.SetEnabled(enableCmd->GetNewBoolValue(newValue));
+	} else if (command == directoryCmd.get()) {
+		component.SetDirectory(newValue);
+	} else if (command == revalidateCmd.get()) {
+		component.Revalidate();
+	}
+
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <sstream>
+
+#include <G4SystemOfUnits.hh>
+
+#include "isnp/facility/component/ScoringPlanes.hh"
+#include "isnp/facility/component/ScoringPlanesMessenger.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+ScoringPlanes::ScoringPlanes() :
+		messenger(std::make_unique < ScoringPlanesMessenger > (*this)) {
+}
+
+void ScoringPlanes::Add(G4String const& name, G4double const z) {
+
+	auto const it = std::find_if(std::begin(planes), std::end(planes),
+			[&name](Plane const& p) {
+				return p.name == name;
+			});
+
+	if (it == std::end(planes)) {
+		planes.push_back(Plane { name, z });
+	} else {
+		it->z = z;
+	}
+
+}
+
+void ScoringPlanes::Clear() {
+
+	planes.clear();
+
+}
+
+G4String ScoringPlanes::ToString() const {
+
+	std::ostringstream os;
+	os.precision(10);
+	char const* separator = "";
+	for (auto const& p : planes) {
+		os << separator << p.name << ' ' << p.z / mm;
+		separator = " ";
+	}
+	return os.str();
+
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,100 @@
+#include <sstream>
+
+#include "isnp/facility/component/ScoringPlanesMessenger.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+#define DIR "/isnp/facility/component/scoringPlane/"
+
+static std::unique_ptr<G4UIdirectory> MakeDirectory() {
+
+	auto result = std::make_unique < G4UIdirectory > (DIR);
+	result->SetGuidance("Scoring Plane Commands");
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeAdd(
+		ScoringPlanesMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand > (DIR "add", inst);
+	result->SetGuidance(
+			"Add a plane across the beam recording particles crossing it downstream");
+	result->SetGuidance(
+			"  crossings are written into <name>.bin file readable by Resampling gun");
+	result->SetGuidance(
+			"  position is Z coordinate in the beam coordinate system");
+
+	auto const name = new G4UIparameter("name", 's', false);
+	name->SetGuidance("Name of the plane and of its output file");
+	result->SetParameter(name);
+
+	auto const z = new G4UIparameter("z", 'd', false);
+	z->SetGuidance("Position of the plane");
+	result->SetParameter(z);
+
+	auto const unit = new G4UIparameter("unit", 's', true);
+	unit->SetGuidance("Length unit");
+	unit->SetDefaultValue("mm");
+	unit->SetParameterCandidates(G4UIcommand::UnitsList("Length"));
+	result->SetParameter(unit);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithoutParameter> MakeClear(
+		ScoringPlanesMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithoutParameter
+			> (DIR "clear", inst);
+	result->SetGuidance("Remove all the scoring planes");
+
+	return result;
+
+}
+
+ScoringPlanesMessenger::ScoringPlanesMessenger(ScoringPlanes& aComponent) :
+		component(aComponent), directory(MakeDirectory()), addCmd(
+				MakeAdd(this)), clearCmd(MakeClear(this)) {
+}
+
+ScoringPlanesMessenger::~ScoringPlanesMessenger() {
+}
+
+G4String ScoringPlanesMessenger::GetCurrentValue(G4UIcommand* const command) {
+
+	G4String ans;
+
+	if (command == addCmd.get()) {
+		ans = component.ToString();
+	}
+
+	return ans;
+
+}
+
+void ScoringPlanesMessenger::SetNewValue(G4UIcommand* const command,
+		G4String const newValue) {
+
+	if (command == addCmd.get()) {
+		std::istringstream is(newValue);
+		G4String name, unit;
+		G4double z;
+		is >> name >> z >> unit;
+		component.Add(name, z * G4UIcommand::ValueOf(unit));
+	} else if (command == clearCmd.get()) {
+		component.Clear();
+	}
+
+}
+
+}
+
+}
+
+}
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <utility>
+
 #include <G4SystemOfUnits.hh>
 #include <G4NistManager.hh>
 #include <G4Box.hh>
@@ -24,16 +27,20 @@ SpallationTarget::SpallationTarget() :
 		util::Box(200.0 * mm, 50.0 * mm, 400.0 * mm), messenger(
 				std::make_unique < SpallationTargetMessenger > (*this)), coolerInnerRadius(
 				7. * mm), coolerOuterRadius(7.5 * mm), coolerTorusMinRadius(
-				60. * mm), supportMaterial("DUR_AMG3"), hasCooler(true) {
+				60. * mm), supportMaterial("DUR_AMG3"), hasCooler(true), native(
+				false) {
 }
 
 void SpallationTarget::Place(G4LogicalVolume* const destination) {
 
 	using namespace util;
 
+	volumes.clear();
+
 	G4bool const single = false;
 	G4int const numOfCopies = 0;
-	G4bool const checkOverlaps = true;
+	// overlaps are checked by OverlapCache when the geometry is complete
+	G4bool const checkOverlaps = false;
 	G4Transform3D const zeroTransform;
 
 	G4RotationMatrix rotm = G4RotationMatrix();
@@ -44,6 +51,11 @@ void SpallationTarget::Place(G4LogicalVolume* const destination) {
 
 	G4Transform3D const transform = trans * G4RotateZ3D(7. * deg);
 
+	if (native) {
+		PlaceNative(destination, transform);
+		return;
+	}
+
 	auto const nist = G4NistManager::Instance();
 
 	G4VSolid* solidTarget = new G4Box(NameBuilder::Make("spallation", "target"),
@@ -123,6 +135,7 @@ void SpallationTarget::Place(G4LogicalVolume* const destination) {
 			new G4PVPlacement(transform * G4TranslateZ3D(-140. * mm), logic,
 					logic->GetName(), destination, single, numOfCopies,
 					checkOverlaps);
+			volumes.push_back(logic);
 		}
 
 		{
@@ -138,22 +151,10 @@ void SpallationTarget::Place(G4LogicalVolume* const destination) {
 			new G4PVPlacement(transform * G4TranslateZ3D(140. * mm), logic,
 					logic->GetName(), destination, single, numOfCopies,
 					checkOverlaps);
+			volumes.push_back(logic);
 		}
 
-		{
-			// plane
-			auto const solid = new G4Box(
-					NameBuilder::Make(logicTarget->GetName(), "plane"),
-					GetHalfWidth() + 5. * mm, 2.5 * mm,
-					GetHalfLength() + 5. * mm);
-			auto const logic = new G4LogicalVolume(solid, supMaterial,
-					solid->GetName());
-			logic->SetVisAttributes(
-					G4VisAttributes(repository::Colours::Aluminium()));
-			new G4PVPlacement(transform * G4TranslateY3D(-27.5 * mm), logic,
-					logic->GetName(), destination, single, numOfCopies,
-					checkOverlaps);
-		}
+		PlaceSupportPlane(destination, transform, logicTarget->GetName());
 	}
 
 	if (GetHasCooler()) {
@@ -172,6 +173,7 @@ void SpallationTarget::Place(G4LogicalVolume* const destination) {
 					G4VisAttributes(repository::Colours::Water()));
 			new G4PVPlacement(transform, logic, logic->GetName(), destination,
 					single, numOfCopies, checkOverlaps);
+			volumes.push_back(logic);
 		}
 
 		{
@@ -187,11 +189,146 @@ void SpallationTarget::Place(G4LogicalVolume* const destination) {
 					G4VisAttributes(repository::Colours::Copper()));
 			new G4PVPlacement(transform, logic, logic->GetName(), destination,
 					single, numOfCopies, checkOverlaps);
+			volumes.push_back(logic);
 		}
 	}
 
 	new G4PVPlacement(transform, logicTarget, logicTarget->GetName(),
 			destination, single, numOfCopies, checkOverlaps);
+	volumes.push_back(logicTarget);
+
+}
+
+void SpallationTarget::PlaceNative(G4LogicalVolume* const destination,
+		G4Transform3D const& transform) {
+
+	using namespace util;
+
+	G4bool const single = false;
+	G4int const numOfCopies = 0;
+	// overlaps are checked by OverlapCache when the geometry is complete
+	G4bool const checkOverlaps = false;
+
+	auto const nist = G4NistManager::Instance();
+	auto const name = NameBuilder::Make("spallation", "target");
+
+	// The lead is extruded along the local Z axis, which is the Y axis of the target
+	// rotated by 90 deg around X axis, and the local Y axis is the Z axis of the target.
+	// Daughters are placed in the local frame.
+	G4Transform3D const localTransform = G4RotateX3D(90. * deg);
+
+	G4LogicalVolume* logicTarget;
+
+	{
+		// the box without the face cut, the cut crosses the side
+		// at Z = -100 mm and the upstream face at X = 0
+		std::vector<G4TwoVector> polygon;
+		polygon.push_back(G4TwoVector(-GetHalfWidth(), -GetHalfLength()));
+		polygon.push_back(G4TwoVector(-GetHalfWidth(), GetHalfLength()));
+		polygon.push_back(G4TwoVector(GetHalfWidth(), GetHalfLength()));
+		polygon.push_back(G4TwoVector(GetHalfWidth(), -100. * mm));
+		polygon.push_back(G4TwoVector(0. * mm, -GetHalfLength()));
+
+		std::vector<G4ExtrudedSolid::ZSection> zsections;
+		zsections.push_back(
+				G4ExtrudedSolid::ZSection(-GetHalfHeight(), G4TwoVector(),
+						1.0));
+		zsections.push_back(
+				G4ExtrudedSolid::ZSection(GetHalfHeight(), G4TwoVector(), 1.0));
+
+		auto const solid = new G4ExtrudedSolid(name, polygon, zsections);
+		logicTarget = new G4LogicalVolume(solid,
+				nist->FindOrBuildMaterial("G4_Pb"), name);
+		logicTarget->SetVisAttributes(
+				G4VisAttributes(repository::Colours::Lead()));
+	}
+
+	{
+		// screws in the holes of the lead
+		auto const supMaterial = nist->FindOrBuildMaterial(supportMaterial);
+
+		for (auto const& screw : { std::make_pair("screw1", -140. * mm),
+				std::make_pair("screw2", 140. * mm) }) {
+			auto const solid = new G4Tubs(NameBuilder::Make(name, screw.first),
+					0., 5. * mm, GetHalfHeight(), 0.0 * deg, 360.0 * deg);
+			auto const logic = new G4LogicalVolume(solid, supMaterial,
+					solid->GetName());
+			logic->SetVisAttributes(
+					G4VisAttributes(repository::Colours::Aluminium()));
+			new G4PVPlacement(G4TranslateY3D(screw.second), logic,
+					logic->GetName(), logicTarget, single, numOfCopies,
+					checkOverlaps);
+			volumes.push_back(logic);
+		}
+	}
+
+	PlaceSupportPlane(destination, transform, name);
+
+	if (GetHasCooler()) {
+		auto const coolerName = NameBuilder::Make(name, "cooler");
+
+		{
+			// cooler inner volume
+			auto const solid = new G4Torus(
+					NameBuilder::Make(coolerName, "inner"), 0.,
+					coolerInnerRadius, coolerTorusMinRadius, 0. * deg,
+					360. * deg);
+			auto const logic = new G4LogicalVolume(solid,
+					nist->FindOrBuildMaterial("G4_WATER"), solid->GetName());
+			logic->SetVisAttributes(
+					G4VisAttributes(repository::Colours::Water()));
+			new G4PVPlacement(G4Transform3D(), logic, logic->GetName(),
+					logicTarget, single, numOfCopies, checkOverlaps);
+			volumes.push_back(logic);
+		}
+
+		{
+			// cooler tube
+			auto const solid = new G4Torus(
+					NameBuilder::Make(coolerName, "outer"), coolerInnerRadius,
+					coolerOuterRadius, coolerTorusMinRadius, 0. * deg,
+					360. * deg);
+			auto const logic = new G4LogicalVolume(solid,
+					nist->FindOrBuildMaterial("G4_Cu"), solid->GetName());
+			logic->SetVisAttributes(
+					G4VisAttributes(repository::Colours::Copper()));
+			new G4PVPlacement(G4Transform3D(), logic, logic->GetName(),
+					logicTarget, single, numOfCopies, checkOverlaps);
+			volumes.push_back(logic);
+		}
+	}
+
+	new G4PVPlacement(transform * localTransform, logicTarget,
+			logicTarget->GetName(), destination, single, numOfCopies,
+			checkOverlaps);
+	volumes.push_back(logicTarget);
+
+}
+
+void SpallationTarget::PlaceSupportPlane(G4LogicalVolume* const destination,
+		G4Transform3D const& transform, G4String const& targetName) {
+
+	G4bool const single = false;
+	G4int const numOfCopies = 0;
+	// overlaps are checked by OverlapCache when the geometry is complete
+	G4bool const checkOverlaps = false;
+
+	auto const solid = new G4Box(util::NameBuilder::Make(targetName, "plane"),
+			GetHalfWidth() + 5. * mm, 2.5 * mm, GetHalfLength() + 5. * mm);
+	auto const logic = new G4LogicalVolume(solid,
+			G4NistManager::Instance()->FindOrBuildMaterial(supportMaterial),
+			solid->GetName());
+	logic->SetVisAttributes(G4VisAttributes(repository::Colours::Aluminium()));
+	new G4PVPlacement(transform * G4TranslateY3D(-27.5 * mm), logic,
+			logic->GetName(), destination, single, numOfCopies, checkOverlaps);
+	volumes.push_back(logic);
+
+}
+
+G4bool SpallationTarget::Contains(G4LogicalVolume const* const volume) const {
+
+	return std::find(std::begin(volumes), std::end(volumes), volume)
+			!= std::end(volumes);
 
 }
 
@@ -207,6 +344,18 @@ void SpallationTarget::SetHasCooler(G4bool const v) {
 
 }
 
+G4bool SpallationTarget::GetNative() const {
+
+	return native;
+
+}
+
+void SpallationTarget::SetNative(G4bool const v) {
+
+	native = v;
+
+}
+
 G4ThreeVector SpallationTarget::GetRotation() const {
 
 	return rotation;
@@ -31,6 +31,23 @@ static std::unique_ptr<G4UIcmdWithABool> MakeHasCooler(
 
 }
 
+static std::unique_ptr<G4UIcmdWithABool> MakeNative(
+		SpallationTargetMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithABool > (DIR "native", inst);
+	result->SetGuidance(
+			"Build the target of an extruded solid with the holes and the cooler");
+	result->SetGuidance(
+			"  as daughter volumes instead of boolean subtractions (faster navigation).");
+	result->SetGuidance("Choice : true, 1, false, 0");
+	result->SetParameterName("value", true);
+	result->SetDefaultValue("true");
+	result->AvailableForStates(G4State_PreInit);
+
+	return result;
+
+}
+
 static std::unique_ptr<G4UIcmdWith3VectorAndUnit> MakePosition(
 		SpallationTargetMessenger* const inst) {
 
@@ -65,7 +82,7 @@ SpallationTargetMessenger::SpallationTargetMessenger(
 		SpallationTarget& aComponent) :
 		component(aComponent), directory(MakeDirectory()), hasCoolerCmd(
 				MakeHasCooler(this)), rotationCmd(MakeRotation(this)), positionCmd(
-				MakePosition(this)) {
+				MakePosition(this)), nativeCmd(MakeNative(this)) {
 }
 
 SpallationTargetMessenger::~SpallationTargetMessenger() {
@@ -82,6 +99,8 @@ G4String SpallationTargetMessenger::GetCurrentValue(
 		ans = rotationCmd->ConvertToStringWithBestUnit(component.GetRotation());
 	} else if (command == positionCmd.get()) {
 		ans = positionCmd->ConvertToStringWithBestUnit(component.GetPosition());
+	} else if (command == nativeCmd.get()) {
+		ans = component.GetNative() ? "1" : "0";
 	}
 
 	return ans;
@@ -97,6 +116,8 @@ void SpallationTargetMessenger::SetNewValue(G4UIcommand* const command,
 		component.SetRotation(rotationCmd->GetNew3VectorValue(newValue));
 	} else if (command == positionCmd.get()) {
 		component.SetPosition(positionCmd->GetNew3VectorValue(newValue));
+	} else if (command == nativeCmd.get()) {
+		component.SetNative(nativeCmd->GetNewBoolValue(newValue));
 	}
 
 }
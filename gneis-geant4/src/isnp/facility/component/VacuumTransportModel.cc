@@ -0,0 +1,79 @@
+#include <cmath>
+
+#include <G4Neutron.hh>
+
+#include "isnp/facility/component/VacuumTransportModel.hh"
+#include "isnp/util/NeutronCrossSection.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+VacuumTransportModel::VacuumTransportModel(G4Envelope* const envelope) :
+		G4VFastSimulationModel("vacuumTransport", envelope), crossSection(
+				util::NeutronCrossSection::Total) {
+
+}
+
+G4bool VacuumTransportModel::IsApplicable(
+		G4ParticleDefinition const& particle) {
+
+	return &particle == G4Neutron::Definition();
+
+}
+
+G4bool VacuumTransportModel::ModelTrigger(G4FastTrack const& fastTrack) {
+
+	auto const solid = fastTrack.GetEnvelopeSolid();
+	auto const position = fastTrack.GetPrimaryTrackLocalPosition();
+
+	// a neutron entering the envelope sits on its surface and is moved as well,
+	// a neutron moved to the exit surface is left to the navigator
+	return solid->Inside(position) != kOutside
+			&& solid->DistanceToOut(position,
+					fastTrack.GetPrimaryTrackLocalDirection()) > 0;
+
+}
+
+void VacuumTransportModel::DoIt(G4FastTrack const& fastTrack,
+		G4FastStep& fastStep) {
+
+	auto const track = fastTrack.GetPrimaryTrack();
+	auto const position = fastTrack.GetPrimaryTrackLocalPosition();
+	auto const direction = fastTrack.GetPrimaryTrackLocalDirection();
+	auto const distance = fastTrack.GetEnvelopeSolid()->DistanceToOut(position,
+			direction);
+
+	// the neutron is in flight, so its velocity is not zero
+	auto const time = distance / track->GetVelocity();
+	auto const properTime = time * track->GetDynamicParticle()->GetMass()
+			/ track->GetTotalEnergy();
+
+	fastStep.ProposePrimaryTrackFinalPosition(position + distance * direction);
+	fastStep.ProposePrimaryTrackFinalTime(track->GetGlobalTime() + time);
+	fastStep.ProposePrimaryTrackFinalProperTime(
+			track->GetProperTime() + properTime);
+	fastStep.ProposePrimaryTrackPathLength(distance);
+
+	auto const sigma = crossSection(fastTrack.GetEnvelopeMaterial(),
+			track->GetKineticEnergy());
+	if (sigma > 0) {
+		fastStep.ProposePrimaryTrackFinalEventBiasingWeight(
+				track->GetWeight() * std::exp(-sigma * distance));
+	}
+
+}
+
+void VacuumTransportModel::SetCrossSection(CrossSection const& aCrossSection) {
+
+	crossSection = aCrossSection;
+
+}
+
+}
+
+}
+
+}
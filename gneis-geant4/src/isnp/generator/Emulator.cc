@@ -0,0 +1,175 @@
+#include <fstream>
+
+#include <G4SystemOfUnits.hh>
+
+#include "isnp/generator/Emulator.hh"
+#include "isnp/generator/EmulatorMessenger.hh"
+#include "isnp/generator/EmulatorTable.hh"
+#include "isnp/generator/SampleRegistry.hh"
+#include "isnp/util/DataFrameFormat.hh"
+#include "isnp/util/DataFrameLoader.hh"
+#include "isnp/util/DataFrameMapper.hh"
+#include "isnp/util/Convert.hh"
+
+namespace isnp {
+
+namespace generator {
+
+Emulator::Emulator() :
+		messenger(std::make_unique < EmulatorMessenger > (*this)), particleGun(
+				std::make_unique<G4ParticleGun>()), tableFileName(""), verboseLevel(
+				1), energyBins(100), angleBins(50), azimuthBins(36), positionBins(
+				20), counter(0), beamTransformDetected(false) {
+
+}
+
+Emulator::~Emulator() {
+
+}
+
+void Emulator::GeneratePrimaries(G4Event* const anEvent) {
+
+	if (!beamTransformDetected) {
+		beamTransform = DetectBeamTransform();
+		beamTransformDetected = true;
+	}
+
+	PrepareTable();
+
+	auto const primary = table->Shoot();
+	auto position = primary.position;
+	position.transform(beamTransform.getRotation());
+	position += beamTransform.getTranslation();
+	auto direction = primary.direction;
+	direction.transform(beamTransform.getRotation());
+
+	particleGun->SetParticleDefinition(primary.particle);
+	particleGun->SetParticleEnergy(primary.energy);
+	particleGun->SetParticlePosition(position);
+	particleGun->SetParticleMomentumDirection(direction);
+	particleGun->GeneratePrimaryVertex(anEvent);
+
+	++counter;
+
+	if (verboseLevel > 1) {
+		G4cout << "Emulator: generating #" << counter << " particle" << G4endl;
+
+		if (verboseLevel > 2) {
+			G4cout << "Emulator: energy=" << primary.energy / MeV
+					<< " MeV, position=" << position / mm
+					<< " mm, direction=" << direction << G4endl;
+		}
+	}
+
+}
+
+void Emulator::SetTableFileName(G4String const& aFileName) {
+
+	tableFileName = aFileName;
+	table.reset();
+
+}
+
+void Emulator::SetBins(size_type const anEnergyBins,
+		size_type const anAngleBins, size_type const anAzimuthBins,
+		size_type const aPositionBins) {
+
+	energyBins = anEnergyBins;
+	angleBins = anAngleBins;
+	azimuthBins = anAzimuthBins;
+	positionBins = aPositionBins;
+
+}
+
+void Emulator::BuildTable(G4String const& sampleFileName,
+		G4String const& aTableFileName) const {
+
+	auto const sample = ReadSampleFile(sampleFileName);
+
+	std::ofstream os(aTableFileName, std::ios::binary);
+	if (!os) {
+		throw NoFileException();
+	}
+
+	auto const numOfBins = EmulatorTable::Build(sample, EmulatorTable::Binning {
+			energyBins, angleBins, azimuthBins, positionBins }, os);
+
+	if (verboseLevel > 0) {
+		G4cout << "Emulator: " << sample.Size() << " records from file "
+				<< sampleFileName << " are accumulated into " << numOfBins
+				<< " bins of file " << aTableFileName << "\n";
+	}
+
+}
+
+void Emulator::PrepareTable() {
+
+	if (table) {
+		return;
+	}
+
+	if (tableFileName.isNull()
+			|| !util::DataFrameFormat::IsBinary(tableFileName)) {
+		throw NoFileException();
+	}
+
+	// table is loaded once and shared by the guns of all threads
+	auto const loader = [this] {
+
+		util::DataFrameMapper mapper(EmulatorTable::FloatColumns(),
+				EmulatorTable::CategoryColumns());
+		auto const result = std::make_shared < EmulatorTable const
+				> (std::make_shared < util::DataFrame const
+						> (mapper.map(tableFileName)));
+
+		if (verboseLevel > 0) {
+			G4cout << "Emulator: " << result->Size()
+					<< " bins is loaded from file " << tableFileName
+					<< ", total weight " << result->GetTotalWeight() << "\n";
+		}
+
+		return result;
+
+	};
+
+	table = SampleRegistry::GetInstance().GetTable(tableFileName, loader);
+
+}
+
+util::DataFrame Emulator::ReadSampleFile(
+		G4String const& sampleFileName) const {
+
+	std::set<G4String> const floatColumns { "KineticEnergy", "DirectionX",
+			"DirectionY", "DirectionZ", "PositionX", "PositionY", "PositionZ" };
+	std::set<G4String> const categoryColumns { "Type" };
+	std::set<G4String> const optionalFloatColumns { "Weight" };
+
+	if (util::DataFrameFormat::IsBinary(sampleFileName)) {
+		util::DataFrameMapper mapper(floatColumns, categoryColumns,
+				optionalFloatColumns);
+		return mapper.map(sampleFileName);
+	}
+
+	util::DataFrameLoader loader(floatColumns, categoryColumns,
+			optionalFloatColumns);
+	try {
+		return loader.load(sampleFileName);
+	} catch (util::DataFrameLoader::FileException const&) {
+		throw NoFileException();
+	}
+
+}
+
+G4Transform3D Emulator::DetectBeamTransform() const {
+
+	return util::Convert::VectorsToTransform(
+			util::Convert::CommandToVector(
+					"/isnp/facility/component/beamPointer/rotation"),
+			util::Convert::CommandToVector(
+					"/isnp/facility/component/beamPointer/position"));
+
+}
+
+}
+
+}
@@ -0,0 +1,168 @@
+#include <sstream>
+
+#include "isnp/generator/EmulatorMessenger.hh"
+#include "isnp/generator/EmulatorTable.hh"
+#include "isnp/util/DataFrameLoader.hh"
+#include "isnp/util/MappedFile.hh"
+
+namespace isnp {
+
+namespace generator {
+
+#define DIR "/isnp/gun/emulator/"
+
+static std::unique_ptr<G4UIdirectory> MakeDirectory() {
+
+	auto result = std::make_unique < G4UIdirectory > (DIR);
+	result->SetGuidance("ISNP Emulator Gun Commands");
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithAnInteger> MakeVerbose(
+		EmulatorMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAnInteger
+			> (DIR "verbose", inst);
+	result->SetGuidance("Set the Verbose level of ISNP Emulator gun.");
+	result->SetGuidance(" 0 : Silent (default)");
+	result->SetGuidance(" 1 : Display warning messages");
+	result->SetGuidance(" 2 : Display more");
+	result->SetParameterName("level", true);
+	result->SetDefaultValue(0);
+	result->SetRange("level >=0 && level <=3");
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithAString> MakeFile(
+		EmulatorMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAString > (DIR "file", inst);
+	result->SetGuidance("Set a source table file name");
+	result->SetParameterName("file", true);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeBuild(EmulatorMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand > (DIR "build", inst);
+	result->SetGuidance(
+			"Accumulate a sample recorded in a spallation run into a source table");
+
+	auto const sample = new G4UIparameter("sample", 's', false);
+	sample->SetGuidance("Sample file name (text or binary)");
+	result->SetParameter(sample);
+
+	auto const table = new G4UIparameter("table", 's', false);
+	table->SetGuidance("Table file name");
+	result->SetParameter(table);
+
+	// the table is written once by the master thread
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeBins(EmulatorMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand > (DIR "bins", inst);
+	result->SetGuidance("Set numbers of bins of the tables being built");
+
+	auto const energy = new G4UIparameter("energy", 'i', false);
+	energy->SetGuidance("Number of (logarithmic) kinetic energy bins");
+	energy->SetParameterRange("energy > 0");
+	result->SetParameter(energy);
+
+	auto const angle = new G4UIparameter("angle", 'i', false);
+	angle->SetGuidance("Number of bins of the angle between the direction and the beam");
+	angle->SetParameterRange("angle > 0");
+	result->SetParameter(angle);
+
+	auto const azimuth = new G4UIparameter("azimuth", 'i', false);
+	azimuth->SetGuidance("Number of bins of the direction azimuth");
+	azimuth->SetParameterRange("azimuth > 0");
+	result->SetParameter(azimuth);
+
+	auto const position = new G4UIparameter("position", 'i', false);
+	position->SetGuidance("Number of bins of X and Y positions each");
+	position->SetParameterRange("position > 0");
+	result->SetParameter(position);
+
+	return result;
+
+}
+
+EmulatorMessenger::EmulatorMessenger(Emulator& aGenerator) :
+		generator(aGenerator), directory(MakeDirectory()), verboseCmd(
+				MakeVerbose(this)), fileCmd(MakeFile(this)), buildCmd(
+				MakeBuild(this)), binsCmd(MakeBins(this)) {
+
+}
+
+EmulatorMessenger::~EmulatorMessenger() {
+
+}
+
+G4String EmulatorMessenger::GetCurrentValue(G4UIcommand* const command) {
+
+	G4String ans;
+
+	if (command == verboseCmd.get()) {
+		ans = verboseCmd->ConvertToString(generator.GetVerboseLevel());
+	} else if (command == fileCmd.get()) {
+		ans = generator.GetTableFileName();
+	} else if (command == binsCmd.get()) {
+		std::ostringstream os;
+		os << generator.GetEnergyBins() << ' ' << generator.GetAngleBins()
+				<< ' ' << generator.GetAzimuthBins() << ' '
+				<< generator.GetPositionBins();
+		ans = os.str();
+	}
+
+	return ans;
+
+}
+
+void EmulatorMessenger::SetNewValue(G4UIcommand* const command,
+		G4String const newValue) {
+
+	if (command == verboseCmd.get()) {
+		generator.SetVerboseLevel(verboseCmd->GetNewIntValue(newValue));
+	} else if (command == fileCmd.get()) {
+		generator.SetTableFileName(newValue);
+	} else if (command == buildCmd.get()) {
+		std::istringstream is(newValue);
+		G4String sample, table;
+		is >> sample >> table;
+		try {
+			generator.BuildTable(sample, table);
+		} catch (Emulator::NoFileException const&) {
+			G4cerr << "Emulator: cannot build " << table << " from " << sample
+					<< ": cannot open a file" << G4endl;
+		} catch (util::MappedFile::OpenException const&) {
+			G4cerr << "Emulator: cannot build " << table << " from " << sample
+					<< ": cannot open a file" << G4endl;
+		} catch (EmulatorTable::EmptySampleException const&) {
+			G4cerr << "Emulator: cannot build " << table << " from " << sample
+					<< ": the sample is empty" << G4endl;
+		} catch (util::DataFrameLoader::LoaderException const&) {
+			G4cerr << "Emulator: cannot build " << table << " from " << sample
+					<< ": invalid data" << G4endl;
+		}
+	} else if (command == binsCmd.get()) {
+		std::istringstream is(newValue);
+		Emulator::size_type energy, angle, azimuth, position;
+		is >> energy >> angle >> azimuth >> position;
+		generator.SetBins(energy, angle, azimuth, position);
+	}
+
+}
+
+}
+
+}
@@ -0,0 +1,20 @@
+#include "isnp/generator/EmulatorRunAction.hh"
+
+namespace isnp {
+
+namespace generator {
+
+EmulatorRunAction::EmulatorRunAction(Emulator& aGenerator) :
+		generator(aGenerator) {
+
+}
+
+void EmulatorRunAction::BeginOfRunAction(G4Run const*) {
+
+	generator.PrepareTable();
+
+}
+
+}
+
+}
@@ -0,0 +1,320 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <G4ParticleTable.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+#include <Randomize.hh>
+
+#include "isnp/generator/EmulatorTable.hh"
+#include "isnp/util/DataFrameWriter.hh"
+
+namespace isnp {
+
+namespace generator {
+
+// columns of a sample
+static G4String const TYPE = "Type";
+static G4String const KINETIC_ENERGY = "KineticEnergy";
+static G4String const DIRECTION_X = "DirectionX";
+static G4String const DIRECTION_Y = "DirectionY";
+static G4String const DIRECTION_Z = "DirectionZ";
+static G4String const POSITION_X = "PositionX";
+static G4String const POSITION_Y = "PositionY";
+static G4String const POSITION_Z = "PositionZ";
+static G4String const WEIGHT = "Weight";
+
+// columns of a table, besides the type and the weight
+static G4String const ENERGY = "Energy";
+static G4String const COS_THETA = "CosTheta";
+static G4String const PHI = "Phi";
+static G4String const X = "X";
+static G4String const Y = "Y";
+static G4String const MIN = "Min";
+static G4String const MAX = "Max";
+
+// number of significant digits of the bin edges and weights
+static unsigned const PRECISION = 7;
+
+namespace {
+
+/**
+ * Equal bins of a value range, possibly of the logarithm of the value.
+ */
+class Axis {
+public:
+
+	Axis(std::size_t const aNumOfBins, G4double const aMin, G4double const aMax,
+			bool const aLog) :
+			numOfBins(std::max<std::size_t>(aNumOfBins, 1)), log(
+					aLog && aMin > 0), low(log ? std::log(aMin) : aMin), high(
+					log ? std::log(aMax) : aMax) {
+
+	}
+
+	std::size_t GetNumOfBins() const {
+
+		return numOfBins;
+
+	}
+
+	std::size_t BinOf(G4double const value) const {
+
+		if (!(high > low)) {
+			return 0;
+		}
+
+		auto const v = log ?
+				(value > 0 ? std::log(value) : low) : value;
+		auto const bin = static_cast<std::ptrdiff_t>((v - low) / (high - low)
+				* numOfBins);
+		return static_cast<std::size_t>(std::max<std::ptrdiff_t>(0,
+				std::min<std::ptrdiff_t>(bin, numOfBins - 1)));
+
+	}
+
+	G4double Edge(std::size_t const bin) const {
+
+		auto const v = low + (high - low) * bin / numOfBins;
+		return log ? std::exp(v) : v;
+
+	}
+
+private:
+
+	std::size_t numOfBins;
+	bool log;
+	G4double low, high;
+
+};
+
+struct Limits {
+
+	G4double min = std::numeric_limits<G4double>::infinity();
+	G4double max = -std::numeric_limits<G4double>::infinity();
+
+	void Add(G4double const v) {
+
+		min = std::min(min, v);
+		max = std::max(max, v);
+
+	}
+
+};
+
+}
+
+EmulatorTable::EmulatorTable(std::shared_ptr<util::DataFrame const> const aTable) :
+		table(aTable), size(aTable->Size()), types(
+				aTable->CategoryColumn(TYPE).data()), energy(MakeRange(ENERGY)), cosTheta(
+				MakeRange(COS_THETA)), phi(MakeRange(PHI)), x(MakeRange(X)), y(
+				MakeRange(Y)) {
+
+	auto const particleTable = G4ParticleTable::GetParticleTable();
+	for (std::size_t id = 0; id < particles.size(); id++) {
+		auto const& name = table->CategoryName(TYPE,
+				static_cast<util::DataFrame::CategoryId>(id));
+		particles[id] = name.isNull() ? nullptr : particleTable->FindParticle(name);
+	}
+
+	if (size == 0) {
+		throw EmptySampleException();
+	}
+
+	aliasTable = std::make_unique < util::AliasTable const
+			> (table->FloatColumn(WEIGHT).data(), size);
+
+}
+
+EmulatorTable::Primary EmulatorTable::Shoot() const {
+
+	auto const bin = aliasTable->Shoot();
+
+	G4double const eMin = energy.min[bin], eMax = energy.max[bin];
+	auto const e =
+			eMin > 0 && eMax > eMin ?
+					eMin * std::pow(eMax / eMin, G4UniformRand()) :
+					CLHEP::RandFlat::shoot(eMin, eMax);
+
+	auto const cosT = CLHEP::RandFlat::shoot(cosTheta.min[bin],
+			cosTheta.max[bin]);
+	auto const sinT = std::sqrt(std::max(0.0, 1.0 - cosT * cosT));
+	auto const p = CLHEP::RandFlat::shoot(phi.min[bin], phi.max[bin]);
+
+	return Primary { particles[types[bin]], e * MeV, G4ThreeVector(
+			sinT * std::cos(p), sinT * std::sin(p), cosT), G4ThreeVector(
+			CLHEP::RandFlat::shoot(x.min[bin], x.max[bin]),
+			CLHEP::RandFlat::shoot(y.min[bin], y.max[bin]), 0.0) * mm };
+
+}
+
+std::set<G4String> EmulatorTable::FloatColumns() {
+
+	std::set<G4String> result;
+	for (auto const& name : { ENERGY, COS_THETA, PHI, X, Y }) {
+		result.insert(name + MIN);
+		result.insert(name + MAX);
+	}
+	result.insert(WEIGHT);
+	return result;
+
+}
+
+std::set<G4String> EmulatorTable::CategoryColumns() {
+
+	std::set<G4String> result;
+	result.insert(TYPE);
+	return result;
+
+}
+
+EmulatorTable::size_type EmulatorTable::Build(util::DataFrame const& sample,
+		Binning const& binning, std::ostream& os) {
+
+	auto const n = sample.Size();
+	auto const types = sample.CategoryColumn(TYPE).data();
+	auto const energies = sample.FloatColumn(KINETIC_ENERGY).data();
+	auto const dx = sample.FloatColumn(DIRECTION_X).data();
+	auto const dy = sample.FloatColumn(DIRECTION_Y).data();
+	auto const dz = sample.FloatColumn(DIRECTION_Z).data();
+	auto const px = sample.FloatColumn(POSITION_X).data();
+	auto const py = sample.FloatColumn(POSITION_Y).data();
+	auto const pz = sample.FloatColumn(POSITION_Z).data();
+	auto const weights =
+			sample.HasFloatColumn(WEIGHT) ?
+					sample.FloatColumn(WEIGHT).data() : nullptr;
+
+	auto const isForward = [dz](size_type const i) {
+		return dz[i] > 0;
+	};
+
+	// projected positions and the ranges of all the quantities
+	std::vector<G4float> xs(n), ys(n);
+	Limits positiveEnergy, anyEnergy, cosT, xLimits, yLimits;
+	for (size_type i = 0; i < n; i++) {
+		if (!isForward(i)) {
+			continue;
+		}
+		xs[i] = px[i] - pz[i] * dx[i] / dz[i];
+		ys[i] = py[i] - pz[i] * dy[i] / dz[i];
+
+		if (energies[i] > 0) {
+			positiveEnergy.Add(energies[i]);
+		}
+		anyEnergy.Add(energies[i]);
+		cosT.Add(dz[i]);
+		xLimits.Add(xs[i]);
+		yLimits.Add(ys[i]);
+	}
+
+	if (!(anyEnergy.max >= anyEnergy.min)) {
+		throw EmptySampleException();
+	}
+
+	auto const logEnergy = positiveEnergy.max >= positiveEnergy.min;
+	Axis const eAxis(binning.energy,
+			logEnergy ? positiveEnergy.min : anyEnergy.min,
+			logEnergy ? positiveEnergy.max : anyEnergy.max, logEnergy);
+	Axis const cAxis(binning.angle, cosT.min, std::min(cosT.max, 1.0), false);
+	Axis const pAxis(binning.azimuth, -pi, pi, false);
+	Axis const xAxis(binning.position, xLimits.min, xLimits.max, false);
+	Axis const yAxis(binning.position, yLimits.min, yLimits.max, false);
+
+	// joint bin number, the type being the most significant
+	auto const binOf =
+			[&](size_type const i) {
+				uint64_t result = types[i];
+				result = result * eAxis.GetNumOfBins() + eAxis.BinOf(energies[i]);
+				result = result * cAxis.GetNumOfBins() + cAxis.BinOf(dz[i]);
+				result = result * pAxis.GetNumOfBins()
+				+ pAxis.BinOf(std::atan2(dy[i], dx[i]));
+				result = result * xAxis.GetNumOfBins() + xAxis.BinOf(xs[i]);
+				return result * yAxis.GetNumOfBins() + yAxis.BinOf(ys[i]);
+			};
+
+	std::unordered_map<uint64_t, G4double> bins;
+	for (size_type i = 0; i < n; i++) {
+		if (isForward(i)) {
+			bins[binOf(i)] += weights ? weights[i] : 1.0;
+		}
+	}
+
+	// bins are written in order, so the table does not depend on hashing
+	std::map<uint64_t, G4double> const sorted(std::begin(bins), std::end(bins));
+
+	std::vector<util::DataFrame::CategoryId> tableTypes;
+	std::map<G4String, std::vector<G4float>> columns;
+	for (auto const& name : FloatColumns()) {
+		columns[name].reserve(sorted.size());
+	}
+
+	auto const addBin = [&columns](G4String const& name, Axis const& axis,
+			std::size_t const bin) {
+		columns[name + MIN].push_back(axis.Edge(bin));
+		columns[name + MAX].push_back(axis.Edge(bin + 1));
+	};
+
+	for (auto const& b : sorted) {
+		if (!(b.second > 0)) {
+			continue;
+		}
+
+		auto key = b.first;
+		auto const yBin = key % yAxis.GetNumOfBins();
+		key /= yAxis.GetNumOfBins();
+		auto const xBin = key % xAxis.GetNumOfBins();
+		key /= xAxis.GetNumOfBins();
+		auto const pBin = key % pAxis.GetNumOfBins();
+		key /= pAxis.GetNumOfBins();
+		auto const cBin = key % cAxis.GetNumOfBins();
+		key /= cAxis.GetNumOfBins();
+		auto const eBin = key % eAxis.GetNumOfBins();
+		key /= eAxis.GetNumOfBins();
+
+		tableTypes.push_back(static_cast<util::DataFrame::CategoryId>(key));
+		addBin(ENERGY, eAxis, eBin);
+		addBin(COS_THETA, cAxis, cBin);
+		addBin(PHI, pAxis, pBin);
+		addBin(X, xAxis, xBin);
+		addBin(Y, yAxis, yBin);
+		columns[WEIGHT].push_back(b.second);
+	}
+
+	if (tableTypes.empty()) {
+		throw EmptySampleException();
+	}
+
+	util::DataFrameWriter::CategoryNames typeNames;
+	for (std::size_t id = 0; id < util::DataFrameFormat::MaxCategories; id++) {
+		auto const& name = sample.CategoryName(TYPE,
+				static_cast<util::DataFrame::CategoryId>(id));
+		if (!name.isNull()) {
+			typeNames[static_cast<util::DataFrame::CategoryId>(id)] = name;
+		}
+	}
+
+	util::DataFrameWriter writer(os);
+	writer.AddCategoryColumn(TYPE, typeNames, tableTypes.data());
+	for (auto const& c : columns) {
+		writer.AddFloatColumn(c.first, PRECISION, c.second.data());
+	}
+	writer.Write(tableTypes.size());
+
+	return tableTypes.size();
+
+}
+
+EmulatorTable::Range EmulatorTable::MakeRange(G4String const& name) const {
+
+	return Range { table->FloatColumn(name + MIN).data(), table->FloatColumn(
+			name + MAX).data() };
+
+}
+
+}
+
+}
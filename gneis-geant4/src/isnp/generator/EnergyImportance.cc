@@ -0,0 +1,46 @@
+#include <iterator>
+#include <sstream>
+
+#include <G4SystemOfUnits.hh>
+
+#include "isnp/generator/EnergyImportance.hh"
+
+namespace isnp {
+
+namespace generator {
+
+void EnergyImportance::Add(G4double const energy, G4double const importance) {
+
+	points[energy] = importance;
+
+}
+
+void EnergyImportance::Clear() {
+
+	points.clear();
+
+}
+
+G4double EnergyImportance::operator()(G4double const energy) const {
+
+	auto const it = points.upper_bound(energy);
+	return it == std::begin(points) ? 1.0 : std::prev(it)->second;
+
+}
+
+G4String EnergyImportance::ToString() const {
+
+	std::ostringstream os;
+	os.precision(10);
+	char const* separator = "";
+	for (auto const& p : points) {
+		os << separator << p.first / MeV << ' ' << p.second;
+		separator = " ";
+	}
+	return os.str();
+
+}
+
+}
+
+}
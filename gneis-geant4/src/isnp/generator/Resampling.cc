@@ -1,15 +1,24 @@
+#include <algorithm>
 #include <fstream>
 
 #include <G4SystemOfUnits.hh>
-#include <G4ParticleTable.hh>
-#include <G4ParticleDefinition.hh>
 #include <Randomize.hh>
+#include <G4Threading.hh>
 
 #include "isnp/generator/Resampling.hh"
 #include "isnp/generator/ResamplingMessenger.hh"
-#include "isnp/util/RandomNumberGenerator.hh"
+#include "isnp/generator/ResamplingSampler.hh"
+#include "isnp/generator/SampleRegistry.hh"
+#include "isnp/generator/SampleStream.hh"
+#include "isnp/generator/EnergyImportance.hh"
+#include "isnp/util/DataFrameBlockReader.hh"
 #include "isnp/util/DataFrameLoader.hh"
+#include "isnp/util/DataFrameMapper.hh"
+#include "isnp/util/DataFrameWriter.hh"
+#include "isnp/util/DataFrameFormat.hh"
 #include "isnp/util/Convert.hh"
+#include "isnp/util/ApertureChain.hh"
+#include "isnp/facility/component/BeamPointer.hh"
 
 namespace isnp {
 
@@ -20,9 +29,12 @@ Resampling::Resampling() :
 				MakeGun()), sampleFileName(""), energyColumn("KineticEnergy"), directionXColumn(
 				"DirectionX"), directionYColumn("DirectionY"), directionZColumn(
 				"DirectionZ"), positionXColumn("PositionX"), positionYColumn(
-				"PositionY"), positionZColumn("PositionZ"), typeColumn("Type"), sampleFileLoaded(
-				false), counter(0), verboseLevel(1), beamTransformDetected(
-				false) {
+				"PositionY"), positionZColumn("PositionZ"), typeColumn("Type"), weightColumn(
+				"Weight"), sampleFileLoaded(
+				false), counter(0), verboseLevel(1), mode(Mode::Memory), blockSize(
+				1000000), shuffleBlocks(true), beamTransformDetected(false), energyImportance(
+				std::make_unique<EnergyImportance>()), acceptance(false), projectPositions(
+				true) {
 
 }
 
@@ -37,35 +49,27 @@ void Resampling::GeneratePrimaries(G4Event* const anEvent) {
 		beamTransformDetected = true;
 	}
 
-	if (!sampleFileLoaded) {
-		LoadSampleFile();
-	}
+	PrepareSample();
+	auto const& sample = NextSample();
 
 	// set particle properties
-	auto const particleTable = G4ParticleTable::GetParticleTable();
-	auto const dataSize = dataFrame->Size();
-
-	auto const energyRowNo = CLHEP::RandFlat::shootInt(dataSize);
-	particleGun->SetParticleDefinition(
-			particleTable->FindParticle(
-					dataFrame->CategoryValue(typeColumn, energyRowNo)));
-	particleGun->SetParticleEnergy(
-			ShootNumber(energyColumn, energyRowNo) * MeV);
+	auto const energyRowNo = sample.ShootEnergyRow();
+	auto const energyWeight = sample.EnergyRowWeight(energyRowNo);
+	particleGun->SetParticleDefinition(sample.Particle(energyRowNo));
+	particleGun->SetParticleEnergy(sample.ShootEnergy(energyRowNo) * MeV);
 	particleGun->SetParticlePosition(
-			CalculatePosition(
-					ShootVector(directionXColumn, directionYColumn,
-							directionZColumn, energyRowNo),
-					ShootVector(positionXColumn, positionYColumn,
-							positionZColumn, energyRowNo) * mm));
+			CalculatePosition(sample.ShootDirection(energyRowNo),
+					sample.ShootPosition(energyRowNo) * mm));
 
-	auto const directionRowNo = CLHEP::RandFlat::shootInt(dataSize);
+	auto const directionRowNo = sample.ShootDirectionRow();
+	auto const weight = energyWeight * sample.GetDirectionRowWeight();
 	particleGun->SetParticleMomentumDirection(
-			CalculateDirection(
-					ShootVector(directionXColumn, directionYColumn,
-							directionZColumn, directionRowNo)));
+			CalculateDirection(sample.ShootDirection(directionRowNo)));
 
 	// generate particle
 	particleGun->GeneratePrimaryVertex(anEvent);
+	anEvent->GetPrimaryVertex(anEvent->GetNumberOfPrimaryVertex() - 1)->SetWeight(
+			weight);
 
 	++counter;
 
@@ -79,7 +83,8 @@ void Resampling::GeneratePrimaries(G4Event* const anEvent) {
 					<< " MeV, position="
 					<< particleGun->GetParticlePosition() / mm
 					<< " mm, direction row=" << directionRowNo << ", direction="
-					<< particleGun->GetParticleMomentumDirection() << G4endl;
+					<< particleGun->GetParticleMomentumDirection() << ", weight="
+					<< weight << G4endl;
 		}
 	}
 
@@ -92,6 +97,62 @@ void Resampling::SetSampleFileName(const G4String& fn) {
 
 }
 
+void Resampling::SetMode(Mode const aMode) {
+
+	mode = aMode;
+	sampleFileLoaded = false;
+
+}
+
+void Resampling::SetBlockSize(util::DataFrame::size_type const aBlockSize) {
+
+	blockSize = aBlockSize;
+	sampleFileLoaded = false;
+
+}
+
+void Resampling::SetShuffleBlocks(G4bool const aShuffleBlocks) {
+
+	shuffleBlocks = aShuffleBlocks;
+	sampleFileLoaded = false;
+
+}
+
+void Resampling::AddEnergyImportance(G4double const energy,
+		G4double const importance) {
+
+	energyImportance->Add(energy, importance);
+	sampleFileLoaded = false;
+
+}
+
+void Resampling::ClearEnergyImportance() {
+
+	energyImportance->Clear();
+	sampleFileLoaded = false;
+
+}
+
+void Resampling::SetAcceptance(G4bool const anAcceptance) {
+
+	acceptance = anAcceptance;
+	sampleFileLoaded = false;
+
+}
+
+void Resampling::SetProjectPositions(G4bool const aProjectPositions) {
+
+	projectPositions = aProjectPositions;
+	sampleFileLoaded = false;
+
+}
+
+G4String Resampling::GetEnergyImportance() const {
+
+	return energyImportance->ToString();
+
+}
+
 std::unique_ptr<G4ParticleGun> Resampling::MakeGun() {
 
 	return std::make_unique<G4ParticleGun>();
@@ -101,12 +162,16 @@ std::unique_ptr<G4ParticleGun> Resampling::MakeGun() {
 G4ThreeVector Resampling::CalculatePosition(const G4ThreeVector& direction,
 		const G4ThreeVector& targetPos) {
 
-	auto result = G4ThreeVector(
-			targetPos.getX()
-					- targetPos.getZ() * direction.getX() / direction.getZ(),
-			targetPos.getY()
-					- targetPos.getZ() * direction.getY() / direction.getZ(),
-			0.0);
+	auto result =
+			projectPositions ?
+					G4ThreeVector(
+							targetPos.getX()
+									- targetPos.getZ() * direction.getX()
+											/ direction.getZ(),
+							targetPos.getY()
+									- targetPos.getZ() * direction.getY()
+											/ direction.getZ(), 0.0) :
+					targetPos;
 
 	result.transform(beamTransform.getRotation());
 	result += beamTransform.getTranslation();
@@ -124,72 +189,246 @@ G4ThreeVector Resampling::CalculateDirection(G4ThreeVector dir) {
 
 void Resampling::Load(std::istream& f) {
 
-	std::set<G4String> numericColumns, categoryColumns;
-	numericColumns.insert(energyColumn);
-	numericColumns.insert(directionXColumn);
-	numericColumns.insert(directionYColumn);
-	numericColumns.insert(directionZColumn);
-	numericColumns.insert(positionXColumn);
-	numericColumns.insert(positionYColumn);
-	numericColumns.insert(positionZColumn);
-	categoryColumns.insert(typeColumn);
-	util::DataFrameLoader loader(numericColumns, categoryColumns);
+	util::DataFrameLoader loader(FloatColumns(), CategoryColumns(),
+			OptionalFloatColumns());
+	SetSampler(MakeSampler(loader.load(f)));
 
-	dataFrame = std::make_unique < util::DataFrame > (loader.load(f));
+}
 
-	if (verboseLevel > 0) {
-		G4cout << "Resampling: " << dataFrame->Size()
-				<< " records is loaded from file " << sampleFileName << "\n";
+void Resampling::PrepareSample() {
+
+	if (!sampleFileLoaded) {
+		stream.reset();
+		blockReader.reset();
+		blockWeights.reset();
+		sampler.reset();
+
+		if (mode == Mode::Stream) {
+			OpenSampleStream();
+		} else {
+			LoadSampleFile();
+		}
 	}
 
-	if (dataFrame->Size() == 0) {
-		throw EmptySampleException();
+}
+
+void Resampling::ConvertSampleFile(G4String const& textFileName,
+		G4String const& binaryFileName) const {
+
+	std::ifstream is(textFileName);
+	if (!is) {
+		throw NoFileException();
 	}
 
-	sampleFileLoaded = true;
+	util::DataFrameLoader loader(FloatColumns(), CategoryColumns(),
+			OptionalFloatColumns());
+	auto const df = loader.load(is);
 
-}
+	std::ofstream os(binaryFileName, std::ios::binary);
+	if (!os) {
+		throw NoFileException();
+	}
 
-void Resampling::LoadSampleFile() {
+	util::DataFrameWriter::Write(df, os);
 
 	if (verboseLevel > 0) {
-		G4cout << "Resampling: loading sample from file " << sampleFileName
+		G4cout << "Resampling: " << df.Size() << " records from file "
+				<< textFileName << " is written to file " << binaryFileName
 				<< "\n";
 	}
 
+}
+
+void Resampling::LoadSampleFile() {
+
 	if (sampleFileName.isNull()) {
 		throw NoFileException();
 	}
 
-	std::ifstream f(sampleFileName);
-	if (!f) {
+	// sample is loaded once and shared by the guns of all threads
+	auto const loader = [this] {
+
+		if (verboseLevel > 0) {
+			G4cout << "Resampling: loading sample from file "
+					<< sampleFileName << "\n";
+		}
+
+		auto result = MakeSampler(ReadSampleFile());
+
+		if (verboseLevel > 0) {
+			G4cout << "Resampling: " << result->Size()
+					<< " records is loaded from file " << sampleFileName
+					<< (result->GetDataFrame().IsMapped() ? " (mapped)" : "") << "\n";
+			if (result->IsWeighted()) {
+				G4cout << "Resampling: total weight of the records is "
+						<< result->GetTotalWeight() << "\n";
+			}
+			if (acceptance && projectPositions) {
+				G4cout << "Resampling: " << result->GetNumOfAcceptedRows()
+						<< " records is within the beam line acceptance, weight fraction "
+						<< result->GetDirectionRowWeight() << "\n";
+			}
+		}
+
+		return result;
+
+	};
+
+	// biased samples differ by the alias tables only but are kept apart
+	auto variant = energyImportance->ToString();
+	if (acceptance && projectPositions) {
+		variant += "|acceptance " + Apertures().ToString();
+	}
+	SetSampler(SampleRegistry::GetInstance().Get(sampleFileName, loader, variant));
+
+}
+
+util::DataFrame Resampling::ReadSampleFile() const {
+
+	if (util::DataFrameFormat::IsBinary(sampleFileName)) {
+		util::DataFrameMapper mapper(FloatColumns(), CategoryColumns(),
+				OptionalFloatColumns());
+		return mapper.map(sampleFileName);
+	}
+
+	util::DataFrameLoader loader(FloatColumns(), CategoryColumns(),
+			OptionalFloatColumns());
+	try {
+		return loader.load(sampleFileName);
+	} catch (util::DataFrameLoader::FileException const&) {
 		throw NoFileException();
 	}
 
-	Load(f);
+}
+
+std::set<G4String> Resampling::FloatColumns() const {
+
+	std::set<G4String> result;
+	result.insert(energyColumn);
+	result.insert(directionXColumn);
+	result.insert(directionYColumn);
+	result.insert(directionZColumn);
+	result.insert(positionXColumn);
+	result.insert(positionYColumn);
+	result.insert(positionZColumn);
+	return result;
+
+}
+
+std::set<G4String> Resampling::CategoryColumns() const {
+
+	std::set<G4String> result;
+	result.insert(typeColumn);
+	return result;
+
+}
+
+std::set<G4String> Resampling::OptionalFloatColumns() const {
+
+	std::set<G4String> result;
+	result.insert(weightColumn);
+	return result;
+
+}
+
+std::shared_ptr<ResamplingSampler const> Resampling::MakeSampler(
+		util::DataFrame&& df) const {
+
+	// the columns of an empty sample are not known to the loader
+	if (df.Size() == 0) {
+		throw EmptySampleException();
+	}
+
+	auto const dataFrame = std::make_shared < util::DataFrame const
+			> (std::move(df));
+
+	return std::make_shared < ResamplingSampler const
+			> (dataFrame, energyColumn, directionXColumn, directionYColumn,
+					directionZColumn, positionXColumn, positionYColumn,
+					positionZColumn, typeColumn, weightColumn, *energyImportance,
+					Apertures());
+
+}
+
+void Resampling::SetSampler(
+		std::shared_ptr<ResamplingSampler const> const& aSampler) {
+
+	if (aSampler->Size() == 0 || aSampler->GetDirectionRowWeight() == 0) {
+		throw EmptySampleException();
+	}
+
+	sampler = aSampler;
+	sampleFileLoaded = true;
 
 }
 
-G4double Resampling::ShootNumber(G4String const& column,
-		util::DataFrame::size_type const rowNo) const {
+void Resampling::OpenSampleStream() {
+
+	if (sampleFileName.isNull()) {
+		throw NoFileException();
+	}
+
+	// text file is indexed once for all threads
+	auto const factory = [this] {
+
+		if (verboseLevel > 0) {
+			G4cout << "Resampling: indexing sample file " << sampleFileName
+					<< "\n";
+		}
+
+		try {
+			return std::make_shared < util::DataFrameBlockReader const
+					> (sampleFileName, FloatColumns(), CategoryColumns(), blockSize,
+							OptionalFloatColumns());
+		} catch (util::DataFrameLoader::FileException const&) {
+			throw NoFileException();
+		}
+
+	};
+
+	blockReader = SampleRegistry::GetInstance().GetReader(sampleFileName,
+			blockSize, factory);
 
-	auto const v = dataFrame->FloatValue(column, rowNo);
-	auto const precision = dataFrame->Precision(column);
+	if (verboseLevel > 0) {
+		G4cout << "Resampling: streaming " << blockReader->GetNumOfRows()
+				<< " records from file " << sampleFileName << " by "
+				<< blockReader->GetNumOfBlocks() << " blocks\n";
+	}
 
-	if (precision > 0) {
-		return util::RandomNumberGenerator::locality(v, precision);
-	} else {
-		return v;
+	if (blockReader->GetNumOfRows() == 0) {
+		throw EmptySampleException();
 	}
 
+	// blocks are used for the numbers of events proportional to their weights
+	auto const reader = blockReader;
+	auto const column = weightColumn;
+	blockWeights = SampleRegistry::GetInstance().GetBlockWeights(sampleFileName,
+			blockSize, weightColumn, [reader, column] {
+				return std::make_shared<std::vector<G4double> const>(
+						reader->SumByBlocks(column));
+			});
+
+	sampleFileLoaded = true;
+
 }
 
-G4ThreeVector Resampling::ShootVector(G4String const & columnX,
-		G4String const& columnY, G4String const & columnZ,
-		util::DataFrame::size_type const rowNo) const {
+ResamplingSampler const& Resampling::NextSample() {
 
-	return G4ThreeVector(ShootNumber(columnX, rowNo),
-			ShootNumber(columnY, rowNo), ShootNumber(columnZ, rowNo));
+	if (mode == Mode::Memory) {
+		return *sampler;
+	}
+
+	if (!stream) {
+		// worker threads start from different blocks
+		auto const firstBlockNo = std::max(G4Threading::G4GetThreadId(), 0);
+		stream = std::make_unique < SampleStream
+				> (blockReader, blockWeights, shuffleBlocks, firstBlockNo, [this](
+						util::DataFrame&& df) {
+					return MakeSampler(std::move(df));
+				});
+	}
+
+	return stream->Next();
 
 }
 
@@ -203,6 +442,14 @@ G4Transform3D Resampling::DetectBeamTransform() const {
 
 }
 
+util::ApertureChain Resampling::Apertures() const {
+
+	return acceptance && projectPositions ?
+			facility::component::BeamPointer::GetInstance()->GetApertures() :
+			util::ApertureChain();
+
+}
+
 }
 
 }
@@ -1,6 +1,9 @@
+#include <sstream>
+
 #include <G4UnitsTable.hh>
 
 #include "isnp/generator/ResamplingMessenger.hh"
+#include "isnp/util/DataFrameLoader.hh"
 
 namespace isnp {
 
@@ -8,6 +11,13 @@ namespace generator {
 
 #define DIR "/isnp/gun/resampling/"
 
+namespace mode {
+
+static G4String const Memory = "memory";
+static G4String const Stream = "stream";
+
+}
+
 static std::unique_ptr<G4UIdirectory> MakeDirectory() {
 
 	auto result = std::make_unique < G4UIdirectory > (DIR);
@@ -44,9 +54,159 @@ static std::unique_ptr<G4UIcmdWithAString> MakeFile(
 
 }
 
+static std::unique_ptr<G4UIcommand> MakeConvert(
+		ResamplingMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand > (DIR "convert", inst);
+	result->SetGuidance("Convert a text data file into the binary format");
+
+	auto const source = new G4UIparameter("source", 's', false);
+	source->SetGuidance("Text data file name");
+	result->SetParameter(source);
+
+	auto const destination = new G4UIparameter("destination", 's', false);
+	destination->SetGuidance("Binary data file name");
+	result->SetParameter(destination);
+
+	// the file is written once by the master thread
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithAString> MakeMode(
+		ResamplingMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAString > (DIR "mode", inst);
+	result->SetGuidance("Set a sample reading mode");
+
+	G4String const m = G4String("  ") + mode::Memory
+			+ ": whole sample is kept in memory (default)";
+	result->SetGuidance(m);
+	G4String const s = G4String("  ") + mode::Stream
+			+ ": sample is read by blocks, rows are drawn within a block";
+	result->SetGuidance(s);
+	result->SetParameterName("mode", false);
+	G4String const c = mode::Memory + " " + mode::Stream;
+	result->SetCandidates(c);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithAnInteger> MakeBlockSize(
+		ResamplingMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAnInteger
+			> (DIR "blockSize", inst);
+	result->SetGuidance("Set a number of rows in a block in stream mode");
+	result->SetParameterName("size", false);
+	result->SetRange("size > 0");
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithABool> MakeShuffleBlocks(
+		ResamplingMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithABool
+			> (DIR "shuffleBlocks", inst);
+	result->SetGuidance(
+			"If blocks are read in random order in stream mode.");
+	result->SetGuidance("Choice : true, 1, false, 0");
+	result->SetParameterName("value", true);
+	result->SetDefaultValue("true");
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeImportance(
+		ResamplingMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand > (DIR "importance", inst);
+	result->SetGuidance(
+			"Set an importance of primary energies from the given energy up to the next given energy");
+	result->SetGuidance(
+			"  primaries are generated proportionally to the importance, their weights compensate the bias");
+	result->SetGuidance(
+			"  energies below the lowest given energy have importance 1");
+
+	auto const energy = new G4UIparameter("energy", 'd', false);
+	energy->SetGuidance("Lower bound of the energy range");
+	energy->SetParameterRange("energy >= 0");
+	result->SetParameter(energy);
+
+	auto const importance = new G4UIparameter("importance", 'd', false);
+	importance->SetGuidance("Importance of the energy range");
+	importance->SetParameterRange("importance > 0");
+	result->SetParameter(importance);
+
+	auto const unit = new G4UIparameter("unit", 's', true);
+	unit->SetGuidance("Energy unit");
+	unit->SetDefaultValue("MeV");
+	unit->SetParameterCandidates(G4UIcommand::UnitsList("Energy"));
+	result->SetParameter(unit);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithoutParameter> MakeClearImportance(
+		ResamplingMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithoutParameter
+			> (DIR "clearImportance", inst);
+	result->SetGuidance("Remove the energy importance, primaries are not biased");
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithABool> MakeAcceptance(
+		ResamplingMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithABool
+			> (DIR "acceptance", inst);
+	result->SetGuidance(
+			"If directions are drawn within the acceptance of the beam line collimators only.");
+	result->SetGuidance(
+			"  weights of primaries compensate the directions left out");
+	result->SetGuidance("Choice : true, 1, false, 0");
+	result->SetParameterName("value", true);
+	result->SetDefaultValue("true");
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithABool> MakeProjectPositions(
+		ResamplingMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithABool
+			> (DIR "projectPositions", inst);
+	result->SetGuidance(
+			"If positions are projected along the directions onto the beam start (z = 0).");
+	result->SetGuidance(
+			"  false starts particles at the recorded positions, e.g. for samples of scoring planes");
+	result->SetGuidance("Choice : true, 1, false, 0");
+	result->SetParameterName("value", true);
+	result->SetDefaultValue("true");
+
+	return result;
+
+}
+
 ResamplingMessenger::ResamplingMessenger(Resampling& aGenerator) :
 		generator(aGenerator), directory(MakeDirectory()), verboseCmd(
-				MakeVerbose(this)), fileCmd(MakeFile(this)) {
+				MakeVerbose(this)), fileCmd(MakeFile(this)), convertCmd(
+				MakeConvert(this)), modeCmd(MakeMode(this)), blockSizeCmd(
+				MakeBlockSize(this)), shuffleBlocksCmd(MakeShuffleBlocks(this)), importanceCmd(
+				MakeImportance(this)), clearImportanceCmd(
+				MakeClearImportance(this)), acceptanceCmd(MakeAcceptance(this)), projectPositionsCmd(
+				MakeProjectPositions(this)) {
 
 }
 
@@ -62,6 +222,20 @@ G4String ResamplingMessenger::GetCurrentValue(G4UIcommand* const command) {
 		ans = verboseCmd->ConvertToString(generator.GetVerboseLevel());
 	} else if (command == fileCmd.get()) {
 		ans = generator.GetSampleFileName();
+	} else if (command == modeCmd.get()) {
+		ans = ModeToString(generator.GetMode());
+	} else if (command == blockSizeCmd.get()) {
+		ans = blockSizeCmd->ConvertToString(
+				static_cast<G4int>(generator.GetBlockSize()));
+	} else if (command == shuffleBlocksCmd.get()) {
+		ans = shuffleBlocksCmd->ConvertToString(generator.GetShuffleBlocks());
+	} else if (command == importanceCmd.get()) {
+		ans = generator.GetEnergyImportance();
+	} else if (command == acceptanceCmd.get()) {
+		ans = acceptanceCmd->ConvertToString(generator.GetAcceptance());
+	} else if (command == projectPositionsCmd.get()) {
+		ans = projectPositionsCmd->ConvertToString(
+				generator.GetProjectPositions());
 	}
 
 	return ans;
@@ -75,8 +249,72 @@ void ResamplingMessenger::SetNewValue(G4UIcommand* const command,
 		generator.SetVerboseLevel(verboseCmd->GetNewIntValue(newValue));
 	} else if (command == fileCmd.get()) {
 		generator.SetSampleFileName(newValue);
+	} else if (command == convertCmd.get()) {
+		std::istringstream is(newValue);
+		G4String source, destination;
+		is >> source >> destination;
+		try {
+			generator.ConvertSampleFile(source, destination);
+		} catch (Resampling::NoFileException const&) {
+			G4cerr << "Resampling: cannot convert " << source << " into "
+					<< destination << ": cannot open a file" << G4endl;
+		} catch (util::DataFrameLoader::NoColumnException const& e) {
+			G4cerr << "Resampling: cannot convert " << source << ": no column "
+					<< e.GetColumnName() << G4endl;
+		} catch (util::DataFrameLoader::NoValueException const& e) {
+			G4cerr << "Resampling: cannot convert " << source << ": no value of "
+					<< e.GetColumnName() << " in line " << e.GetLineNo()
+					<< G4endl;
+		} catch (util::DataFrameLoader::LoaderException const&) {
+			G4cerr << "Resampling: cannot convert " << source
+					<< ": invalid data" << G4endl;
+		}
+	} else if (command == modeCmd.get()) {
+		generator.SetMode(StringToMode(newValue));
+	} else if (command == blockSizeCmd.get()) {
+		generator.SetBlockSize(blockSizeCmd->GetNewIntValue(newValue));
+	} else if (command == shuffleBlocksCmd.get()) {
+		generator.SetShuffleBlocks(shuffleBlocksCmd->GetNewBoolValue(newValue));
+	} else if (command == importanceCmd.get()) {
+		std::istringstream is(newValue);
+		G4double energy, importance;
+		G4String unit;
+		is >> energy >> importance >> unit;
+		generator.AddEnergyImportance(energy * G4UIcommand::ValueOf(unit),
+				importance);
+	} else if (command == clearImportanceCmd.get()) {
+		generator.ClearEnergyImportance();
+	} else if (command == acceptanceCmd.get()) {
+		generator.SetAcceptance(acceptanceCmd->GetNewBoolValue(newValue));
+	} else if (command == projectPositionsCmd.get()) {
+		generator.SetProjectPositions(
+				projectPositionsCmd->GetNewBoolValue(newValue));
+	}
+
+}
+
+G4String ResamplingMessenger::ModeToString(Resampling::Mode const mode) {
+
+	switch (mode) {
+	case Resampling::Mode::Memory:
+		return mode::Memory;
+
+	case Resampling::Mode::Stream:
+		return mode::Stream;
+	}
+
+	return "";
+
+}
+
+Resampling::Mode ResamplingMessenger::StringToMode(G4String const& mode) {
+
+	if (mode == mode::Stream) {
+		return Resampling::Mode::Stream;
 	}
 
+	return Resampling::Mode::Memory;
+
 }
 
 }
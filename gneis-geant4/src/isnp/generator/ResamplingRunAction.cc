@@ -0,0 +1,20 @@
+#include "isnp/generator/ResamplingRunAction.hh"
+
+namespace isnp {
+
+namespace generator {
+
+ResamplingRunAction::ResamplingRunAction(Resampling& aGenerator) :
+		generator(aGenerator) {
+
+}
+
+void ResamplingRunAction::BeginOfRunAction(G4Run const*) {
+
+	generator.PrepareSample();
+
+}
+
+}
+
+}
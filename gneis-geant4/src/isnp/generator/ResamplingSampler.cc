@@ -0,0 +1,153 @@
+#include <cmath>
+#include <algorithm>
+
+#include <G4ParticleTable.hh>
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include "isnp/generator/ResamplingSampler.hh"
+#include "isnp/util/RandomNumberGenerator.hh"
+
+namespace isnp {
+
+namespace generator {
+
+ResamplingSampler::ResamplingSampler(
+		std::shared_ptr<util::DataFrame const> const aDataFrame,
+		G4String const& energyColumn, G4String const& directionXColumn,
+		G4String const& directionYColumn, G4String const& directionZColumn,
+		G4String const& positionXColumn, G4String const& positionYColumn,
+		G4String const& positionZColumn, G4String const& typeColumn,
+		G4String const& weightColumn, EnergyImportance const& anImportance,
+		util::ApertureChain const& apertures) :
+		dataFrame(aDataFrame), size(aDataFrame->Size()), energy(*aDataFrame,
+				energyColumn), directionX(*aDataFrame, directionXColumn), directionY(
+				*aDataFrame, directionYColumn), directionZ(*aDataFrame,
+				directionZColumn), positionX(*aDataFrame, positionXColumn), positionY(
+				*aDataFrame, positionYColumn), positionZ(*aDataFrame,
+				positionZColumn), types(
+				aDataFrame->CategoryColumn(typeColumn).data()), importance(
+				anImportance), meanImportance(1.0), numOfAcceptedRows(size), acceptance(
+				1.0) {
+
+	auto const particleTable = G4ParticleTable::GetParticleTable();
+	for (std::size_t id = 0; id < particles.size(); id++) {
+		auto const& name = dataFrame->CategoryName(typeColumn,
+				static_cast<util::DataFrame::CategoryId>(id));
+		particles[id] = name.isNull() ? nullptr : particleTable->FindParticle(name);
+	}
+
+	if (size > 0 && dataFrame->HasFloatColumn(weightColumn)) {
+		aliasTable = std::make_unique < util::AliasTable const
+				> (dataFrame->FloatColumn(weightColumn).data(), size);
+	}
+
+	if (size > 0 && !importance.IsEmpty()) {
+		auto const weights =
+				aliasTable ?
+						dataFrame->FloatColumn(weightColumn).data() : nullptr;
+		std::vector<G4float> biased(size);
+		G4double sum = 0;
+		for (size_type i = 0; i < size; i++) {
+			G4double const w = weights ? weights[i] : 1.0;
+			biased[i] = static_cast<G4float>(w * importance(energy.Value(i) * MeV));
+			sum += w;
+		}
+
+		biasedTable = std::make_unique < util::AliasTable const
+				> (biased.data(), size);
+		meanImportance = biasedTable->GetTotalWeight() / sum;
+	}
+
+	if (size > 0 && !apertures.IsEmpty()) {
+		// primaries start from the positions projected onto z = 0 as Resampling does,
+		// the spot covers all of them
+		G4double spotHalfWidth = 0, spotHalfHeight = 0;
+		for (size_type i = 0; i < size; i++) {
+			auto const t = positionZ.Value(i) / directionZ.Value(i);
+			auto const x = std::fabs(positionX.Value(i) - t * directionX.Value(i));
+			auto const y = std::fabs(positionY.Value(i) - t * directionY.Value(i));
+			if (std::isfinite(x) && std::isfinite(y)) {
+				spotHalfWidth = std::max(spotHalfWidth, x);
+				spotHalfHeight = std::max(spotHalfHeight, y);
+			}
+		}
+
+		auto const weights =
+				aliasTable ?
+						dataFrame->FloatColumn(weightColumn).data() : nullptr;
+		std::vector<G4float> accepted(size, 0.0f);
+		G4double sum = 0;
+		numOfAcceptedRows = 0;
+		for (size_type i = 0; i < size; i++) {
+			G4float const w = weights ? weights[i] : 1.0f;
+			sum += w;
+			if (apertures.IsInCone(
+					G4ThreeVector(directionX.Value(i), directionY.Value(i),
+							directionZ.Value(i)), spotHalfWidth * mm,
+					spotHalfHeight * mm) && w > 0) {
+				accepted[i] = w;
+				numOfAcceptedRows++;
+			}
+		}
+
+		if (numOfAcceptedRows > 0) {
+			acceptedTable = std::make_unique < util::AliasTable const
+					> (accepted.data(), size);
+			acceptance = acceptedTable->GetTotalWeight() / sum;
+		} else {
+			acceptance = 0.0;
+		}
+	}
+
+}
+
+G4double ResamplingSampler::GetTotalWeight() const {
+
+	return aliasTable ? aliasTable->GetTotalWeight() : size;
+
+}
+
+ResamplingSampler::size_type ResamplingSampler::ShootRow() const {
+
+	return aliasTable ? aliasTable->Shoot() : CLHEP::RandFlat::shootInt(size);
+
+}
+
+ResamplingSampler::size_type ResamplingSampler::ShootEnergyRow() const {
+
+	return biasedTable ? biasedTable->Shoot() : ShootRow();
+
+}
+
+ResamplingSampler::size_type ResamplingSampler::ShootDirectionRow() const {
+
+	return acceptedTable ? acceptedTable->Shoot() : ShootRow();
+
+}
+
+G4double ResamplingSampler::EnergyRowWeight(size_type const rowNo) const {
+
+	return biasedTable ?
+			meanImportance / importance(energy.Value(rowNo) * MeV) : 1.0;
+
+}
+
+ResamplingSampler::Column::Column(util::DataFrame const& dataFrame,
+		G4String const& columnName) :
+		values(dataFrame.FloatColumn(columnName).data()), precision(
+				dataFrame.Precision(columnName)) {
+}
+
+G4double ResamplingSampler::Column::Shoot(size_type const rowNo) const {
+
+	G4double const v = values[rowNo];
+
+	return precision > 0 ?
+			util::RandomNumberGenerator::locality(v, precision) : v;
+
+}
+
+}
+
+}
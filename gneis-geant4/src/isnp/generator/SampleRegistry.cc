@@ -0,0 +1,98 @@
+#include <sstream>
+#include <sys/stat.h>
+
+#include <G4AutoLock.hh>
+
+#include "isnp/generator/SampleRegistry.hh"
+
+namespace isnp {
+
+namespace generator {
+
+SampleRegistry::SampleRegistry() {
+
+}
+
+SampleRegistry& SampleRegistry::GetInstance() {
+
+	// function-level static is initialized in a thread-safe way
+	static SampleRegistry instance;
+	return instance;
+
+}
+
+template<typename T>
+std::shared_ptr<T const> SampleRegistry::GetObject(G4String const& key,
+		G4String const& fileName,
+		std::function<std::shared_ptr<T const>()> const& factory) {
+
+	G4AutoLock lock(&mutex);
+
+	auto const stamp = FileStamp(fileName);
+	auto& entry = entries[key];
+
+	auto result = std::static_pointer_cast<T const>(entry.object.lock());
+	if (!result || entry.stamp != stamp) {
+		result = factory();
+		entry.stamp = stamp;
+		entry.object = result;
+	}
+
+	return result;
+
+}
+
+SampleRegistry::SamplerPtr SampleRegistry::Get(G4String const& fileName,
+		Loader const& loader, G4String const& variant) {
+
+	G4String const key =
+			variant.isNull() ?
+					"sample:" + fileName : "sample:" + fileName + "|" + variant;
+	return GetObject<ResamplingSampler>(key, fileName, loader);
+
+}
+
+SampleRegistry::ReaderPtr SampleRegistry::GetReader(G4String const& fileName,
+		util::DataFrameBlockReader::size_type const blockSize,
+		ReaderFactory const& factory) {
+
+	std::ostringstream key;
+	key << "blocks:" << blockSize << ":" << fileName;
+	return GetObject<util::DataFrameBlockReader>(key.str(), fileName, factory);
+
+}
+
+SampleRegistry::BlockWeightsPtr SampleRegistry::GetBlockWeights(
+		G4String const& fileName,
+		util::DataFrameBlockReader::size_type const blockSize,
+		G4String const& weightColumn, BlockWeightsFactory const& factory) {
+
+	std::ostringstream key;
+	key << "weights:" << blockSize << ":" << weightColumn << ":" << fileName;
+	return GetObject<std::vector<G4double>>(key.str(), fileName, factory);
+
+}
+
+SampleRegistry::TablePtr SampleRegistry::GetTable(G4String const& fileName,
+		TableLoader const& loader) {
+
+	return GetObject<EmulatorTable>("table:" + fileName, fileName, loader);
+
+}
+
+G4String SampleRegistry::FileStamp(G4String const& fileName) {
+
+	struct stat st;
+	if (::stat(fileName.c_str(), &st) != 0) {
+		return "";
+	}
+
+	std::ostringstream ss;
+	ss << st.st_size << ':' << st.st_mtime;
+	return ss.str();
+
+}
+
+}
+
+}
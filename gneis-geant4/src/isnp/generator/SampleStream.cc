@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <numeric>
+
+#include <Randomize.hh>
+
+#include "isnp/generator/SampleStream.hh"
+
+namespace isnp {
+
+namespace generator {
+
+SampleStream::SampleStream(
+		std::shared_ptr<util::DataFrameBlockReader const> const aReader,
+		std::shared_ptr<std::vector<G4double> const> const aBlockWeights,
+		G4bool const aShuffleBlocks, size_type const firstBlockNo,
+		SamplerFactory const& aSamplerFactory) :
+		reader(aReader), blockWeights(aBlockWeights), meanWeight(0), shuffleBlocks(
+				aShuffleBlocks), samplerFactory(aSamplerFactory), order(
+				aReader->GetNumOfBlocks()), position(0), nextNumOfEvents(0), remaining(
+				0) {
+
+	if (blockWeights && blockWeights->size() == order.size()
+			&& aReader->GetNumOfRows() > 0) {
+		meanWeight = std::accumulate(std::begin(*blockWeights),
+				std::end(*blockWeights), 0.0) / aReader->GetNumOfRows();
+	}
+
+	std::iota(std::begin(order), std::end(order), 0);
+	if (!order.empty()) {
+		std::rotate(std::begin(order),
+				std::begin(order) + firstBlockNo % order.size(),
+				std::end(order));
+	}
+	position = order.size();
+
+	Prefetch();
+
+}
+
+SampleStream::~SampleStream() {
+
+	// wait for the background reading to finish
+	if (nextBlock.valid()) {
+		nextBlock.wait();
+	}
+
+}
+
+ResamplingSampler const& SampleStream::Next() {
+
+	if (remaining == 0) {
+		current.reset();
+		current = samplerFactory(nextBlock.get());
+		remaining = nextNumOfEvents;
+		Prefetch();
+	}
+
+	--remaining;
+	return *current;
+
+}
+
+void SampleStream::Prefetch() {
+
+	size_type blockNo;
+	do {
+		if (position >= order.size()) {
+			// start a new pass over the file
+			if (shuffleBlocks) {
+				for (auto i = order.size(); i > 1; i--) {
+					std::swap(order[i - 1],
+							order[CLHEP::RandFlat::shootInt(
+									static_cast<long>(i))]);
+				}
+			}
+			position = 0;
+		}
+
+		blockNo = order[position++];
+		nextNumOfEvents = NumOfEvents(blockNo);
+	} while (nextNumOfEvents == 0);
+
+	auto const r = reader;
+	nextBlock = std::async(std::launch::async, [r, blockNo] {
+		return r->Read(blockNo);
+	});
+
+}
+
+SampleStream::size_type SampleStream::NumOfEvents(
+		size_type const blockNo) const {
+
+	if (meanWeight <= 0) {
+		auto const begin = blockNo * reader->GetBlockSize();
+		return std::min(reader->GetBlockSize(), reader->GetNumOfRows() - begin);
+	}
+
+	auto const expected = (*blockWeights)[blockNo] / meanWeight;
+	auto result = static_cast<size_type>(expected);
+	if (CLHEP::RandFlat::shoot() < expected - result) {
+		result++;
+	}
+	return result;
+
+}
+
+}
+
+}
@@ -17,6 +17,9 @@ namespace isnp {
 
 namespace generator {
 
+// number of positions generated in one batch
+static std::size_t const POSITION_BATCH_SIZE = 256;
+
 Spallation::Spallation() :
 		particleGun(MakeGun()), messenger(
 				std::make_unique < SpallationMessenger > (*this)), positionX(0), positionY(
@@ -24,7 +27,8 @@ Spallation::Spallation() :
 				dist::UniformRectangleProps(120 * mm, 50 * mm)), uniformCircle(
 				dist::UniformCircleProps(4.0 * cm)), gaussEllipse(
 				dist::GaussEllipseProps(200 * mm, 50 * mm)), targetTransformDetected(
-				false) {
+				false), positionsX(POSITION_BATCH_SIZE), positionsY(
+				POSITION_BATCH_SIZE), positionNo(POSITION_BATCH_SIZE) {
 }
 
 Spallation::~Spallation() {
@@ -84,12 +88,25 @@ const dist::AbstractDistribution& Spallation::ResolveDistribution() const {
 
 }
 
+G4ThreeVector Spallation::NextPosition() {
+
+	if (positionNo >= positionsX.size()) {
+		ResolveDistribution().GenerateN(positionsX.data(), positionsY.data(),
+				positionsX.size());
+		positionNo = 0;
+	}
+
+	auto const i = positionNo++;
+	return G4ThreeVector(positionsX[i], positionsY[i], 0);
+
+}
+
 G4ThreeVector Spallation::GeneratePosition(
-		G4Transform3D const& transform) const {
+		G4Transform3D const& transform) {
 
 	using namespace facility::component;
 
-	G4ThreeVector position = ResolveDistribution().Generate();
+	G4ThreeVector position = NextPosition();
 
 	position.setX(position.getX() + positionX);
 	position.setY(position.getY() + positionY);
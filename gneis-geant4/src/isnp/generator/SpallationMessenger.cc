@@ -18,6 +18,13 @@ static G4String const UniformRectangle = "UniformRectangle";
 
 }
 
+namespace engine {
+
+static G4String const Rejection = "Rejection";
+static G4String const Analytic = "Analytic";
+
+}
+
 static std::unique_ptr<G4UIdirectory> MakeDirectory() {
 
 	auto result = std::make_unique < G4UIdirectory > (DIR);
@@ -126,12 +133,30 @@ static std::unique_ptr<G4UIcmdWithAString> MakeMode(
 
 }
 
+static std::unique_ptr<G4UIcmdWithAString> MakeCircleEngine(
+		SpallationMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAString
+			> (DIR "circleEngine", inst);
+	result->SetGuidance("Set a sampling engine of the UniformCircle mode");
+
+	G4String const g = G4String("  engine: ") + engine::Rejection + ", "
+			+ engine::Analytic;
+	result->SetGuidance(g);
+	result->SetParameterName("engine", false);
+	G4String const c = engine::Rejection + " " + engine::Analytic;
+	result->SetCandidates(c);
+
+	return result;
+
+}
+
 SpallationMessenger::SpallationMessenger(Spallation& spallation_) :
 		spallation(spallation_), directory(MakeDirectory()), diameterCmd(
 				MakeDiameter(this)), xWidthCmd(MakeXWidth(this)), yWidthCmd(
 				MakeYWidth(this)), positionXCmd(MakePositionX(this)), positionYCmd(
 				MakePositionY(this)), verboseCmd(MakeVerbose(this)), modeCmd(
-				MakeMode(this)) {
+				MakeMode(this)), circleEngineCmd(MakeCircleEngine(this)) {
 
 }
 
@@ -142,22 +167,27 @@ SpallationMessenger::~SpallationMessenger() {
 G4String SpallationMessenger::GetCurrentValue(G4UIcommand* const command) {
 
 	G4String ans;
+	// the non-const accessors discard the buffered positions
+	Spallation const& current = spallation;
 
 	if (command == diameterCmd.get()) {
 		ans = diameterCmd->ConvertToString(
-				spallation.GetUniformCircle().GetProps().GetDiameter());
+				current.GetUniformCircle().GetProps().GetDiameter());
 	} else if (command == xWidthCmd.get()) {
-		ans = xWidthCmd->ConvertToString(spallation.GetGaussEllipse().GetProps().GetXWidth());
+		ans = xWidthCmd->ConvertToString(current.GetGaussEllipse().GetProps().GetXWidth());
 	} else if (command == yWidthCmd.get()) {
-		ans = yWidthCmd->ConvertToString(spallation.GetGaussEllipse().GetProps().GetYWidth());
+		ans = yWidthCmd->ConvertToString(current.GetGaussEllipse().GetProps().GetYWidth());
 	} else if (command == positionXCmd.get()) {
-		ans = positionXCmd->ConvertToString(spallation.GetPositionX());
+		ans = positionXCmd->ConvertToString(current.GetPositionX());
 	} else if (command == positionYCmd.get()) {
-		ans = positionYCmd->ConvertToString(spallation.GetPositionY());
+		ans = positionYCmd->ConvertToString(current.GetPositionY());
 	} else if (command == verboseCmd.get()) {
-		ans = verboseCmd->ConvertToString(spallation.GetVerboseLevel());
+		ans = verboseCmd->ConvertToString(current.GetVerboseLevel());
 	} else if (command == modeCmd.get()) {
-		ans = ModeToString(spallation.GetMode());
+		ans = ModeToString(current.GetMode());
+	} else if (command == circleEngineCmd.get()) {
+		ans = EngineToString(
+				current.GetUniformCircle().GetProps().GetEngine());
 	}
 
 	return ans;
@@ -188,6 +218,9 @@ void SpallationMessenger::SetNewValue(G4UIcommand* const command,
 		spallation.SetVerboseLevel(verboseCmd->GetNewIntValue(newValue));
 	} else if (command == modeCmd.get()) {
 		spallation.SetMode(StringToMode(newValue));
+	} else if (command == circleEngineCmd.get()) {
+		spallation.GetUniformCircle().GetProps().SetEngine(
+				StringToEngine(newValue));
 	}
 
 }
@@ -227,6 +260,32 @@ Spallation::Mode SpallationMessenger::StringToMode(G4String const& mode) {
 
 }
 
+G4String SpallationMessenger::EngineToString(
+		dist::UniformCircleProps::Engine const engine) {
+
+	switch (engine) {
+	case dist::UniformCircleProps::Engine::Rejection:
+		return engine::Rejection;
+
+	case dist::UniformCircleProps::Engine::Analytic:
+		return engine::Analytic;
+	}
+
+	return "";
+
+}
+
+dist::UniformCircleProps::Engine SpallationMessenger::StringToEngine(
+		G4String const& engine) {
+
+	if (engine == engine::Analytic) {
+		return dist::UniformCircleProps::Engine::Analytic;
+	}
+
+	return dist::UniformCircleProps::Engine::Rejection;
+
+}
+
 }
 
 }
@@ -0,0 +1,108 @@
+#include <G4RunManager.hh>
+
+#include "isnp/init/ActionInitialization.hh"
+#include "isnp/init/CompositeRunAction.hh"
+#include "isnp/init/CompositeSteppingAction.hh"
+#include "isnp/init/StackingAction.hh"
+#include "isnp/init/StackingRunAction.hh"
+#include "isnp/init/StepCountRunAction.hh"
+#include "isnp/detector/BasicRunAction.hh"
+#include "isnp/detector/ScoringPlaneAction.hh"
+#include "isnp/detector/ScoringPlaneRunAction.hh"
+#include "isnp/facility/component/ScoringPlanes.hh"
+#include "isnp/detector/NextEventAction.hh"
+#include "isnp/detector/NextEventRunAction.hh"
+#include "isnp/generator/Resampling.hh"
+#include "isnp/generator/ResamplingRunAction.hh"
+#include "isnp/generator/Emulator.hh"
+#include "isnp/generator/EmulatorRunAction.hh"
+
+namespace isnp {
+
+namespace init {
+
+ActionInitialization::ActionInitialization(
+		GeneratorFactory const& aGeneratorFactory) :
+		generatorFactory(aGeneratorFactory), masterGenerator(
+				IsMultithreaded() ? aGeneratorFactory() : nullptr) {
+
+}
+
+ActionInitialization::~ActionInitialization() {
+
+}
+
+void ActionInitialization::BuildForMaster() const {
+
+	auto const runAction = new CompositeRunAction;
+
+	auto const resampling =
+			dynamic_cast<generator::Resampling*>(masterGenerator.get());
+	if (resampling) {
+		runAction->Add(
+				std::make_unique < generator::ResamplingRunAction
+						> (*resampling));
+	}
+
+	auto const emulator =
+			dynamic_cast<generator::Emulator*>(masterGenerator.get());
+	if (emulator) {
+		runAction->Add(
+				std::make_unique < generator::EmulatorRunAction > (*emulator));
+	}
+
+	// prints the particles dropped by the workers' stacking actions
+	// and the number of their steps
+	runAction->Add(std::make_unique<StackingRunAction>());
+	runAction->Add(std::make_unique<StepCountRunAction>());
+
+	// merges the shards written by the workers' detectors
+	runAction->Add(std::make_unique<detector::BasicRunAction>());
+
+	SetUserAction(runAction);
+
+}
+
+void ActionInitialization::Build() const {
+
+	SetUserAction(generatorFactory());
+
+	auto scoringPlanes = std::make_unique<detector::ScoringPlaneAction>();
+	auto nextEvent = std::make_unique<detector::NextEventAction>();
+	auto const stackingAction = new StackingAction;
+	auto const steppingAction = new CompositeSteppingAction;
+
+	auto const runAction = new CompositeRunAction;
+	runAction->Add(
+			std::make_unique < detector::ScoringPlaneRunAction
+					> (*scoringPlanes));
+	runAction->Add(
+			std::make_unique < detector::NextEventRunAction > (*nextEvent));
+	runAction->Add(std::make_unique < StackingRunAction > (stackingAction));
+	runAction->Add(std::make_unique < StepCountRunAction > (steppingAction));
+	runAction->Add(std::make_unique<detector::BasicRunAction>());
+	SetUserAction(runAction);
+
+	steppingAction->Add(std::move(scoringPlanes), [] {
+		return !facility::component::ScoringPlanes::GetInstance()->GetPlanes().empty();
+	});
+	steppingAction->Add(std::move(nextEvent), [] {
+		return !detector::NextEventAction::GetPoints().empty();
+	});
+	SetUserAction(steppingAction);
+
+	SetUserAction(stackingAction);
+
+}
+
+bool ActionInitialization::IsMultithreaded() {
+
+	auto const runManager = G4RunManager::GetRunManager();
+	return runManager
+			&& runManager->GetRunManagerType() == G4RunManager::masterRM;
+
+}
+
+}
+
+}
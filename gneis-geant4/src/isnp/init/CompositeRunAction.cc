@@ -0,0 +1,31 @@
+#include "isnp/init/CompositeRunAction.hh"
+
+namespace isnp {
+
+namespace init {
+
+void CompositeRunAction::Add(std::unique_ptr<G4UserRunAction>&& action) {
+
+	actions.push_back(std::move(action));
+
+}
+
+void CompositeRunAction::BeginOfRunAction(G4Run const* const run) {
+
+	for (auto const& action : actions) {
+		action->BeginOfRunAction(run);
+	}
+
+}
+
+void CompositeRunAction::EndOfRunAction(G4Run const* const run) {
+
+	for (auto const& action : actions) {
+		action->EndOfRunAction(run);
+	}
+
+}
+
+}
+
+}
@@ -0,0 +1,53 @@
+#include "isnp/init/CompositeSteppingAction.hh"
+
+namespace isnp {
+
+namespace init {
+
+G4bool CompositeSteppingAction::countSteps = false;
+
+CompositeSteppingAction::CompositeSteppingAction() :
+		numOfSteps(0) {
+}
+
+void CompositeSteppingAction::Add(
+		std::unique_ptr<G4UserSteppingAction>&& action,
+		Condition const& condition) {
+
+	actions.push_back(action.get());
+	entries.push_back(Entry { std::move(action), condition });
+
+}
+
+void CompositeSteppingAction::Prepare() {
+
+	actions.clear();
+	for (auto const& entry : entries) {
+		if (!entry.condition || entry.condition()) {
+			actions.push_back(entry.action.get());
+		}
+	}
+
+}
+
+void CompositeSteppingAction::SetCountSteps(G4bool const v) {
+
+	countSteps = v;
+
+}
+
+void CompositeSteppingAction::UserSteppingAction(G4Step const* const step) {
+
+	if (countSteps) {
+		numOfSteps++;
+	}
+
+	for (auto const action : actions) {
+		action->UserSteppingAction(step);
+	}
+
+}
+
+}
+
+}
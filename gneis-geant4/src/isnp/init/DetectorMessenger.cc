@@ -0,0 +1,143 @@
+#include "isnp/init/DetectorMessenger.hh"
+
+namespace isnp {
+
+namespace init {
+
+#define DIR "/isnp/detector/"
+
+namespace format {
+
+static G4String const Text = "text";
+static G4String const Binary = "binary";
+
+}
+
+static std::unique_ptr<G4UIdirectory> MakeDirectory() {
+
+	auto result = std::make_unique < G4UIdirectory > (DIR);
+	result->SetGuidance("ISNP Detector Commands");
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithAString> MakeFormat(
+		DetectorMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAString > (DIR "format", inst);
+	result->SetGuidance("Set a format of the detector output files");
+
+	G4String const t = G4String("  ") + format::Text
+			+ ": tab-separated text (default)";
+	result->SetGuidance(t);
+	G4String const b = G4String("  ") + format::Binary
+			+ ": binary columnar format, can be used as a Resampling sample";
+	result->SetGuidance(b);
+	result->SetParameterName("format", false);
+	G4String const c = format::Text + " " + format::Binary;
+	result->SetCandidates(c);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithAnInteger> MakeFlushThreshold(
+		DetectorMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAnInteger
+			> (DIR "flushThreshold", inst);
+	result->SetGuidance(
+			"Set a number of hits after which they are written to the file");
+	result->SetGuidance(
+			"  hits are written by a background thread, 0 means writing once at the end of the run (default)");
+	result->SetParameterName("threshold", false);
+	result->SetRange("threshold >= 0");
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithABool> MakeWriteHits(
+		DetectorMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithABool
+			> (DIR "writeHits", inst);
+	result->SetGuidance("Enable or disable writing of hits to the file");
+	result->SetGuidance(
+			"  disable to keep only the histograms defined by /isnp/score/ commands");
+	result->SetParameterName("writeHits", false);
+
+	return result;
+
+}
+
+DetectorMessenger::DetectorMessenger() :
+		directory(MakeDirectory()), formatCmd(MakeFormat(this)), flushThresholdCmd(
+				MakeFlushThreshold(this)), writeHitsCmd(MakeWriteHits(this)) {
+
+}
+
+DetectorMessenger::~DetectorMessenger() {
+
+}
+
+G4String DetectorMessenger::GetCurrentValue(G4UIcommand* const command) {
+
+	G4String ans;
+
+	if (command == formatCmd.get()) {
+		ans = FormatToString(detector::Basic::GetFormat());
+	} else if (command == flushThresholdCmd.get()) {
+		ans = flushThresholdCmd->ConvertToString(
+				static_cast<G4int>(detector::Basic::GetFlushThreshold()));
+	} else if (command == writeHitsCmd.get()) {
+		ans = writeHitsCmd->ConvertToString(detector::Basic::GetWriteHits());
+	}
+
+	return ans;
+
+}
+
+void DetectorMessenger::SetNewValue(G4UIcommand* const command,
+		G4String const newValue) {
+
+	if (command == formatCmd.get()) {
+		detector::Basic::SetFormat(StringToFormat(newValue));
+	} else if (command == flushThresholdCmd.get()) {
+		detector::Basic::SetFlushThreshold(
+				flushThresholdCmd->GetNewIntValue(newValue));
+	} else if (command == writeHitsCmd.get()) {
+		detector::Basic::SetWriteHits(writeHitsCmd->GetNewBoolValue(newValue));
+	}
+
+}
+
+G4String DetectorMessenger::FormatToString(
+		detector::Basic::Format const format) {
+
+	switch (format) {
+	case detector::Basic::Format::Text:
+		return format::Text;
+
+	case detector::Basic::Format::Binary:
+		return format::Binary;
+	}
+
+	return "";
+
+}
+
+detector::Basic::Format DetectorMessenger::StringToFormat(
+		G4String const& format) {
+
+	if (format == format::Binary) {
+		return detector::Basic::Format::Binary;
+	}
+
+	return detector::Basic::Format::Text;
+
+}
+
+}
+
+}
@@ -3,6 +3,8 @@
 #include "isnp/init/PhysListMessenger.hh"
 #include "isnp/init/FacilityMessenger.hh"
 #include "isnp/init/UserActionMessenger.hh"
+#include "isnp/init/DetectorMessenger.hh"
+#include "isnp/init/ScoreMessenger.hh"
 #include "isnp/repository/Materials.hh"
 
 namespace isnp {
@@ -13,7 +15,8 @@ InitMessengers::InitMessengers(G4RunManager& aRunManager) :
 		fileNameBuilderMessenger(new FileNameBuilderMessenger), physListMessenger(
 				new PhysListMessenger(aRunManager)), facilityMessenger(
 				new FacilityMessenger(aRunManager)), userActionMessenger(
-				new UserActionMessenger(aRunManager)) {
+				new UserActionMessenger(aRunManager)), detectorMessenger(
+				new DetectorMessenger), scoreMessenger(new ScoreMessenger) {
 
 	repository::Materials::GetInstance();
 }
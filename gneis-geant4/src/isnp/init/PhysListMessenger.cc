@@ -1,6 +1,14 @@
 #include <algorithm>
 #include <G4PhysListFactory.hh>
+#include <G4StateManager.hh>
+#include <G4ImportanceBiasing.hh>
+#include <G4ParallelWorldPhysics.hh>
+#include <G4StepLimiterPhysics.hh>
+#include <G4FastSimulationPhysics.hh>
 #include "isnp/init/PhysListMessenger.hh"
+#include "isnp/init/PhysicsTableCache.hh"
+#include "isnp/facility/Beam5.hh"
+#include "isnp/facility/component/ImportanceWorld.hh"
 
 namespace isnp {
 
@@ -32,8 +40,72 @@ static std::unique_ptr<G4UIcmdWithAString> MakePhysList(
 
 }
 
+static std::unique_ptr<G4UIcmdWithAString> MakeImportanceBiasing(
+		PhysListMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAString
+			> (DIR "importanceBiasing", inst);
+	result->SetGuidance(
+			"Split and roulette particles of the given type crossing the regions");
+	result->SetGuidance(
+			"  set by /isnp/facility/component/importance/add");
+	result->SetGuidance(
+			"  particles are split entering a region of higher importance");
+	result->SetGuidance(
+			"  and rouletted entering a region of lower importance");
+	result->SetParameterName("particle", true);
+	result->SetDefaultValue("neutron");
+	result->AvailableForStates(G4State_PreInit);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithABool> MakePhysicsCache(
+		PhysListMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithABool
+			> (DIR "physicsCache", inst);
+	result->SetGuidance(
+			"Store the physics tables built by the first run into the cache directory");
+	result->SetGuidance(
+			"  and retrieve them in the following jobs with the same physics list,");
+	result->SetGuidance(
+			"  Geant4 version, materials, production cuts and geometry");
+	result->SetGuidance(
+			"  the key is taken at the end of /run/initialize, set the cuts before it");
+	result->SetGuidance("Choice : true, 1, false, 0");
+	result->SetParameterName("value", true);
+	result->SetDefaultValue("true");
+	result->AvailableForStates(G4State_PreInit);
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithAString> MakePhysicsCacheDir(
+		PhysListMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAString
+			> (DIR "physicsCacheDir", inst);
+	result->SetGuidance("Set the cache directory of the physics tables");
+	result->SetParameterName("directory", false);
+	result->AvailableForStates(G4State_PreInit);
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
 PhysListMessenger::PhysListMessenger(G4RunManager& aRunManager) :
-		runManager(aRunManager), physListCmd(MakePhysList(this)), physList("") {
+		runManager(aRunManager), physListCmd(MakePhysList(this)), importanceBiasingCmd(
+				MakeImportanceBiasing(this)), physicsCacheCmd(
+				MakePhysicsCache(this)), physicsCacheDirCmd(
+				MakePhysicsCacheDir(this)), physList(""), physicsList(
+				nullptr), importanceBiasing(""), stepLimiterRegistered(false), fastSimulationRegistered(
+				false), physicsTableCache(
+				std::make_unique<PhysicsTableCache>()) {
 
 }
 
@@ -47,6 +119,12 @@ G4String PhysListMessenger::GetCurrentValue(G4UIcommand* const command) {
 
 	if (command == physListCmd.get()) {
 		ans = physList;
+	} else if (command == importanceBiasingCmd.get()) {
+		ans = importanceBiasing;
+	} else if (command == physicsCacheCmd.get()) {
+		ans = physicsCacheCmd->ConvertToString(physicsTableCache->GetEnabled());
+	} else if (command == physicsCacheDirCmd.get()) {
+		ans = physicsTableCache->GetDirectory();
 	}
 
 	return ans;
@@ -58,8 +136,27 @@ void PhysListMessenger::SetNewValue(G4UIcommand* const command,
 
 	if (command == physListCmd.get()) {
 		SetPhysList(newValue);
+	} else if (command == importanceBiasingCmd.get()) {
+		SetImportanceBiasing(newValue);
+	} else if (command == physicsCacheCmd.get()) {
+		physicsTableCache->SetEnabled(
+				physicsCacheCmd->GetNewBoolValue(newValue));
+	} else if (command == physicsCacheDirCmd.get()) {
+		physicsTableCache->SetDirectory(newValue);
+	}
+
+}
+
+G4bool PhysListMessenger::Notify(G4ApplicationState const requestedState) {
+
+	// the physics list takes constructors until the state is changed
+	if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_PreInit
+			&& requestedState == G4State_Init) {
+		RegisterFacilityPhysics();
 	}
 
+	return true;
+
 }
 
 void PhysListMessenger::SetPhysList(G4String const& name) {
@@ -70,6 +167,10 @@ void PhysListMessenger::SetPhysList(G4String const& name) {
 		auto const pl = factory.GetReferencePhysList(name);
 		if (pl) {
 			runManager.SetUserInitialization(pl);
+			physicsList = pl;
+			geometrySampler.reset();
+			stepLimiterRegistered = false;
+			fastSimulationRegistered = false;
 		} else {
 			G4cerr << "Unknown physics list: " << name << G4endl;
 			return;
@@ -77,6 +178,68 @@ void PhysListMessenger::SetPhysList(G4String const& name) {
 	}
 
 	physList = name;
+	physicsTableCache->SetPhysicsList(physicsList, physList);
+	RegisterImportanceBiasing();
+
+}
+
+void PhysListMessenger::SetImportanceBiasing(G4String const& particleName) {
+
+	if (geometrySampler) {
+		G4cerr << "Importance biasing is already registered for "
+				<< importanceBiasing << G4endl;
+		return;
+	}
+
+	importanceBiasing = particleName;
+	RegisterImportanceBiasing();
+
+}
+
+void PhysListMessenger::RegisterImportanceBiasing() {
+
+	if (!physicsList || importanceBiasing.isNull() || geometrySampler) {
+		return;
+	}
+
+	auto const& worldName = facility::component::ImportanceWorld::WorldName;
+
+	// sampler is used by the biasing processes of all threads
+	geometrySampler = std::make_unique < G4GeometrySampler
+			> (worldName, importanceBiasing);
+	geometrySampler->SetParallel(true);
+
+	physicsList->RegisterPhysics(
+			new G4ImportanceBiasing(geometrySampler.get(), worldName));
+	physicsList->RegisterPhysics(new G4ParallelWorldPhysics(worldName));
+
+	// the biasing processes change the tables
+	physicsTableCache->SetPhysicsList(physicsList,
+			physList + " " + importanceBiasing);
+
+}
+
+void PhysListMessenger::RegisterFacilityPhysics() {
+
+	auto const beam5 = dynamic_cast<facility::Beam5 const*>(
+			runManager.GetUserDetectorConstruction());
+	if (!physicsList || !beam5) {
+		return;
+	}
+
+	// applies the user limits of the facility regions
+	if (!stepLimiterRegistered && beam5->HasTrackLimits()) {
+		physicsList->RegisterPhysics(new G4StepLimiterPhysics);
+		stepLimiterRegistered = true;
+	}
+
+	// applies the fast simulation model of the vacuum envelope
+	if (!fastSimulationRegistered && beam5->GetFastVacuum()) {
+		auto const fastSimulation = new G4FastSimulationPhysics;
+		fastSimulation->ActivateFastSimulation("neutron");
+		physicsList->RegisterPhysics(fastSimulation);
+		fastSimulationRegistered = true;
+	}
 
 }
 
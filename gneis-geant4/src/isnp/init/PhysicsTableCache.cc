@@ -0,0 +1,206 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#include <G4StateManager.hh>
+#include <G4Material.hh>
+#include <G4RegionStore.hh>
+#include <G4ProductionCuts.hh>
+#include <G4TransportationManager.hh>
+
+#include "isnp/init/PhysicsTableCache.hh"
+#include "isnp/info/Geant4Version.hh"
+#include "isnp/facility/component/OverlapCache.hh"
+#include "isnp/util/ContentHash.hh"
+
+namespace isnp {
+
+namespace init {
+
+// written after all the tables, so an interrupted store is not retrieved
+static char const* const completeFileName = "complete";
+
+// cuts of gamma, e-, e+ and proton
+static G4int const numOfCuts = 4;
+
+// removes a directory of the physics table files, no subdirectories are expected
+static void RemoveDirectory(G4String const& name) {
+
+	if (auto const dir = ::opendir(name.c_str())) {
+		while (auto const entry = ::readdir(dir)) {
+			G4String const fileName = entry->d_name;
+			if (fileName != "." && fileName != "..") {
+				std::remove((name + "/" + fileName).c_str());
+			}
+		}
+		::closedir(dir);
+	}
+	::rmdir(name.c_str());
+
+}
+
+PhysicsTableCache::PhysicsTableCache() :
+		physicsList(nullptr), description(""), enabled(true), directory(
+				"isnp-cache"), initializing(false), pendingDirectory("") {
+}
+
+G4bool PhysicsTableCache::Notify(G4ApplicationState const requestedState) {
+
+	auto const currentState = G4StateManager::GetStateManager()->GetCurrentState();
+
+	// /run/initialize goes PreInit -> Init -> Idle,
+	// the tables are built by the first run between Init and Idle as well
+	if (currentState == G4State_PreInit && requestedState == G4State_Init) {
+		initializing = true;
+	} else if (currentState == G4State_Init
+			&& requestedState == G4State_Idle) {
+		if (initializing) {
+			initializing = false;
+			Prepare();
+		} else {
+			Store();
+		}
+	}
+
+	return true;
+
+}
+
+void PhysicsTableCache::SetPhysicsList(G4VUserPhysicsList* const list,
+		G4String const& aDescription) {
+
+	physicsList = list;
+	description = aDescription;
+
+}
+
+G4bool PhysicsTableCache::GetEnabled() const {
+
+	return enabled;
+
+}
+
+void PhysicsTableCache::SetEnabled(G4bool const v) {
+
+	enabled = v;
+
+}
+
+G4String const& PhysicsTableCache::GetDirectory() const {
+
+	return directory;
+
+}
+
+void PhysicsTableCache::SetDirectory(G4String const& v) {
+
+	directory = v;
+
+}
+
+G4String PhysicsTableCache::MakeKey() const {
+
+	std::ostringstream os;
+	os << std::setprecision(17);
+
+	os << description << '\n' << info::Geant4Version::GetAsString() << '\n';
+
+	for (auto const material : *G4Material::GetMaterialTable()) {
+		os << material->GetName() << ' ' << material->GetDensity() << ' '
+				<< material->GetState();
+		auto const fractions = material->GetFractionVector();
+		for (std::size_t i = 0; i < material->GetNumberOfElements(); i++) {
+			os << ' ' << material->GetElement(i)->GetName() << ' '
+					<< fractions[i];
+		}
+		os << '\n';
+	}
+
+	for (auto const region : *G4RegionStore::GetInstance()) {
+		os << region->GetName();
+		if (auto const cuts = region->GetProductionCuts()) {
+			for (G4int i = 0; i < numOfCuts; i++) {
+				os << ' ' << cuts->GetProductionCut(i);
+			}
+		}
+		os << '\n';
+	}
+
+	auto const world =
+			G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
+	if (world) {
+		os << facility::component::OverlapCache::Hash(world) << '\n';
+	}
+
+	return util::ContentHash::ToString(util::ContentHash::Of(os.str()));
+
+}
+
+void PhysicsTableCache::Prepare() {
+
+	pendingDirectory = "";
+
+	if (!enabled || !physicsList) {
+		return;
+	}
+
+	auto const tableDirectory = directory + "/physics-" + MakeKey();
+
+	if (std::ifstream(tableDirectory + "/" + completeFileName)) {
+		G4cout << "PhysicsTableCache: retrieving the physics tables from "
+				<< tableDirectory << G4endl;
+		physicsList->SetPhysicsTableRetrieved(tableDirectory);
+	} else {
+		pendingDirectory = tableDirectory;
+	}
+
+}
+
+void PhysicsTableCache::Store() {
+
+	if (pendingDirectory.isNull()) {
+		return;
+	}
+
+	::mkdir(directory.c_str(), 0777);
+
+	// the tables are renamed into place complete, so jobs sharing the cache
+	// never retrieve a directory being written
+	std::string temporary = pendingDirectory + ".XXXXXX";
+	if (!::mkdtemp(&temporary[0])) {
+		G4cerr << "PhysicsTableCache: cannot store the physics tables in "
+				<< pendingDirectory << G4endl;
+		pendingDirectory = "";
+		return;
+	}
+
+	if (!physicsList->StorePhysicsTable(temporary)) {
+		G4cerr << "PhysicsTableCache: cannot store the physics tables in "
+				<< pendingDirectory << G4endl;
+		RemoveDirectory(temporary);
+	} else {
+		std::ofstream(temporary + "/" + completeFileName) << description
+				<< '\n';
+		if (std::rename(temporary.c_str(), pendingDirectory.c_str()) == 0) {
+			G4cout << "PhysicsTableCache: the physics tables are stored in "
+					<< pendingDirectory << G4endl;
+		} else {
+			// another job has stored the same tables first
+			G4cout << "PhysicsTableCache: the physics tables are already in "
+					<< pendingDirectory << G4endl;
+			RemoveDirectory(temporary);
+		}
+	}
+
+	pendingDirectory = "";
+
+}
+
+}
+
+}
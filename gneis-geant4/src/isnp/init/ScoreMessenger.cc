@@ -0,0 +1,322 @@
+#include <sstream>
+
+#include "isnp/init/ScoreMessenger.hh"
+#include "isnp/detector/Basic.hh"
+#include "isnp/detector/NextEventAction.hh"
+
+namespace isnp {
+
+namespace init {
+
+#define DIR "/isnp/score/"
+
+namespace quantity {
+
+static G4String const Energy = "energy";
+static G4String const Angle = "angle";
+static G4String const X = "x";
+static G4String const Y = "y";
+static G4String const Time = "time";
+
+static G4String const Candidates = Energy + " " + Angle + " " + X + " " + Y
+		+ " " + Time;
+
+}
+
+namespace scale {
+
+static G4String const Linear = "lin";
+static G4String const Log = "log";
+
+}
+
+static G4String const AllParticles = "all";
+
+static std::unique_ptr<G4UIdirectory> MakeDirectory() {
+
+	auto result = std::make_unique < G4UIdirectory > (DIR);
+	result->SetGuidance("ISNP Scoring Commands");
+	return result;
+
+}
+
+static void AddAxisParameters(G4UIcommand* const command,
+		G4String const& prefix) {
+
+	G4String const q = prefix + "quantity";
+	auto const quantity = new G4UIparameter(q, 's', false);
+	quantity->SetGuidance(
+			"Quantity: energy (MeV), angle to Z axis (deg), x, y (mm), time (ns)");
+	quantity->SetParameterCandidates(quantity::Candidates);
+	command->SetParameter(quantity);
+
+	G4String const b = prefix + "bins";
+	auto const bins = new G4UIparameter(b, 'i', false);
+	bins->SetGuidance("Number of bins");
+	G4String const r = b + " > 0";
+	bins->SetParameterRange(r);
+	command->SetParameter(bins);
+
+	G4String const mn = prefix + "min";
+	auto const min = new G4UIparameter(mn, 'd', false);
+	min->SetGuidance("Lower edge of the first bin");
+	command->SetParameter(min);
+
+	G4String const mx = prefix + "max";
+	auto const max = new G4UIparameter(mx, 'd', false);
+	max->SetGuidance("Upper edge of the last bin");
+	command->SetParameter(max);
+
+	G4String const s = prefix + "scale";
+	auto const scale = new G4UIparameter(s, 's', true);
+	scale->SetGuidance("Binning: lin (default) or log");
+	G4String const c = scale::Linear + " " + scale::Log;
+	scale->SetParameterCandidates(c);
+	scale->SetDefaultValue(scale::Linear);
+	command->SetParameter(scale);
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeHistogram1D(
+		ScoreMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand > (DIR "histogram1D", inst);
+	result->SetGuidance("Define a histogram of hits by one quantity");
+	result->SetGuidance(
+			"  every bin holds a number of hits and the mean and the variance of the value quantity");
+	result->SetToBeBroadcasted(false);
+
+	auto const name = new G4UIparameter("name", 's', false);
+	name->SetGuidance("Histogram name");
+	result->SetParameter(name);
+	AddAxisParameters(result.get(), "");
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeHistogram2D(
+		ScoreMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand > (DIR "histogram2D", inst);
+	result->SetGuidance("Define a histogram of hits by two quantities");
+	result->SetGuidance(
+			"  every bin holds a number of hits and the mean and the variance of the value quantity");
+	result->SetToBeBroadcasted(false);
+
+	auto const name = new G4UIparameter("name", 's', false);
+	name->SetGuidance("Histogram name");
+	result->SetParameter(name);
+	AddAxisParameters(result.get(), "x");
+	AddAxisParameters(result.get(), "y");
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeParticle(ScoreMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand > (DIR "particle", inst);
+	result->SetGuidance("Set a particle counted by the histogram");
+	result->SetToBeBroadcasted(false);
+
+	auto const name = new G4UIparameter("name", 's', false);
+	name->SetGuidance("Histogram name");
+	result->SetParameter(name);
+
+	auto const particle = new G4UIparameter("particle", 's', false);
+	G4String const g = "Particle name or " + AllParticles + " (default)";
+	particle->SetGuidance(g);
+	result->SetParameter(particle);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeValue(ScoreMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand > (DIR "value", inst);
+	result->SetGuidance(
+			"Set a quantity whose mean and variance are accumulated by the histogram bins");
+	result->SetToBeBroadcasted(false);
+
+	auto const name = new G4UIparameter("name", 's', false);
+	name->SetGuidance("Histogram name");
+	result->SetParameter(name);
+
+	auto const quantity = new G4UIparameter("quantity", 's', false);
+	quantity->SetGuidance("Quantity, energy by default");
+	quantity->SetParameterCandidates(quantity::Candidates);
+	result->SetParameter(quantity);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithoutParameter> MakeClear(
+		ScoreMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithoutParameter
+			> (DIR "clear", inst);
+	result->SetGuidance("Remove all the histograms");
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeNextEvent(ScoreMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand > (DIR "nextEvent", inst);
+	result->SetGuidance(
+			"Add a next-event estimator of the neutron flux at a distant detector");
+	result->SetGuidance(
+			"  every neutron emitted in a hadronic interaction contributes a hit of the weight");
+	result->SetGuidance(
+			"  of its probability to reach the detector uncollided, isotropic emission is assumed");
+	result->SetGuidance(
+			"  position is in the beam coordinate system, hits go to <name> detector output");
+	result->SetToBeBroadcasted(false);
+
+	auto const name = new G4UIparameter("name", 's', false);
+	name->SetGuidance("Detector name");
+	result->SetParameter(name);
+
+	for (auto const n : { "x", "y", "z" }) {
+		auto const coordinate = new G4UIparameter(n, 'd', false);
+		coordinate->SetGuidance("Detector position");
+		result->SetParameter(coordinate);
+	}
+
+	auto const radius = new G4UIparameter("radius", 'd', false);
+	radius->SetGuidance(
+			"Radius of a disk across the beam, zero means a point (hit weights are fluence per mm2)");
+	radius->SetParameterRange("radius >= 0");
+	result->SetParameter(radius);
+
+	auto const unit = new G4UIparameter("unit", 's', true);
+	unit->SetGuidance("Length unit");
+	unit->SetDefaultValue("mm");
+	unit->SetParameterCandidates(G4UIcommand::UnitsList("Length"));
+	result->SetParameter(unit);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithoutParameter> MakeClearNextEvent(
+		ScoreMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithoutParameter
+			> (DIR "clearNextEvent", inst);
+	result->SetGuidance("Remove all the next-event estimators");
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+ScoreMessenger::ScoreMessenger() :
+		directory(MakeDirectory()), histogram1DCmd(MakeHistogram1D(this)), histogram2DCmd(
+				MakeHistogram2D(this)), particleCmd(MakeParticle(this)), valueCmd(
+				MakeValue(this)), nextEventCmd(MakeNextEvent(this)), clearCmd(
+				MakeClear(this)), clearNextEventCmd(MakeClearNextEvent(this)) {
+
+}
+
+ScoreMessenger::~ScoreMessenger() {
+
+}
+
+void ScoreMessenger::SetNewValue(G4UIcommand* const command,
+		G4String const newValue) {
+
+	std::istringstream is(newValue);
+	G4String name;
+	is >> name;
+
+	try {
+		if (command == histogram1DCmd.get()) {
+			auto const x = ReadAxis(is);
+			detector::Basic::AddHistogram(detector::Histogram(name, x));
+		} else if (command == histogram2DCmd.get()) {
+			auto const x = ReadAxis(is);
+			auto const y = ReadAxis(is);
+			detector::Basic::AddHistogram(detector::Histogram(name, x, y));
+		} else if (command == particleCmd.get() || command == valueCmd.get()) {
+			auto const histogram = detector::Basic::FindHistogram(name);
+			if (!histogram) {
+				G4cerr << "Unknown histogram: " << name << G4endl;
+				return;
+			}
+
+			G4String v;
+			is >> v;
+			if (command == particleCmd.get()) {
+				histogram->SetParticleName(v == AllParticles ? G4String("") : v);
+			} else {
+				histogram->SetValue(StringToQuantity(v));
+			}
+		} else if (command == clearCmd.get()) {
+			detector::Basic::ClearHistograms();
+		} else if (command == nextEventCmd.get()) {
+			G4double x, y, z, radius;
+			G4String unit;
+			is >> x >> y >> z >> radius >> unit;
+			auto const u = G4UIcommand::ValueOf(unit);
+			detector::NextEventAction::AddPoint(detector::NextEventAction::Point {
+					name, G4ThreeVector(x, y, z) * u, radius * u });
+		} else if (command == clearNextEventCmd.get()) {
+			detector::NextEventAction::ClearPoints();
+		}
+	} catch (detector::Histogram::InvalidAxisException const&) {
+		G4cerr << "Invalid axis of histogram " << name
+				<< ": max must exceed min, min of a log axis must be positive"
+				<< G4endl;
+	}
+
+}
+
+detector::Histogram::Axis ScoreMessenger::ReadAxis(std::istream& is) {
+
+	G4String quantity, scale;
+	std::size_t bins;
+	G4double min, max;
+	is >> quantity >> bins >> min >> max >> scale;
+
+	return detector::Histogram::Axis(StringToQuantity(quantity), bins, min,
+			max, StringToScale(scale));
+
+}
+
+detector::Histogram::Quantity ScoreMessenger::StringToQuantity(
+		G4String const& quantity) {
+
+	if (quantity == quantity::Angle) {
+		return detector::Histogram::Quantity::Angle;
+	} else if (quantity == quantity::X) {
+		return detector::Histogram::Quantity::X;
+	} else if (quantity == quantity::Y) {
+		return detector::Histogram::Quantity::Y;
+	} else if (quantity == quantity::Time) {
+		return detector::Histogram::Quantity::Time;
+	}
+
+	return detector::Histogram::Quantity::Energy;
+
+}
+
+detector::Histogram::Scale ScoreMessenger::StringToScale(
+		G4String const& scale) {
+
+	if (scale == scale::Log) {
+		return detector::Histogram::Scale::Log;
+	}
+
+	return detector::Histogram::Scale::Linear;
+
+}
+
+}
+
+}
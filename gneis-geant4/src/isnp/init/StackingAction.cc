@@ -0,0 +1,134 @@
+#include <G4Neutron.hh>
+
+#include "isnp/init/StackingAction.hh"
+#include "isnp/facility/component/SpallationTarget.hh"
+
+namespace isnp {
+
+namespace init {
+
+std::set<G4String> StackingAction::killed;
+std::map<G4String, G4double> StackingAction::energyFloors;
+G4bool StackingAction::neutronsOnlyOutsideTarget = false;
+
+StackingAction::StackingAction() :
+		numOfNewTracks(0) {
+}
+
+StackingAction::~StackingAction() {
+}
+
+void StackingAction::Kill(G4String const& particleName) {
+
+	killed.insert(particleName);
+
+}
+
+G4bool StackingAction::IsKilled(G4String const& particleName) {
+
+	return killed.count(particleName) > 0;
+
+}
+
+void StackingAction::SetEnergyFloor(G4String const& particleName,
+		G4double const energy) {
+
+	if (energy > 0) {
+		energyFloors[particleName] = energy;
+	} else {
+		energyFloors.erase(particleName);
+	}
+
+}
+
+G4double StackingAction::GetEnergyFloor(G4String const& particleName) {
+
+	auto const it = energyFloors.find(particleName);
+	return it == std::end(energyFloors) ? 0.0 : it->second;
+
+}
+
+void StackingAction::SetNeutronsOnlyOutsideTarget(G4bool const v) {
+
+	neutronsOnlyOutsideTarget = v;
+
+}
+
+void StackingAction::Clear() {
+
+	killed.clear();
+	energyFloors.clear();
+	neutronsOnlyOutsideTarget = false;
+
+}
+
+void StackingAction::Prepare() {
+
+	rules.clear();
+	culled.clear();
+	numOfNewTracks = 0;
+
+}
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(
+		G4Track const* const track) {
+
+	numOfNewTracks++;
+
+	if (track->GetParentID() == 0) {
+		return fUrgent;
+	}
+
+	auto const particle = track->GetParticleDefinition();
+	auto const& rule = RuleOf(particle);
+	auto const energy = track->GetKineticEnergy();
+
+	if (rule.kill || energy < rule.floor
+			|| (neutronsOnlyOutsideTarget && particle != G4Neutron::Definition()
+					&& IsOutsideTarget(track))) {
+		auto& count = culled[particle];
+		count.tracks++;
+		count.energy += energy;
+		return fKill;
+	}
+
+	return fUrgent;
+
+}
+
+StackingAction::Counts StackingAction::GetCulled() const {
+
+	Counts result;
+	for (auto const& c : culled) {
+		result[c.first->GetParticleName()] = c.second;
+	}
+	return result;
+
+}
+
+StackingAction::Rule const& StackingAction::RuleOf(
+		G4ParticleDefinition const* const particle) {
+
+	auto const it = rules.find(particle);
+	if (it != std::end(rules)) {
+		return it->second;
+	}
+
+	auto const& name = particle->GetParticleName();
+	return rules[particle] = Rule { IsKilled(name), GetEnergyFloor(name) };
+
+}
+
+G4bool StackingAction::IsOutsideTarget(G4Track const* const track) const {
+
+	// a secondary is in the volume of its creation
+	auto const volume = track->GetVolume();
+	return volume
+			&& !facility::component::SpallationTarget::GetInstance()->Contains(
+					volume->GetLogicalVolume());
+
+}
+
+}
+
+}
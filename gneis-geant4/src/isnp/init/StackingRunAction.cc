@@ -0,0 +1,74 @@
+#include <G4AutoLock.hh>
+#include <G4Threading.hh>
+#include <G4SystemOfUnits.hh>
+
+#include "isnp/init/StackingRunAction.hh"
+
+namespace isnp {
+
+namespace init {
+
+static G4Mutex totalsMutex = G4MUTEX_INITIALIZER;
+static uint64_t totalNewTracks = 0;
+static StackingAction::Counts totalCulled;
+
+StackingRunAction::StackingRunAction(StackingAction* const anAction) :
+		action(anAction) {
+}
+
+void StackingRunAction::BeginOfRunAction(G4Run const*) {
+
+	if (action) {
+		action->Prepare();
+	}
+
+}
+
+void StackingRunAction::EndOfRunAction(G4Run const*) {
+
+	if (action) {
+		G4AutoLock lock(&totalsMutex);
+
+		totalNewTracks += action->GetNumOfNewTracks();
+		for (auto const& c : action->GetCulled()) {
+			auto& total = totalCulled[c.first];
+			total.tracks += c.second.tracks;
+			total.energy += c.second.energy;
+		}
+	}
+
+	// master's run ends when all the workers have added their counters;
+	// in sequential mode the only thread is the master one
+	if (G4Threading::IsMasterThread()) {
+		Print();
+	}
+
+}
+
+void StackingRunAction::Print() {
+
+	G4AutoLock lock(&totalsMutex);
+
+	if (!totalCulled.empty()) {
+		uint64_t tracks = 0;
+		for (auto const& c : totalCulled) {
+			tracks += c.second.tracks;
+		}
+
+		G4cout << "Stacking: " << tracks << " of " << totalNewTracks
+				<< " new tracks culled" << G4endl;
+		for (auto const& c : totalCulled) {
+			G4cout << "Stacking: " << c.first << ", tracks " << c.second.tracks
+					<< ", kinetic energy " << c.second.energy / MeV << " MeV"
+					<< G4endl;
+		}
+	}
+
+	totalNewTracks = 0;
+	totalCulled.clear();
+
+}
+
+}
+
+}
@@ -0,0 +1,57 @@
+#include <G4AutoLock.hh>
+#include <G4Threading.hh>
+#include <G4Run.hh>
+
+#include "isnp/init/StepCountRunAction.hh"
+
+namespace isnp {
+
+namespace init {
+
+static G4Mutex totalMutex = G4MUTEX_INITIALIZER;
+static uint64_t totalSteps = 0;
+
+StepCountRunAction::StepCountRunAction(CompositeSteppingAction* const anAction) :
+		action(anAction) {
+}
+
+void StepCountRunAction::BeginOfRunAction(G4Run const*) {
+
+	if (action) {
+		action->Prepare();
+		action->ResetNumOfSteps();
+	}
+
+}
+
+void StepCountRunAction::EndOfRunAction(G4Run const* const run) {
+
+	G4AutoLock lock(&totalMutex);
+
+	if (action) {
+		totalSteps += action->GetNumOfSteps();
+	}
+
+	// master's run ends when all the workers have added their steps;
+	// in sequential mode the only thread is the master one
+	if (!G4Threading::IsMasterThread()) {
+		return;
+	}
+
+	if (CompositeSteppingAction::GetCountSteps()) {
+		auto const events = run->GetNumberOfEvent();
+		G4cout << "Steps: " << totalSteps << " in " << events << " events";
+		if (events > 0) {
+			G4cout << ", " << static_cast<G4double>(totalSteps) / events
+					<< " per event";
+		}
+		G4cout << G4endl;
+	}
+
+	totalSteps = 0;
+
+}
+
+}
+
+}
@@ -1,7 +1,12 @@
+#include <sstream>
 #include <string>
 #include "isnp/init/UserActionMessenger.hh"
+#include "isnp/init/ActionInitialization.hh"
+#include "isnp/init/StackingAction.hh"
+#include "isnp/init/CompositeSteppingAction.hh"
 #include "isnp/generator/Spallation.hh"
 #include "isnp/generator/Resampling.hh"
+#include "isnp/generator/Emulator.hh"
 
 namespace isnp {
 
@@ -13,6 +18,7 @@ namespace userAction {
 
 static const G4String Spallation = "spallation";
 static const G4String Resampling = "resampling";
+static const G4String Emulator = "emulator";
 
 }
 
@@ -22,20 +28,120 @@ static std::unique_ptr<G4UIcmdWithAString> MakeUserAction(
 	auto result = std::make_unique < G4UIcmdWithAString > (DIR "gun", inst);
 	result->SetGuidance("Use given ISNP gun: ");
 	std::string const guidance = userAction::Spallation + ", "
-			+ userAction::Resampling;
+			+ userAction::Resampling + ", " + userAction::Emulator;
 	result->SetGuidance(guidance.c_str());
 	result->SetParameterName("name", false);
 	result->AvailableForStates(G4State_PreInit);
 	std::string const candidates = userAction::Spallation + " "
-			+ userAction::Resampling;
+			+ userAction::Resampling + " " + userAction::Emulator;
 	result->SetCandidates(candidates.c_str());
 
 	return result;
 
 }
 
+static std::unique_ptr<G4UIdirectory> MakeStackingDirectory() {
+
+	auto result = std::make_unique < G4UIdirectory > (DIR "stacking/");
+	result->SetGuidance(
+			"ISNP Stacking Commands: dropping particles which are not scored");
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithAString> MakeKill(
+		UserActionMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithAString
+			> (DIR "stacking/kill", inst);
+	result->SetGuidance("Drop all the secondary particles of given type");
+	result->SetParameterName("particle", false);
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcommand> MakeEnergyFloor(
+		UserActionMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcommand
+			> (DIR "stacking/energyFloor", inst);
+	result->SetGuidance(
+			"Drop the secondary particles of given type below the kinetic energy");
+	result->SetGuidance("  zero energy removes the floor");
+	result->SetToBeBroadcasted(false);
+
+	auto const particle = new G4UIparameter("particle", 's', false);
+	particle->SetGuidance("Particle name");
+	result->SetParameter(particle);
+
+	auto const energy = new G4UIparameter("energy", 'd', false);
+	energy->SetGuidance("Kinetic energy");
+	energy->SetParameterRange("energy >= 0");
+	result->SetParameter(energy);
+
+	auto const unit = new G4UIparameter("unit", 's', true);
+	unit->SetGuidance("Energy unit");
+	unit->SetDefaultValue("MeV");
+	unit->SetParameterCandidates(G4UIcommand::UnitsList("Energy"));
+	result->SetParameter(unit);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithABool> MakeNeutronsOutsideTarget(
+		UserActionMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithABool
+			> (DIR "stacking/neutronsOutsideTarget", inst);
+	result->SetGuidance(
+			"Drop all the secondary particles but neutrons created outside the spallation target");
+	result->SetGuidance("Choice : true, 1, false, 0");
+	result->SetParameterName("value", true);
+	result->SetDefaultValue("true");
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithoutParameter> MakeClearStacking(
+		UserActionMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithoutParameter
+			> (DIR "stacking/clear", inst);
+	result->SetGuidance(
+			"Clear the kill list and the energy floors, turn off the neutrons only mode");
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
+static std::unique_ptr<G4UIcmdWithABool> MakeCountSteps(
+		UserActionMessenger* const inst) {
+
+	auto result = std::make_unique < G4UIcmdWithABool
+			> (DIR "countSteps", inst);
+	result->SetGuidance(
+			"Print the number of steps per event at the end of every run");
+	result->SetGuidance("Choice : true, 1, false, 0");
+	result->SetParameterName("value", true);
+	result->SetDefaultValue("true");
+	result->SetToBeBroadcasted(false);
+
+	return result;
+
+}
+
 UserActionMessenger::UserActionMessenger(G4RunManager& aRunManager) :
-		runManager(aRunManager), userActionCmd(MakeUserAction(this)), userAction(
+		runManager(aRunManager), userActionCmd(MakeUserAction(this)), stackingDirectory(
+				MakeStackingDirectory()), killCmd(MakeKill(this)), energyFloorCmd(
+				MakeEnergyFloor(this)), neutronsOutsideTargetCmd(
+				MakeNeutronsOutsideTarget(this)), clearStackingCmd(
+				MakeClearStacking(this)), countStepsCmd(MakeCountSteps(this)), userAction(
 				"") {
 
 }
@@ -50,6 +156,12 @@ G4String UserActionMessenger::GetCurrentValue(G4UIcommand* const command) {
 
 	if (command == userActionCmd.get()) {
 		ans = userAction;
+	} else if (command == neutronsOutsideTargetCmd.get()) {
+		ans = neutronsOutsideTargetCmd->ConvertToString(
+				StackingAction::GetNeutronsOnlyOutsideTarget());
+	} else if (command == countStepsCmd.get()) {
+		ans = countStepsCmd->ConvertToString(
+				CompositeSteppingAction::GetCountSteps());
 	}
 
 	return ans;
@@ -61,19 +173,48 @@ void UserActionMessenger::SetNewValue(G4UIcommand* const command,
 
 	if (command == userActionCmd.get()) {
 		SetUserAction(newValue);
+	} else if (command == killCmd.get()) {
+		StackingAction::Kill(newValue);
+	} else if (command == energyFloorCmd.get()) {
+		std::istringstream is(newValue);
+		G4String particle, unit;
+		G4double energy;
+		is >> particle >> energy >> unit;
+		StackingAction::SetEnergyFloor(particle,
+				energy * G4UIcommand::ValueOf(unit));
+	} else if (command == neutronsOutsideTargetCmd.get()) {
+		StackingAction::SetNeutronsOnlyOutsideTarget(
+				G4UIcmdWithABool::GetNewBoolValue(newValue));
+	} else if (command == clearStackingCmd.get()) {
+		StackingAction::Clear();
+	} else if (command == countStepsCmd.get()) {
+		CompositeSteppingAction::SetCountSteps(
+				G4UIcmdWithABool::GetNewBoolValue(newValue));
 	}
 
 }
 
 void UserActionMessenger::SetUserAction(G4String const& name) {
 
+	ActionInitialization::GeneratorFactory factory;
+
 	if (name == userAction::Spallation) {
 
-		runManager.SetUserAction(new isnp::generator::Spallation);
+		factory = [] {
+			return new isnp::generator::Spallation;
+		};
 
 	} else if (name == userAction::Resampling) {
 
-		runManager.SetUserAction(new isnp::generator::Resampling);
+		factory = [] {
+			return new isnp::generator::Resampling;
+		};
+
+	} else if (name == userAction::Emulator) {
+
+		factory = [] {
+			return new isnp::generator::Emulator;
+		};
 
 	} else {
 
@@ -82,6 +223,8 @@ void UserActionMessenger::SetUserAction(G4String const& name) {
 
 	}
 
+	// every worker thread gets its own gun
+	runManager.SetUserInitialization(new ActionInitialization(factory));
 	userAction = name;
 
 }
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <thread>
+
+#include <Randomize.hh>
+
+#include "isnp/util/AliasTable.hh"
+
+namespace isnp {
+
+namespace util {
+
+AliasTable::size_type const AliasTable::DefaultChunkSize;
+
+AliasTable::AliasTable(G4float const* const weights, size_type const size,
+		size_type const aChunkSize, unsigned const numOfThreads) :
+		chunkSize(std::max<size_type>(std::min<size_type>(aChunkSize, UINT32_MAX), 1)), entries(
+				size), totalWeight(0) {
+
+	auto const numOfChunks = (size + chunkSize - 1) / chunkSize;
+	std::vector<G4double> chunkWeights(numOfChunks);
+
+	auto const hardware = std::max(std::thread::hardware_concurrency(), 1u);
+	auto const numOfWorkers = std::min<size_type>(numOfChunks,
+			numOfThreads > 0 ? numOfThreads : hardware);
+
+	// chunks are distributed among the workers round-robin
+	auto const worker = [&](size_type const first) {
+		for (auto c = first; c < numOfChunks; c += numOfWorkers) {
+			auto const begin = c * chunkSize;
+			auto const count = std::min(chunkSize, size - begin);
+			chunkWeights[c] = Build(weights + begin, count, entries.data() + begin);
+		}
+	};
+
+	std::vector<std::future<void>> futures;
+	for (size_type i = 1; i < numOfWorkers; i++) {
+		futures.push_back(std::async(std::launch::async, worker, i));
+	}
+	if (numOfWorkers > 0) {
+		worker(0);
+	}
+	for (auto& f : futures) {
+		f.get();
+	}
+
+	chunkEntries.resize(numOfChunks);
+	totalWeight = Build(chunkWeights.data(), numOfChunks, chunkEntries.data());
+	if (!(totalWeight > 0)) {
+		throw InvalidWeightException();
+	}
+
+}
+
+AliasTable::size_type AliasTable::Shoot() const {
+
+	auto const engine = CLHEP::HepRandom::getTheEngine();
+	auto const u = engine->flat();
+	return Sample(u, chunkEntries.size() > 1 ? engine->flat() : 0.0);
+
+}
+
+AliasTable::size_type AliasTable::Sample(G4double const u,
+		G4double const v) const {
+
+	if (chunkEntries.size() == 1) {
+		return Pick(entries.data(), entries.size(), u);
+	}
+
+	auto const c = Pick(chunkEntries.data(), chunkEntries.size(), u);
+	auto const begin = c * chunkSize;
+	return begin
+			+ Pick(entries.data() + begin,
+					std::min(chunkSize, entries.size() - begin), v);
+
+}
+
+template<typename T>
+G4double AliasTable::Build(T const* const weights, size_type const size,
+		Entry* const result) {
+
+	G4double sum = 0;
+	for (size_type i = 0; i < size; i++) {
+		G4double const w = weights[i];
+		if (!(w >= 0) || !std::isfinite(w)) {
+			throw InvalidWeightException();
+		}
+		sum += w;
+	}
+
+	if (!(sum > 0) || !std::isfinite(sum)) {
+		for (size_type i = 0; i < size; i++) {
+			result[i] = Entry { 1.0f, static_cast<uint32_t>(i) };
+		}
+		return sum;
+	}
+
+	// weights scaled so that their mean is one
+	std::vector<G4double> scaled(size);
+	std::vector<uint32_t> small, large;
+	for (size_type i = 0; i < size; i++) {
+		scaled[i] = weights[i] * size / sum;
+		(scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+	}
+
+	while (!small.empty() && !large.empty()) {
+		auto const s = small.back();
+		small.pop_back();
+		auto const l = large.back();
+
+		result[s] = Entry { static_cast<G4float>(scaled[s]), l };
+		scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+		if (scaled[l] < 1.0) {
+			large.pop_back();
+			small.push_back(l);
+		}
+	}
+
+	// remaining slots are full up to rounding errors
+	for (auto const i : large) {
+		result[i] = Entry { 1.0f, i };
+	}
+	for (auto const i : small) {
+		result[i] = Entry { 1.0f, i };
+	}
+
+	return sum;
+
+}
+
+AliasTable::size_type AliasTable::Pick(Entry const* const table,
+		size_type const size, G4double const u) {
+
+	// integer part of u * size selects a slot, fractional part tosses the coin
+	auto const x = u * size;
+	auto const slot = std::min(static_cast<size_type>(x), size - 1);
+	auto const& entry = table[slot];
+	return x - slot < entry.probability ? slot : entry.alias;
+
+}
+
+}
+
+}
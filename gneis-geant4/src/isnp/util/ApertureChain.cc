@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "isnp/util/ApertureChain.hh"
+
+namespace isnp {
+
+namespace util {
+
+void ApertureChain::Clear() {
+
+	apertures.clear();
+
+}
+
+void ApertureChain::AddRectangle(G4double const z, G4double const length,
+		G4double const width, G4double const height) {
+
+	apertures.push_back(Aperture { z + length, width / 2, height / 2, false });
+
+}
+
+void ApertureChain::AddCircle(G4double const z, G4double const length,
+		G4double const diameter) {
+
+	apertures.push_back(
+			Aperture { z + length, diameter / 2, diameter / 2, true });
+
+}
+
+void ApertureChain::RemoveBeyond(G4double const z) {
+
+	apertures.erase(
+			std::remove_if(std::begin(apertures), std::end(apertures),
+					[z](Aperture const& a) {
+						return a.end > z;
+					}), std::end(apertures));
+
+}
+
+G4bool ApertureChain::IsInCone(G4ThreeVector const& direction,
+		G4double const spotHalfWidth, G4double const spotHalfHeight) const {
+
+	if (apertures.empty()) {
+		return true;
+	}
+
+	if (!(direction.getZ() > 0)) {
+		return false;
+	}
+
+	auto const sx = std::fabs(direction.getX() / direction.getZ());
+	auto const sy = std::fabs(direction.getY() / direction.getZ());
+	auto const spotRadius = std::hypot(spotHalfWidth, spotHalfHeight);
+
+	// the far end of an aperture is the narrowest place for a straight line
+	// coming from the spot
+	for (auto const& a : apertures) {
+		if (a.round) {
+			if (std::hypot(sx, sy) * a.end > a.halfWidth + spotRadius) {
+				return false;
+			}
+		} else if (sx * a.end > a.halfWidth + spotHalfWidth
+				|| sy * a.end > a.halfHeight + spotHalfHeight) {
+			return false;
+		}
+	}
+
+	return true;
+
+}
+
+G4String ApertureChain::ToString() const {
+
+	std::ostringstream os;
+	os.precision(10);
+	char const* separator = "";
+	for (auto const& a : apertures) {
+		os << separator << (a.round ? "circle " : "rectangle ") << a.end << ' '
+				<< a.halfWidth << ' ' << a.halfHeight;
+		separator = " ";
+	}
+	return os.str();
+
+}
+
+}
+
+}
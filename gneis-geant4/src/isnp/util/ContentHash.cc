@@ -0,0 +1,31 @@
+#include <iomanip>
+#include <sstream>
+
+#include "isnp/util/ContentHash.hh"
+
+namespace isnp {
+
+namespace util {
+
+uint64_t ContentHash::Of(std::string const& text) {
+
+	uint64_t result = 14695981039346656037ULL;
+	for (auto const c : text) {
+		result ^= static_cast<unsigned char>(c);
+		result *= 1099511628211ULL;
+	}
+	return result;
+
+}
+
+G4String ContentHash::ToString(uint64_t const hash) {
+
+	std::ostringstream os;
+	os << std::hex << std::setw(16) << std::setfill('0') << hash;
+	return os.str();
+
+}
+
+}
+
+}
@@ -6,6 +6,25 @@ namespace util {
 
 static G4String const NO_NAME = "";
 
+void DataFrame::DataPack::AddFloatColumn(G4String const& columnName,
+		FloatVector&& v) {
+
+	floatVectors.push_back(std::move(v));
+	auto const& stored = floatVectors.back();
+	floatColumns[columnName] = FloatColumnView(stored.data(), stored.size());
+
+}
+
+void DataFrame::DataPack::AddCategoryColumn(G4String const& columnName,
+		CategoryVector&& v) {
+
+	categoryVectors.push_back(std::move(v));
+	auto const& stored = categoryVectors.back();
+	categoryColumns[columnName] = CategoryColumnView(stored.data(),
+			stored.size());
+
+}
+
 DataFrame::DataFrame(DataFrame&& aDataFrame) :
 		data(std::move(aDataFrame.data)) {
 }
@@ -15,6 +34,10 @@ DataFrame::DataFrame(std::unique_ptr<DataPack> aData) :
 
 }
 
+DataFrame::~DataFrame() {
+
+}
+
 DataFrame::size_type DataFrame::Size() const {
 
 	return data->floatColumns.empty() ?
@@ -30,7 +53,7 @@ G4String const& DataFrame::CategoryName(const G4String& columnName,
 		throw NoSuchColumnException();
 	}
 
-	auto const nameMap = it->second;
+	auto const& nameMap = it->second;
 	auto const nameit = nameMap.find(id);
 	if (nameit == nameMap.cend()) {
 		return NO_NAME;
@@ -40,7 +63,7 @@ G4String const& DataFrame::CategoryName(const G4String& columnName,
 
 }
 
-const DataFrame::CategoryVector& DataFrame::CategoryColumn(
+DataFrame::CategoryColumnView const& DataFrame::CategoryColumn(
 		const G4String& columnName) const {
 
 	auto const it = data->categoryColumns.find(columnName);
@@ -52,7 +75,7 @@ const DataFrame::CategoryVector& DataFrame::CategoryColumn(
 
 }
 
-const DataFrame::FloatVector& DataFrame::FloatColumn(
+DataFrame::FloatColumnView const& DataFrame::FloatColumn(
 		const G4String& columnName) const {
 
 	auto const it = data->floatColumns.find(columnName);
@@ -64,6 +87,12 @@ const DataFrame::FloatVector& DataFrame::FloatColumn(
 
 }
 
+bool DataFrame::HasFloatColumn(const G4String& columnName) const {
+
+	return data->floatColumns.count(columnName) > 0;
+
+}
+
 unsigned DataFrame::Precision(const G4String& columnName) const {
 
 	auto const it = data->precisions.find(columnName);
@@ -75,6 +104,12 @@ unsigned DataFrame::Precision(const G4String& columnName) const {
 
 }
 
+bool DataFrame::IsMapped() const {
+
+	return static_cast<bool>(data->mapping);
+
+}
+
 }
 
 }
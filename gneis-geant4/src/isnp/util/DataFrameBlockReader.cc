@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <cctype>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "isnp/util/DataFrameBlockReader.hh"
+#include "isnp/util/DataFrameLoader.hh"
+
+namespace isnp {
+
+namespace util {
+
+/**
+ * Size of the buffer used to index a text file.
+ */
+static std::size_t const IndexBufferSize = 1 << 20;
+
+DataFrameBlockReader::DataFrameBlockReader(G4String const& fileName,
+		std::set<G4String> const& aFloatColumns,
+		std::set<G4String> const& aCategoryColumns, size_type const aBlockSize,
+		std::set<G4String> const& anOptionalFloatColumns) :
+		floatColumns(aFloatColumns), categoryColumns(aCategoryColumns), optionalFloatColumns(
+				anOptionalFloatColumns), blockSize(
+				std::max<size_type>(aBlockSize, 1)), fd(-1), fileSize(0), binary(
+				false), numOfRows(0) {
+
+	fd = ::open(fileName.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw DataFrameLoader::FileException();
+	}
+
+	try {
+		struct stat st;
+		if (::fstat(fd, &st) != 0) {
+			throw DataFrameLoader::FileException();
+		}
+		fileSize = st.st_size;
+
+		binary = DataFrameFormat::IsBinary(fileName);
+		if (binary) {
+			frames = DataFrameFormat::ReadFrames(
+					[this](uint64_t const offset, void* const buffer,
+							std::size_t const size) {
+						ReadAt(offset, buffer, size);
+					}, fileSize);
+			numOfRows = frames.rowCount;
+			auto const& directory = frames.directories[0];
+
+			for (auto const& c : floatColumns) {
+				if (std::none_of(std::begin(directory.columns),
+						std::end(directory.columns), [&c](auto const& column) {
+							return column.name == c
+							&& column.type == DataFrameFormat::ColumnType::Float;
+						})) {
+					throw DataFrameLoader::NoColumnException(c);
+				}
+			}
+
+			for (auto const& c : categoryColumns) {
+				if (std::none_of(std::begin(directory.columns),
+						std::end(directory.columns), [&c](auto const& column) {
+							return column.name == c
+							&& column.type == DataFrameFormat::ColumnType::Category;
+						})) {
+					throw DataFrameLoader::NoColumnException(c);
+				}
+			}
+		} else {
+			IndexText();
+		}
+	} catch (...) {
+		::close(fd);
+		throw;
+	}
+
+}
+
+DataFrameBlockReader::~DataFrameBlockReader() {
+
+	::close(fd);
+
+}
+
+DataFrame DataFrameBlockReader::Read(size_type const blockNo) const {
+
+	return binary ? ReadBinary(blockNo) : ReadText(blockNo);
+
+}
+
+std::vector<G4double> DataFrameBlockReader::SumByBlocks(
+		G4String const& columnName) const {
+
+	std::vector<G4double> result;
+	for (size_type blockNo = 0; blockNo < GetNumOfBlocks(); blockNo++) {
+		auto const block = Read(blockNo);
+		if (!block.HasFloatColumn(columnName)) {
+			return std::vector<G4double>();
+		}
+
+		auto const& column = block.FloatColumn(columnName);
+		G4double sum = 0;
+		for (size_type i = 0; i < block.Size(); i++) {
+			sum += column[i];
+		}
+		result.push_back(sum);
+	}
+
+	return result;
+
+}
+
+void DataFrameBlockReader::ReadAt(uint64_t offset, void* const buffer,
+		std::size_t size) const {
+
+	auto p = static_cast<char*>(buffer);
+	while (size > 0) {
+		auto const n = ::pread(fd, p, size, offset);
+		if (n <= 0) {
+			throw DataFrameFormat::FormatException();
+		}
+		p += n;
+		offset += n;
+		size -= n;
+	}
+
+}
+
+void DataFrameBlockReader::IndexText() {
+
+	// state of the current line
+	enum class Line {
+		Spaces, Data, Skipped
+	};
+
+	std::vector<char> buffer(IndexBufferSize);
+	std::string firstRow;
+	size_type numOfLines = 0;
+	uint64_t lineStart = 0;
+	auto state = Line::Spaces;
+
+	for (uint64_t offset = 0; offset < fileSize;) {
+		std::size_t const n = std::min<uint64_t>(buffer.size(),
+				fileSize - offset);
+		ReadAt(offset, buffer.data(), n);
+
+		for (std::size_t i = 0; i < n; i++) {
+			char const ch = buffer[i];
+
+			if (ch == '\n') {
+				if (state == Line::Data) {
+					numOfLines++;
+				}
+				state = Line::Spaces;
+				lineStart = offset + i + 1;
+				continue;
+			}
+
+			if (state == Line::Spaces && !std::isspace(ch)) {
+				state = ch == '#' ? Line::Skipped : Line::Data;
+				if (state == Line::Data && numOfLines > 0
+						&& (numOfLines - 1) % blockSize == 0) {
+					blockOffsets.push_back(lineStart);
+				}
+			}
+
+			// the column names and the first row are kept
+			if (state == Line::Data && numOfLines == 0) {
+				header.push_back(ch);
+			} else if (state == Line::Data && numOfLines == 1) {
+				firstRow.push_back(ch);
+			}
+		}
+
+		offset += n;
+	}
+
+	if (state == Line::Data) {
+		numOfLines++;
+	}
+
+	numOfRows = numOfLines > 0 ? numOfLines - 1 : 0;
+
+	// check the columns and detect the precision exactly as the loader does
+	header.push_back('\n');
+	auto const text = header + firstRow;
+	DataFrameLoader loader(floatColumns, categoryColumns, optionalFloatColumns);
+	loader.SetNumOfThreads(1);
+	auto const df = loader.load(text.data(), text.data() + text.size());
+	precisions = df.data->precisions;
+
+}
+
+DataFrame DataFrameBlockReader::ReadBinary(size_type const blockNo) const {
+
+	auto const first = std::min(blockNo * blockSize, numOfRows);
+	auto const count = std::min(blockSize, numOfRows - first);
+	auto data = std::make_unique<DataFrame::DataPack>();
+
+	auto const read = [this](uint64_t const offset, void* const buffer,
+			std::size_t const size) {
+		ReadAt(offset, buffer, size);
+	};
+
+	auto const& columns = frames.directories[0].columns;
+	for (std::size_t i = 0; i < columns.size(); i++) {
+		auto const& column = columns[i];
+
+		if (column.type == DataFrameFormat::ColumnType::Float
+				&& (floatColumns.count(column.name)
+						|| optionalFloatColumns.count(column.name))) {
+			DataFrame::FloatVector v(count);
+			frames.ReadColumn(read, i, first, count, v.data());
+			data->AddFloatColumn(column.name, std::move(v));
+			data->precisions[column.name] = column.precision;
+		} else if (column.type == DataFrameFormat::ColumnType::Category
+				&& categoryColumns.count(column.name)) {
+			DataFrame::CategoryVector v(count);
+			frames.ReadColumn(read, i, first, count, v.data());
+			data->AddCategoryColumn(column.name, std::move(v));
+			data->categoryNames[column.name] = frames.categoryNames.at(
+					column.name);
+		}
+	}
+
+	return DataFrame(std::move(data));
+
+}
+
+DataFrame DataFrameBlockReader::ReadText(size_type const blockNo) const {
+
+	auto const begin = blockOffsets.at(blockNo);
+	auto const end =
+			blockNo + 1 < blockOffsets.size() ?
+					blockOffsets[blockNo + 1] : fileSize;
+
+	std::string text(header);
+	text.resize(header.size() + (end - begin));
+	ReadAt(begin, &text[header.size()], end - begin);
+
+	DataFrameLoader loader(floatColumns, categoryColumns, optionalFloatColumns);
+	loader.SetNumOfThreads(1);
+	auto result = loader.load(text.data(), text.data() + text.size());
+	result.data->precisions = precisions;
+
+	return result;
+
+}
+
+}
+
+}
@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <fstream>
+
+#include "isnp/util/DataFrameFormat.hh"
+
+namespace isnp {
+
+namespace util {
+
+char const DataFrameFormat::Magic[8] = { 'I', 'S', 'N', 'P', 'D', 'F',
+		'\x1a', '\0' };
+uint32_t const DataFrameFormat::ByteOrder = 0x01020304;
+uint32_t const DataFrameFormat::Version = 1;
+std::size_t const DataFrameFormat::DataAlignment = 64;
+std::size_t const DataFrameFormat::MaxCategories = std::size_t(
+		std::numeric_limits<DataFrame::CategoryId>::max()) + 1;
+
+std::size_t DataFrameFormat::Align(std::size_t const offset) {
+
+	return (offset + DataAlignment - 1) / DataAlignment * DataAlignment;
+
+}
+
+std::size_t DataFrameFormat::ElementSize(ColumnType const type) {
+
+	switch (type) {
+	case ColumnType::Category:
+		return sizeof(DataFrame::CategoryId);
+
+	case ColumnType::Integer:
+		return sizeof(int32_t);
+
+	default:
+		return sizeof(G4float);
+	}
+
+}
+
+DataFrameFormat::Directory DataFrameFormat::ReadDirectory(Reader const& read,
+		uint64_t const fileSize, uint64_t const frameOffset) {
+
+	uint64_t pos = frameOffset;
+	auto const readString = [&read, &pos](std::size_t const length) {
+		std::string result(length, '\0');
+		read(pos, &result[0], length);
+		pos += length;
+		return G4String(result);
+	};
+
+	Header header;
+	read(pos, &header, sizeof(header));
+	pos += sizeof(header);
+	if (std::memcmp(header.magic, Magic, sizeof(header.magic)) != 0
+			|| header.byteOrder != ByteOrder || header.version != Version) {
+		throw FormatException();
+	}
+
+	Directory result;
+	result.rowCount = header.rowCount;
+	uint64_t frameEnd = 0;
+
+	for (uint32_t i = 0; i < header.columnCount; i++) {
+		ColumnEntry entry;
+		read(pos, &entry, sizeof(entry));
+		pos += sizeof(entry);
+
+		Column column;
+		column.name = readString(entry.nameLength);
+		column.type = static_cast<ColumnType>(entry.type);
+		column.precision = entry.precision;
+		column.dataOffset = frameOffset + entry.dataOffset;
+
+		for (uint32_t j = 0; j < entry.categoryCount; j++) {
+			CategoryEntry category;
+			read(pos, &category, sizeof(category));
+			pos += sizeof(category);
+			column.categoryNames[category.id] = readString(
+					category.nameLength);
+		}
+
+		if (column.type != ColumnType::Float
+				&& column.type != ColumnType::Category
+				&& column.type != ColumnType::Integer) {
+			throw FormatException();
+		}
+
+		if (column.dataOffset % DataAlignment != 0
+				|| column.dataOffset > fileSize
+				|| header.rowCount
+						> (fileSize - column.dataOffset)
+								/ ElementSize(column.type)) {
+			throw FormatException();
+		}
+
+		frameEnd = std::max<uint64_t>(frameEnd,
+				column.dataOffset
+						+ header.rowCount * ElementSize(column.type));
+		result.columns.push_back(std::move(column));
+	}
+
+	result.endOffset = Align(std::max(frameEnd, pos));
+
+	return result;
+
+}
+
+DataFrameFormat::Frames DataFrameFormat::ReadFrames(Reader const& read,
+		uint64_t const fileSize) {
+
+	Frames result;
+	result.rowCount = 0;
+
+	uint64_t offset = 0;
+	do {
+		auto directory = ReadDirectory(read, fileSize, offset);
+		offset = directory.endOffset;
+
+		auto const& first =
+				result.directories.empty() ? directory : result.directories[0];
+		if (directory.columns.size() != first.columns.size()) {
+			throw FormatException();
+		}
+
+		for (std::size_t i = 0; i < directory.columns.size(); i++) {
+			auto const& column = directory.columns[i];
+			if (column.name != first.columns[i].name
+					|| column.type != first.columns[i].type) {
+				throw FormatException();
+			}
+
+			if (column.type == ColumnType::Category) {
+				auto& names = result.categoryNames[column.name];
+				std::vector<DataFrame::CategoryId> ids(MaxCategories);
+				for (std::size_t id = 0; id < ids.size(); id++) {
+					ids[id] = id;
+				}
+
+				for (auto const& n : column.categoryNames) {
+					auto const it = std::find_if(std::begin(names),
+							std::end(names), [&n](auto const& m) {
+								return m.second == n.second;
+							});
+					if (it != std::end(names)) {
+						ids[n.first] = it->first;
+					} else if (names.size() < MaxCategories) {
+						// first frame keeps its ids, new names take free ones
+						std::size_t id = result.directories.empty() ? n.first : 0;
+						while (names.count(id)) {
+							id++;
+						}
+						names[id] = n.second;
+						ids[n.first] = id;
+					} else {
+						throw FormatException();
+					}
+				}
+
+				result.categoryIds[column.name].push_back(std::move(ids));
+			}
+		}
+
+		result.firstRows.push_back(result.rowCount);
+		result.rowCount += directory.rowCount;
+		result.directories.push_back(std::move(directory));
+	} while (offset < fileSize);
+
+	return result;
+
+}
+
+void DataFrameFormat::Frames::ReadColumn(Reader const& read,
+		std::size_t const columnNo, uint64_t const first,
+		std::size_t const count, void* const buffer) const {
+
+	auto const& name = directories.at(0).columns.at(columnNo).name;
+	auto const type = directories[0].columns[columnNo].type;
+	auto const elementSize = ElementSize(type);
+	auto const dest = static_cast<char*>(buffer);
+
+	// the frame containing the first row
+	auto frameNo = std::upper_bound(std::begin(firstRows),
+			std::end(firstRows), first) - std::begin(firstRows) - 1;
+
+	for (std::size_t done = 0; done < count; frameNo++) {
+		auto const& directory = directories.at(frameNo);
+		auto const row = first + done - firstRows[frameNo];
+		auto const n = std::min<uint64_t>(count - done,
+				directory.rowCount - row);
+
+		read(directory.columns[columnNo].dataOffset + row * elementSize,
+				dest + done * elementSize, n * elementSize);
+
+		if (type == ColumnType::Category) {
+			auto const& ids = categoryIds.at(name)[frameNo];
+			auto const values = reinterpret_cast<DataFrame::CategoryId*>(dest)
+					+ done;
+			for (std::size_t i = 0; i < n; i++) {
+				values[i] = ids[values[i]];
+			}
+		}
+
+		done += n;
+	}
+
+}
+
+bool DataFrameFormat::IsBinary(std::istream& is) {
+
+	char buf[sizeof(Magic)];
+
+	auto const pos = is.tellg();
+	is.read(buf, sizeof(buf));
+	bool const result = is.gcount() == sizeof(buf)
+			&& std::equal(std::begin(buf), std::end(buf), std::begin(Magic));
+	is.clear();
+	is.seekg(pos);
+
+	return result;
+
+}
+
+bool DataFrameFormat::IsBinary(G4String const& fileName) {
+
+	std::ifstream f(fileName, std::ios::binary);
+	return f && IsBinary(f);
+
+}
+
+}
+
+}
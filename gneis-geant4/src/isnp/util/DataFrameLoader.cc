@@ -1,25 +1,58 @@
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include "isnp/util/DataFrameLoader.hh"
+#include "isnp/util/MappedFile.hh"
 
 namespace isnp {
 
 namespace util {
 
-static inline void ltrim(std::string &s) {
-	s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](int ch) {
-		return !std::isspace(ch);
-	}));
+namespace {
+
+typedef std::pair<char const*, char const*> Token;
+typedef std::vector<Token> TokenVector;
+
+/**
+ * Minimal size of a chunk parsed by a separate thread.
+ */
+std::size_t const MinChunkSize = 1 << 20;
+
+inline char const* lineEnd(char const* const begin, char const* const end) {
+
+	auto const result = static_cast<char const*>(std::memchr(begin, '\n',
+			end - begin));
+	return result ? result : end;
+
 }
 
-static std::vector<std::string> tokenize(const std::string& s, char const c) {
+inline char const* ltrim(char const* begin, char const* const end) {
+
+	while (begin != end && std::isspace(*begin)) {
+		++begin;
+	}
+	return begin;
 
-	auto end = s.cend();
+}
+
+/**
+ * Splits the line by the separator, empty tokens are skipped.
+ * Tokens refer to the line, so no memory is allocated once the vector has grown.
+ */
+void tokenize(char const* const begin, char const* const end, char const c,
+		TokenVector& v) {
+
+	v.clear();
 	auto start = end;
 
-	std::vector<std::string> v;
-	for (auto it = s.cbegin(); it != end; ++it) {
+	for (auto it = begin; it != end; ++it) {
 		if (*it != c) {
 			if (start == end) {
 				start = it;
@@ -36,17 +69,160 @@ static std::vector<std::string> tokenize(const std::string& s, char const c) {
 		v.emplace_back(start, end);
 	}
 
-	return v;
-
 }
 
-static unsigned detectPrecision(std::string const& s) {
-	auto const p = std::find_if(std::begin(s), std::end(s), [](auto ch) {
+unsigned detectPrecision(Token const& s) {
+	auto const p = std::find_if(s.first, s.second, [](auto ch) {
 		return ch == 'e' || ch == 'E';
 	});
-	auto const result = std::distance(std::begin(s), p);
-	auto const dp = std::find(std::begin(s), p, '.');
-	return dp == std::end(s) ? result : result - 1;
+	auto const result = std::distance(s.first, p);
+	auto const dp = std::find(s.first, p, '.');
+	return dp == s.second ? result : result - 1;
+}
+
+/**
+ * Converts the token to float exactly as std::stof does, including the exceptions thrown.
+ */
+G4float parseFloat(Token const& s) {
+
+	char buf[64];
+	std::string longToken;
+	char const* str;
+
+	std::size_t const len = s.second - s.first;
+	if (len < sizeof(buf)) {
+		std::memcpy(buf, s.first, len);
+		buf[len] = '\0';
+		str = buf;
+	} else {
+		longToken.assign(s.first, s.second);
+		str = longToken.c_str();
+	}
+
+	char* endptr;
+	errno = 0;
+	auto const result = std::strtof(str, &endptr);
+	if (endptr == str) {
+		throw std::invalid_argument("stof");
+	}
+	if (errno == ERANGE) {
+		throw std::out_of_range("stof");
+	}
+
+	return result;
+
+}
+
+/**
+ * Part of the text which is parsed independently.
+ * Category values get chunk-local ids which are remapped when chunks are merged.
+ */
+struct Chunk {
+
+	char const* begin;
+	char const* end;
+
+	std::size_t numOfRows = 0;
+	std::vector<std::vector<G4float>> floats;
+	std::vector<std::vector<DataFrame::CategoryId>> categories;
+	std::vector<std::vector<std::string>> dictionaries;
+	std::vector<std::vector<DataFrame::CategoryId>> idMaps;
+
+	// the first error of the chunk
+	std::exception_ptr error;
+	std::size_t errorIndex = 0;
+	unsigned errorLine = 0;
+
+};
+
+DataFrame::CategoryId localId(std::vector<std::string>& dictionary,
+		Token const& value) {
+
+	std::size_t const len = value.second - value.first;
+	for (std::size_t i = 0; i < dictionary.size(); i++) {
+		auto const& s = dictionary[i];
+		if (s.size() == len && std::memcmp(s.data(), value.first, len) == 0) {
+			return static_cast<DataFrame::CategoryId>(i);
+		}
+	}
+
+	dictionary.emplace_back(value.first, value.second);
+	return static_cast<DataFrame::CategoryId>(dictionary.size() - 1);
+
+}
+
+void parseChunk(Chunk& chunk, char const separatorChar, char const commentChar,
+		std::vector<std::size_t> const& categoryIndices,
+		std::vector<std::size_t> const& floatIndices) {
+
+	TokenVector v;
+	unsigned lineNo = 0;
+
+	try {
+		for (auto pos = chunk.begin; pos < chunk.end;) {
+			auto const eol = lineEnd(pos, chunk.end);
+			auto const line = ltrim(pos, eol);
+			pos = eol + 1;
+			lineNo++;
+
+			if (line == eol || *line == commentChar) {
+				continue;
+			}
+
+			tokenize(line, eol, separatorChar, v);
+
+			for (std::size_t i = 0; i < categoryIndices.size(); i++) {
+				auto const idx = categoryIndices[i];
+				if (idx >= v.size()) {
+					chunk.errorIndex = idx;
+					chunk.errorLine = lineNo;
+					return;
+				}
+
+				chunk.categories[i].push_back(
+						localId(chunk.dictionaries[i], v[idx]));
+			}
+
+			for (std::size_t i = 0; i < floatIndices.size(); i++) {
+				auto const idx = floatIndices[i];
+				if (idx >= v.size()) {
+					chunk.errorIndex = idx;
+					chunk.errorLine = lineNo;
+					return;
+				}
+
+				chunk.floats[i].push_back(parseFloat(v[idx]));
+			}
+
+			chunk.numOfRows++;
+		}
+	} catch (...) {
+		chunk.error = std::current_exception();
+	}
+
+}
+
+template<typename F>
+void runInParallel(std::vector<Chunk>& chunks, F const& f) {
+
+	std::vector<std::thread> threads;
+	for (std::size_t i = 1; i < chunks.size(); i++) {
+		threads.emplace_back([&f, &chunks, i] {
+			f(chunks[i]);
+		});
+	}
+
+	// the first chunk is processed by the calling thread
+	if (!chunks.empty()) {
+		f(chunks.front());
+	}
+
+	for (auto& t : threads) {
+		t.join();
+	}
+
+}
+
 }
 
 DataFrameLoader::NoColumnException::NoColumnException(G4String const& aColName) :
@@ -59,120 +235,232 @@ DataFrameLoader::NoValueException::NoValueException(G4String const& aColName,
 }
 
 DataFrameLoader::DataFrameLoader(std::set<G4String> const& aFloatColumns,
-		std::set<G4String> const& aCategoryColumns) :
-		floatColumns(aFloatColumns), categoryColumns(aCategoryColumns), commentChar(
-				'#'), separatorChar('\t') {
+		std::set<G4String> const& aCategoryColumns,
+		std::set<G4String> const& anOptionalFloatColumns) :
+		floatColumns(aFloatColumns), categoryColumns(aCategoryColumns), optionalFloatColumns(
+				anOptionalFloatColumns), commentChar(
+				'#'), separatorChar('\t'), numOfThreads(0) {
 
 }
 
 DataFrame DataFrameLoader::load(std::istream& is) {
 
+	std::string const text((std::istreambuf_iterator<char>(is)),
+			std::istreambuf_iterator<char>());
+	return load(text.data(), text.data() + text.size());
+
+}
+
+DataFrame DataFrameLoader::load(G4String const& fileName) {
+
+	std::unique_ptr<MappedFile> file;
+	try {
+		file = std::make_unique < MappedFile > (fileName);
+	} catch (MappedFile::OpenException const&) {
+		throw FileException();
+	}
+
+	return load(file->GetData(), file->GetData() + file->GetSize());
+
+}
+
+DataFrame DataFrameLoader::load(char const* const begin,
+		char const* const end) {
+
 	unsigned lineNo = 0;
-	std::string line;
-	bool isfirst = true, precisionDetected = false;
 	std::vector<std::string> columnNames;
 	std::vector<std::size_t> categoryIndices, floatIndices;
-	std::map<G4String, std::map<G4String, DataFrame::CategoryId>> idMap;
-	std::vector<DataFrame::CategoryVectorMap::iterator> categoryVectors;
-	std::vector<DataFrame::FloatVectorMap::iterator> floatVectors;
+	std::vector<G4String> categoryColumnNames, floatColumnNames;
 	auto data = std::make_unique<DataFrame::DataPack>();
-	DataFrame::CategoryVector const emptyCategoryVector;
-	DataFrame::FloatVector const emptyFloatVector;
-	std::size_t lastCategoryIndex = 0, lastFloatIndex = 0;
-
-	while (is.good()) {
-		std::getline(is, line);
+	TokenVector v;
+
+	// read column names
+	auto pos = begin;
+	bool isfirst = true;
+	while (isfirst && pos < end) {
+		auto const eol = lineEnd(pos, end);
+		auto const line = ltrim(pos, eol);
+		pos = eol + 1;
 		lineNo++;
-		ltrim(line);
-		if (line.empty()) {
-			continue;
-		}
-		if (line[0] == commentChar) {
+		if (line == eol || *line == commentChar) {
 			continue;
 		}
 
-		if (isfirst) {
-			// read column names
-			columnNames = tokenize(line, separatorChar);
-
-			std::for_each(std::begin(categoryColumns),
-					std::end(categoryColumns),
-					[&](auto cn) {
-						std::string const sn = cn;
-						auto const pos = std::find(std::begin(columnNames), std::end(columnNames), sn);
-						if (pos == std::end(columnNames)) {
-							throw NoColumnException(cn);
-						}
-						categoryIndices.push_back(std::distance(std::begin(columnNames), pos));
-						categoryVectors.push_back(data->categoryColumns.insert(data->categoryColumns.end(), std::pair<G4String, DataFrame::CategoryVector>(cn, emptyCategoryVector)));
-					});
-			lastCategoryIndex = categoryIndices.size();
-
-			std::for_each(std::begin(floatColumns), std::end(floatColumns),
-					[&](auto cn) {
-						std::string const sn = cn;
-						auto const pos = std::find(std::begin(columnNames), std::end(columnNames), sn);
-						if (pos == std::end(columnNames)) {
-							throw NoColumnException(cn);
-						}
-						floatIndices.push_back(std::distance(std::begin(columnNames), pos));
-						floatVectors.push_back(data->floatColumns.insert(data->floatColumns.end(), std::pair<G4String, DataFrame::FloatVector>(cn, emptyFloatVector)));
-					});
-			lastFloatIndex = floatIndices.size();
+		tokenize(line, eol, separatorChar, v);
+		for (auto const& t : v) {
+			columnNames.emplace_back(t.first, t.second);
+		}
 
-			isfirst = false;
-			continue;
+		std::for_each(std::begin(categoryColumns), std::end(categoryColumns),
+				[&](auto cn) {
+					std::string const sn = cn;
+					auto const pos = std::find(std::begin(columnNames), std::end(columnNames), sn);
+					if (pos == std::end(columnNames)) {
+						throw NoColumnException(cn);
+					}
+					categoryIndices.push_back(std::distance(std::begin(columnNames), pos));
+					categoryColumnNames.push_back(cn);
+				});
+
+		std::for_each(std::begin(floatColumns), std::end(floatColumns),
+				[&](auto cn) {
+					std::string const sn = cn;
+					auto const pos = std::find(std::begin(columnNames), std::end(columnNames), sn);
+					if (pos == std::end(columnNames)) {
+						throw NoColumnException(cn);
+					}
+					floatIndices.push_back(std::distance(std::begin(columnNames), pos));
+					floatColumnNames.push_back(cn);
+				});
+
+		for (auto const& cn : optionalFloatColumns) {
+			std::string const sn = cn;
+			auto const pos = std::find(std::begin(columnNames),
+					std::end(columnNames), sn);
+			if (pos != std::end(columnNames) && !floatColumns.count(cn)) {
+				floatIndices.push_back(
+						std::distance(std::begin(columnNames), pos));
+				floatColumnNames.push_back(cn);
+			}
 		}
 
-		std::vector<std::string> const v = tokenize(line, separatorChar);
-		if (!precisionDetected) {
+		isfirst = false;
+	}
 
-			for (std::size_t i = 0; i < lastFloatIndex; i++) {
-				auto const idx = floatIndices[i];
-				if (idx >= v.size()) {
-					throw NoValueException(columnNames[idx], lineNo);
-				}
-				data->precisions[columnNames[idx]] = detectPrecision(v[idx]);
-			};
+	if (isfirst) {
+		return DataFrame(std::move(data));
+	}
+
+	auto const dataBegin = std::min(pos, end);
+	auto const dataLineNo = lineNo;
 
-			precisionDetected = true;
+	// precision is detected by the first data row
+	while (pos < end) {
+		auto const eol = lineEnd(pos, end);
+		auto const line = ltrim(pos, eol);
+		pos = eol + 1;
+		lineNo++;
+		if (line == eol || *line == commentChar) {
+			continue;
 		}
 
-		for (std::size_t i = 0; i < lastCategoryIndex; i++) {
-			auto const idx = categoryIndices[i];
-			auto const colName = columnNames[idx];
+		tokenize(line, eol, separatorChar, v);
+		for (auto const idx : floatIndices) {
 			if (idx >= v.size()) {
-				throw NoValueException(colName, lineNo);
+				throw NoValueException(columnNames[idx], lineNo);
 			}
+			data->precisions[columnNames[idx]] = detectPrecision(v[idx]);
+		}
 
-			auto im = idMap.find(colName);
-			if (idMap.end() == im) {
-				idMap[colName] = std::map<G4String, DataFrame::CategoryId>();
-				im = idMap.find(colName);
-				data->categoryNames[colName] = DataFrame::CategoryMap();
-			}
+		break;
+	}
 
-			auto const value = v[idx];
-			auto id = im->second.find(value);
-			if (im->second.end() == id) {
-				auto const newId =
-						static_cast<DataFrame::CategoryId>(im->second.size());
-				im->second[value] = newId;
-				id = im->second.find(value);
-				data->categoryNames[colName][newId] = value;
-			}
+	// split data rows into chunks at line boundaries
+	std::size_t const maxNumOfChunks = std::max(1u,
+			numOfThreads ? numOfThreads : std::thread::hardware_concurrency());
+	std::size_t const numOfChunks = std::min(maxNumOfChunks,
+			static_cast<std::size_t>(end - dataBegin) / MinChunkSize + 1);
+	std::size_t const chunkSize = (end - dataBegin) / numOfChunks;
+
+	std::vector<Chunk> chunks;
+	for (auto chunkBegin = dataBegin; chunkBegin < end;) {
+		auto chunkEnd =
+				chunks.size() + 1 < numOfChunks ?
+						lineEnd(std::min(chunkBegin + chunkSize, end), end) + 1 :
+						end;
+		chunkEnd = std::min(chunkEnd, end);
+
+		chunks.emplace_back();
+		auto& chunk = chunks.back();
+		chunk.begin = chunkBegin;
+		chunk.end = chunkEnd;
+		chunk.floats.resize(floatIndices.size());
+		chunk.categories.resize(categoryIndices.size());
+		chunk.dictionaries.resize(categoryIndices.size());
+		chunk.idMaps.resize(categoryIndices.size());
+
+		chunkBegin = chunkEnd;
+	}
 
-			categoryVectors[i]->second.push_back(id->second);
-		};
+	runInParallel(chunks, [&](Chunk& chunk) {
+		parseChunk(chunk, separatorChar, commentChar, categoryIndices, floatIndices);
+	});
 
-		for (std::size_t i = 0; i < lastFloatIndex; i++) {
-			auto const idx = floatIndices[i];
-			if (idx >= v.size()) {
-				throw NoValueException(columnNames[idx], lineNo);
+	// report the first error in the file order
+	for (auto const& chunk : chunks) {
+		if (chunk.errorLine) {
+			auto const skippedLines = std::count(dataBegin, chunk.begin, '\n');
+			throw NoValueException(columnNames[chunk.errorIndex],
+					dataLineNo + skippedLines + chunk.errorLine);
+		}
+		if (chunk.error) {
+			std::rethrow_exception(chunk.error);
+		}
+	}
+
+	// merge category dictionaries in the file order, so ids are assigned
+	// in order of the first appearance just like in a sequential pass
+	std::size_t numOfRows = 0;
+	for (auto const& chunk : chunks) {
+		numOfRows += chunk.numOfRows;
+	}
+
+	for (std::size_t i = 0; i < categoryIndices.size() && numOfRows > 0; i++) {
+		auto const& colName = categoryColumnNames[i];
+		std::map<std::string, DataFrame::CategoryId> idMap;
+		auto& names = data->categoryNames[colName];
+
+		for (auto& chunk : chunks) {
+			for (auto const& value : chunk.dictionaries[i]) {
+				auto id = idMap.find(value);
+				if (idMap.end() == id) {
+					auto const newId =
+							static_cast<DataFrame::CategoryId>(idMap.size());
+					idMap[value] = newId;
+					id = idMap.find(value);
+					names[newId] = value;
+				}
+				chunk.idMaps[i].push_back(id->second);
 			}
+		}
+	}
+
+	// concatenate chunks
+	std::vector<DataFrame::CategoryVector> categoryVectors(
+			categoryIndices.size(), DataFrame::CategoryVector(numOfRows));
+	std::vector<DataFrame::FloatVector> floatVectors(floatIndices.size(),
+			DataFrame::FloatVector(numOfRows));
+	std::vector<std::size_t> offsets(chunks.size(), 0);
+	for (std::size_t i = 1; i < chunks.size(); i++) {
+		offsets[i] = offsets[i - 1] + chunks[i - 1].numOfRows;
+	}
+
+	runInParallel(chunks, [&](Chunk& chunk) {
+		auto const offset = offsets[&chunk - chunks.data()];
+
+		for (std::size_t i = 0; i < categoryVectors.size(); i++) {
+			auto const& idMap = chunk.idMaps[i];
+			std::transform(std::begin(chunk.categories[i]), std::end(chunk.categories[i]),
+					std::begin(categoryVectors[i]) + offset, [&idMap](auto const id) {
+						return idMap[id];
+					});
+			DataFrame::CategoryVector().swap(chunk.categories[i]);
+		}
+
+		for (std::size_t i = 0; i < floatVectors.size(); i++) {
+			std::copy(std::begin(chunk.floats[i]), std::end(chunk.floats[i]),
+					std::begin(floatVectors[i]) + offset);
+			DataFrame::FloatVector().swap(chunk.floats[i]);
+		}
+	});
+
+	for (std::size_t i = 0; i < categoryIndices.size(); i++) {
+		data->AddCategoryColumn(categoryColumnNames[i],
+				std::move(categoryVectors[i]));
+	}
 
-			floatVectors[i]->second.push_back(std::stof(v[idx]));
-		};
+	for (std::size_t i = 0; i < floatIndices.size(); i++) {
+		data->AddFloatColumn(floatColumnNames[i], std::move(floatVectors[i]));
 	}
 
 	return DataFrame(std::move(data));
@@ -0,0 +1,96 @@
+#include <cstring>
+
+#include "isnp/util/DataFrameMapper.hh"
+#include "isnp/util/DataFrameFormat.hh"
+#include "isnp/util/MappedFile.hh"
+
+namespace isnp {
+
+namespace util {
+
+DataFrameMapper::DataFrameMapper(std::set<G4String> const& aFloatColumns,
+		std::set<G4String> const& aCategoryColumns,
+		std::set<G4String> const& anOptionalFloatColumns) :
+		floatColumns(aFloatColumns), categoryColumns(aCategoryColumns), optionalFloatColumns(
+				anOptionalFloatColumns) {
+
+}
+
+DataFrame DataFrameMapper::map(G4String const& fileName) {
+
+	std::shared_ptr<MappedFile const> file;
+	try {
+		file = std::make_shared<MappedFile const>(fileName);
+	} catch (MappedFile::OpenException const&) {
+		throw FormatException();
+	}
+
+	auto const read = [&file](uint64_t const offset, void* const buffer,
+			std::size_t const size) {
+		if (offset > file->GetSize() || size > file->GetSize() - offset) {
+			throw FormatException();
+		}
+		std::memcpy(buffer, file->GetData() + offset, size);
+	};
+
+	auto const frames = DataFrameFormat::ReadFrames(read, file->GetSize());
+	auto const& directory = frames.directories[0];
+	auto const mapped = frames.directories.size() == 1;
+	auto data = std::make_unique<DataFrame::DataPack>();
+
+	for (std::size_t i = 0; i < directory.columns.size(); i++) {
+		auto const& column = directory.columns[i];
+		auto const& name = column.name;
+		auto const values = file->GetData() + column.dataOffset;
+
+		// several frames cannot be mapped as a whole and are copied
+		if (column.type == DataFrameFormat::ColumnType::Float
+				&& (floatColumns.count(name) || optionalFloatColumns.count(name))) {
+			if (mapped) {
+				data->floatColumns[name] = DataFrame::FloatColumnView(
+						reinterpret_cast<G4float const*>(values),
+						frames.rowCount);
+			} else {
+				DataFrame::FloatVector v(frames.rowCount);
+				frames.ReadColumn(read, i, 0, v.size(), v.data());
+				data->AddFloatColumn(name, std::move(v));
+			}
+			data->precisions[name] = column.precision;
+		} else if (column.type == DataFrameFormat::ColumnType::Category
+				&& categoryColumns.count(name)) {
+			if (mapped) {
+				data->categoryColumns[name] = DataFrame::CategoryColumnView(
+						reinterpret_cast<DataFrame::CategoryId const*>(values),
+						frames.rowCount);
+			} else {
+				DataFrame::CategoryVector v(frames.rowCount);
+				frames.ReadColumn(read, i, 0, v.size(), v.data());
+				data->AddCategoryColumn(name, std::move(v));
+			}
+			data->categoryNames[name] = frames.categoryNames.at(name);
+		}
+	}
+
+	for (auto const& c : floatColumns) {
+		if (!data->floatColumns.count(c)) {
+			throw DataFrameLoader::NoColumnException(c);
+		}
+	}
+
+	for (auto const& c : categoryColumns) {
+		if (!data->categoryColumns.count(c)) {
+			throw DataFrameLoader::NoColumnException(c);
+		}
+	}
+
+	if (mapped) {
+		data->mapping = file;
+	}
+
+	return DataFrame(std::move(data));
+
+}
+
+}
+
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cstring>
+
+#include "isnp/util/DataFrameWriter.hh"
+
+namespace isnp {
+
+namespace util {
+
+static_assert(sizeof(G4float) == 4, "Binary format requires 32-bit floats");
+
+static void Pad(std::ostream& os, std::size_t const count) {
+
+	static char const zeros[64] = { 0 };
+
+	for (auto n = count; n > 0;) {
+		auto const chunk = std::min(n, sizeof(zeros));
+		os.write(zeros, chunk);
+		n -= chunk;
+	}
+
+}
+
+DataFrameWriter::DataFrameWriter(std::ostream& anOs) :
+		os(anOs) {
+
+}
+
+void DataFrameWriter::AddFloatColumn(G4String const& columnName,
+		unsigned const precision, G4float const* const values) {
+
+	columns.push_back(
+			Column { columnName, DataFrameFormat::ColumnType::Float, precision,
+					CategoryNames(), values });
+
+}
+
+void DataFrameWriter::AddCategoryColumn(G4String const& columnName,
+		CategoryNames const& names, DataFrame::CategoryId const* const values) {
+
+	columns.push_back(
+			Column { columnName, DataFrameFormat::ColumnType::Category, 0,
+					names, values });
+
+}
+
+void DataFrameWriter::AddIntegerColumn(G4String const& columnName,
+		int32_t const* const values) {
+
+	columns.push_back(
+			Column { columnName, DataFrameFormat::ColumnType::Integer, 0,
+					CategoryNames(), values });
+
+}
+
+void DataFrameWriter::Write(DataFrame::size_type const rowCount) {
+
+	// lay out the directory and the data blocks
+	std::size_t pos = sizeof(DataFrameFormat::Header);
+	for (auto const& c : columns) {
+		pos += sizeof(DataFrameFormat::ColumnEntry) + c.name.length();
+		for (auto const& n : c.names) {
+			pos += sizeof(DataFrameFormat::CategoryEntry) + n.second.length();
+		}
+	}
+
+	std::vector<std::size_t> offsets;
+	for (auto const& c : columns) {
+		pos = DataFrameFormat::Align(pos);
+		offsets.push_back(pos);
+		pos += rowCount * DataFrameFormat::ElementSize(c.type);
+	}
+	auto const frameSize = DataFrameFormat::Align(pos);
+
+	// header
+	DataFrameFormat::Header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, DataFrameFormat::Magic, sizeof(header.magic));
+	header.byteOrder = DataFrameFormat::ByteOrder;
+	header.version = DataFrameFormat::Version;
+	header.rowCount = rowCount;
+	header.columnCount = columns.size();
+	os.write(reinterpret_cast<char const*>(&header), sizeof(header));
+	pos = sizeof(header);
+
+	// directory
+	for (std::size_t i = 0; i < columns.size(); i++) {
+		auto const& c = columns[i];
+
+		DataFrameFormat::ColumnEntry entry;
+		std::memset(&entry, 0, sizeof(entry));
+		entry.type = static_cast<uint8_t>(c.type);
+		entry.precision = c.precision;
+		entry.nameLength = c.name.length();
+		entry.categoryCount = c.names.size();
+		entry.dataOffset = offsets[i];
+		os.write(reinterpret_cast<char const*>(&entry), sizeof(entry));
+		os.write(c.name.data(), c.name.length());
+		pos += sizeof(entry) + c.name.length();
+
+		for (auto const& n : c.names) {
+			DataFrameFormat::CategoryEntry category;
+			std::memset(&category, 0, sizeof(category));
+			category.id = n.first;
+			category.nameLength = n.second.length();
+			os.write(reinterpret_cast<char const*>(&category),
+					sizeof(category));
+			os.write(n.second.data(), n.second.length());
+			pos += sizeof(category) + n.second.length();
+		}
+	}
+
+	// data
+	for (std::size_t i = 0; i < columns.size(); i++) {
+		auto const& c = columns[i];
+		auto const bytes = rowCount * DataFrameFormat::ElementSize(c.type);
+
+		Pad(os, offsets[i] - pos);
+		os.write(static_cast<char const*>(c.values), bytes);
+		pos = offsets[i] + bytes;
+	}
+
+	// frames may be concatenated, so the next one must start aligned too
+	Pad(os, frameSize - pos);
+
+}
+
+void DataFrameWriter::Write(DataFrame const& df, std::ostream& os) {
+
+	DataFrameWriter writer(os);
+
+	for (auto const& c : df.data->floatColumns) {
+		writer.AddFloatColumn(c.first, df.Precision(c.first), c.second.data());
+	}
+
+	for (auto const& c : df.data->categoryColumns) {
+		auto const it = df.data->categoryNames.find(c.first);
+		writer.AddCategoryColumn(c.first,
+				it == df.data->categoryNames.cend() ?
+						CategoryNames() : it->second, c.second.data());
+	}
+
+	writer.Write(df.Size());
+
+}
+
+}
+
+}
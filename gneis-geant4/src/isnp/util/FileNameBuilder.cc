@@ -1,3 +1,4 @@
+#include <string>
 #include "isnp/util/FileNameBuilder.hh"
 
 G4String isnp::util::FileNameBuilder::commonSuffix = "";
@@ -21,6 +22,19 @@ G4String isnp::util::FileNameBuilder::Make(G4String const& base, char const* con
 	return result;
 }
 
+G4String isnp::util::FileNameBuilder::MakeShard(G4String const& base, G4int const shardNo, char const* const suffix) {
+	auto result = Make(base);
+
+	result += ".t";
+	result += std::to_string(shardNo);
+
+	if (suffix) {
+		result += suffix;
+	}
+
+	return result;
+}
+
 void isnp::util::FileNameBuilder::SetCommonSuffix(G4String const& s) {
 	commonSuffix = s;
 }
@@ -0,0 +1,51 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "isnp/util/MappedFile.hh"
+
+namespace isnp {
+
+namespace util {
+
+MappedFile::MappedFile(G4String const& fileName) :
+		data(nullptr), size(0) {
+
+	int const fd = ::open(fileName.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw OpenException();
+	}
+
+	struct stat st;
+	if (::fstat(fd, &st) != 0) {
+		::close(fd);
+		throw OpenException();
+	}
+
+	size = static_cast<std::size_t>(st.st_size);
+	if (size > 0) {
+		void* const p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		if (p == MAP_FAILED) {
+			::close(fd);
+			throw OpenException();
+		}
+		data = static_cast<char const*>(p);
+	}
+
+	// the mapping stays valid after the descriptor is closed
+	::close(fd);
+
+}
+
+MappedFile::~MappedFile() {
+
+	if (data) {
+		::munmap(const_cast<char*>(data), size);
+	}
+
+}
+
+}
+
+}
@@ -0,0 +1,80 @@
+#include <cmath>
+
+#include <geomdefs.hh>
+#include <G4Navigator.hh>
+#include <G4GeometryManager.hh>
+#include <G4Timer.hh>
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include "isnp/util/NavigationBenchmark.hh"
+
+namespace isnp {
+
+namespace util {
+
+NavigationBenchmark::Result NavigationBenchmark::Run(
+		G4VPhysicalVolume* const world, G4ThreeVector const& origin,
+		G4double const spread, uint64_t const numOfRays) {
+
+	// a ray stuck on coincident surfaces is abandoned
+	uint64_t const maxNumOfSteps = 100000;
+
+	// the navigator is timed on the voxels a run would build
+	auto const geometryManager = G4GeometryManager::GetInstance();
+	G4bool const isClosed = geometryManager->IsGeometryClosed();
+	if (!isClosed) {
+		geometryManager->CloseGeometry(true, false, world);
+	}
+
+	G4Navigator navigator;
+	navigator.SetWorldVolume(world);
+
+	Result result { numOfRays, 0, 0., 0. };
+
+	G4Timer timer;
+	timer.Start();
+
+	for (uint64_t i = 0; i < numOfRays; i++) {
+		// uniform over the disk of directions
+		auto const r = spread * std::sqrt(G4UniformRand());
+		auto const phi = CLHEP::twopi * G4UniformRand();
+		auto const direction = G4ThreeVector(r * std::cos(phi),
+				r * std::sin(phi), 1.).unit();
+
+		auto position = origin;
+		auto volume = navigator.LocateGlobalPointAndSetup(position, &direction,
+				false, false);
+
+		for (uint64_t steps = 0; volume && steps < maxNumOfSteps; steps++) {
+			G4double safety;
+			auto const step = navigator.ComputeStep(position, direction,
+					kInfinity, safety);
+			if (step >= kInfinity) {
+				break;
+			}
+
+			position += step * direction;
+			result.length += step;
+			result.numOfSteps++;
+
+			navigator.SetGeometricallyLimitedStep();
+			volume = navigator.LocateGlobalPointAndSetup(position, &direction,
+					true);
+		}
+	}
+
+	timer.Stop();
+	result.time = timer.GetRealElapsed() * s;
+
+	if (!isClosed) {
+		geometryManager->OpenGeometry(world);
+	}
+
+	return result;
+
+}
+
+}
+
+}
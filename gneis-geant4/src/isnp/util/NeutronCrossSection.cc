@@ -0,0 +1,29 @@
+#include <G4Neutron.hh>
+#include <G4HadronicProcessStore.hh>
+
+#include "isnp/util/NeutronCrossSection.hh"
+
+namespace isnp {
+
+namespace util {
+
+G4double NeutronCrossSection::Total(G4Material const* const material,
+		G4double const kineticEnergy) {
+
+	auto const store = G4HadronicProcessStore::Instance();
+	auto const neutron = G4Neutron::Definition();
+
+	return store->GetElasticCrossSectionPerVolume(neutron, kineticEnergy,
+			material)
+			+ store->GetInelasticCrossSectionPerVolume(neutron, kineticEnergy,
+					material)
+			+ store->GetCaptureCrossSectionPerVolume(neutron, kineticEnergy,
+					material)
+			+ store->GetFissionCrossSectionPerVolume(neutron, kineticEnergy,
+					material);
+
+}
+
+}
+
+}
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include <Randomize.hh>
 
@@ -11,17 +13,35 @@ namespace util {
 G4double RandomNumberGenerator::locality(G4double const significant,
 		unsigned const precision) {
 
-	G4double halfRange;
+	G4double const halfRange = std::pow(10.0,
+			localityExponent(significant, precision)) / 2;
+
+	return CLHEP::RandFlat::shoot(significant - halfRange,
+			significant + halfRange);
+
+}
+
+G4double RandomNumberGenerator::localityExponent(G4double const significant,
+		unsigned const precision) {
+
 	auto const log = std::log10(std::fabs(significant));
 
 	if (log >= 0) {
-		halfRange = std::pow(10.0, std::floor(log) - precision + 1) / 2;
+		return std::floor(log) - precision + 1;
 	} else {
-		halfRange = std::pow(10.0, -std::floor(-log) - precision) / 2;
+		return -std::floor(-log) - precision;
 	}
 
-	return CLHEP::RandFlat::shoot(significant - halfRange,
-			significant + halfRange);
+}
+
+void RandomNumberGenerator::flatArray(G4double* const v, std::size_t const n) {
+
+	std::size_t const maxChunk = std::numeric_limits<int>::max();
+	auto const engine = CLHEP::HepRandom::getTheEngine();
+
+	for (std::size_t i = 0; i < n; i += maxChunk) {
+		engine->flatArray(static_cast<int>(std::min(n - i, maxChunk)), v + i);
+	}
 
 }
 
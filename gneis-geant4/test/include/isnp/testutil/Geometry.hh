@@ -0,0 +1,36 @@
+#ifndef isnp_testutil_Geometry_hh
+#define isnp_testutil_Geometry_hh
+
+#include <G4LogicalVolume.hh>
+#include <G4Material.hh>
+#include <G4ThreeVector.hh>
+
+namespace isnp {
+
+namespace testutil {
+
+class Geometry {
+public:
+
+	/**
+	 * Returns the material at the point given in the coordinate system of the volume,
+	 * looking through its daughters as the navigator does.
+	 */
+	static G4Material const* MaterialAt(G4LogicalVolume const* volume,
+			G4ThreeVector const& point);
+
+	/**
+	 * Returns the number of random points in the box of given half sizes centered
+	 * at the origin, where the materials of the volumes differ.
+	 */
+	static unsigned CountDifferences(G4LogicalVolume const* a,
+			G4LogicalVolume const* b, G4ThreeVector const& halfSize,
+			unsigned numOfPoints);
+
+};
+
+}
+
+}
+
+#endif	//	isnp_testutil_Geometry_hh
@@ -0,0 +1,254 @@
+#include <cmath>
+#include <sstream>
+
+#include <gtest/gtest.h>
+#include <G4Neutron.hh>
+#include <G4Gamma.hh>
+
+#include "isnp/detector/Histogram.hh"
+
+namespace isnp {
+
+namespace detector {
+
+static Histogram::Values MakeValues(G4double const energy,
+		G4double const angle = 0.0) {
+
+	return Histogram::Values { energy, angle, 0.0, 0.0, 0.0 };
+
+}
+
+TEST(Histogram, LinearAxis)
+{
+
+	Histogram::Axis const a(Histogram::Quantity::X, 10, -5.0, 5.0);
+
+	EXPECT_EQ(0u, a.BinOf(-5.0));
+	EXPECT_EQ(4u, a.BinOf(-0.5));
+	EXPECT_EQ(5u, a.BinOf(0.0));
+	EXPECT_EQ(9u, a.BinOf(4.99));
+	EXPECT_EQ(10u, a.BinOf(5.0));
+	EXPECT_EQ(10u, a.BinOf(-5.01));
+	EXPECT_EQ(10u, a.BinOf(std::nan("")));
+
+	EXPECT_DOUBLE_EQ(-5.0, a.LowerEdge(0));
+	EXPECT_DOUBLE_EQ(0.0, a.LowerEdge(5));
+	EXPECT_DOUBLE_EQ(5.0, a.LowerEdge(10));
+
+}
+
+TEST(Histogram, LogAxis)
+{
+
+	Histogram::Axis const a(Histogram::Quantity::Energy, 3, 0.1, 100.0,
+			Histogram::Scale::Log);
+
+	EXPECT_EQ(0u, a.BinOf(0.1));
+	EXPECT_EQ(0u, a.BinOf(0.99));
+	EXPECT_EQ(1u, a.BinOf(1.01));
+	EXPECT_EQ(2u, a.BinOf(50.0));
+	EXPECT_EQ(3u, a.BinOf(100.0));
+	EXPECT_EQ(3u, a.BinOf(0.0));
+	EXPECT_EQ(3u, a.BinOf(-1.0));
+
+	EXPECT_NEAR(1.0, a.LowerEdge(1), 1e-12);
+	EXPECT_NEAR(10.0, a.LowerEdge(2), 1e-12);
+
+}
+
+TEST(Histogram, InvalidAxis)
+{
+
+	EXPECT_THROW(Histogram::Axis(Histogram::Quantity::X, 0, 0.0, 1.0),
+			Histogram::InvalidAxisException);
+	EXPECT_THROW(Histogram::Axis(Histogram::Quantity::X, 10, 1.0, 1.0),
+			Histogram::InvalidAxisException);
+	EXPECT_THROW(
+			Histogram::Axis(Histogram::Quantity::Energy, 10, 0.0, 1.0, Histogram::Scale::Log),
+			Histogram::InvalidAxisException);
+
+}
+
+TEST(Histogram, Fill)
+{
+
+	Histogram h("h", Histogram::Axis(Histogram::Quantity::Energy, 2, 0.0, 2.0));
+	auto const neutron = G4Neutron::Definition();
+
+	h.Fill(neutron, MakeValues(0.2));
+	h.Fill(neutron, MakeValues(0.4));
+	h.Fill(neutron, MakeValues(0.6));
+	h.Fill(neutron, MakeValues(1.5));
+	h.Fill(neutron, MakeValues(2.5));
+
+	EXPECT_EQ(3u, h.GetBin(0).count);
+	EXPECT_DOUBLE_EQ(0.4, h.GetBin(0).mean);
+	EXPECT_DOUBLE_EQ(0.04, h.GetBin(0).Variance());
+	EXPECT_EQ(1u, h.GetBin(1).count);
+	EXPECT_DOUBLE_EQ(0.0, h.GetBin(1).Variance());
+	EXPECT_EQ(1u, h.GetOutOfRange());
+
+	h.Reset();
+	EXPECT_EQ(0u, h.GetBin(0).count);
+	EXPECT_EQ(0u, h.GetOutOfRange());
+
+}
+
+TEST(Histogram, Particle)
+{
+
+	Histogram h("h", Histogram::Axis(Histogram::Quantity::Energy, 1, 0.0, 1.0));
+	h.SetParticleName("gamma");
+
+	h.Fill(G4Neutron::Definition(), MakeValues(0.5));
+	h.Fill(G4Gamma::Definition(), MakeValues(0.5));
+
+	EXPECT_EQ(1u, h.GetBin(0).count);
+	EXPECT_EQ(0u, h.GetOutOfRange());
+
+}
+
+TEST(Histogram, TwoDimensional)
+{
+
+	Histogram h("h", Histogram::Axis(Histogram::Quantity::Energy, 2, 0.0, 2.0),
+			Histogram::Axis(Histogram::Quantity::Angle, 3, 0.0, 90.0));
+	h.SetValue(Histogram::Quantity::Angle);
+	auto const neutron = G4Neutron::Definition();
+
+	h.Fill(neutron, MakeValues(1.5, 45.0));
+	h.Fill(neutron, MakeValues(1.5, 55.0));
+	h.Fill(neutron, MakeValues(0.5, 10.0));
+	h.Fill(neutron, MakeValues(0.5, 100.0));
+
+	EXPECT_TRUE(h.IsTwoDimensional());
+	EXPECT_EQ(2u, h.GetBin(1, 1).count);
+	EXPECT_DOUBLE_EQ(50.0, h.GetBin(1, 1).mean);
+	EXPECT_EQ(1u, h.GetBin(0, 0).count);
+	EXPECT_EQ(0u, h.GetBin(0, 1).count);
+	EXPECT_EQ(1u, h.GetOutOfRange());
+
+	std::ostringstream os;
+	h.Write(os);
+	std::istringstream is(os.str());
+	std::string line;
+	std::getline(is, line);
+	EXPECT_EQ("# histogram h, particle all, out of range 1", line);
+	std::getline(is, line);
+	EXPECT_EQ("EnergyMin\tEnergyMax\tAngleMin\tAngleMax\tCount\tWeight\tMeanAngle\tVarianceAngle",
+			line);
+
+}
+
+TEST(Histogram, Weights)
+{
+
+	Histogram h("h", Histogram::Axis(Histogram::Quantity::Energy, 1, 0.0, 10.0)),
+			u("u", Histogram::Axis(Histogram::Quantity::Energy, 1, 0.0, 10.0));
+	auto const neutron = G4Neutron::Definition();
+
+	// weight 2 counts as two hits of weight 1
+	h.Fill(neutron, MakeValues(1.0), 2.0);
+	h.Fill(neutron, MakeValues(4.0), 1.0);
+	u.Fill(neutron, MakeValues(1.0));
+	u.Fill(neutron, MakeValues(1.0));
+	u.Fill(neutron, MakeValues(4.0));
+
+	EXPECT_EQ(2u, h.GetBin(0).count);
+	EXPECT_DOUBLE_EQ(3.0, h.GetBin(0).weight);
+	EXPECT_DOUBLE_EQ(2.0, h.GetBin(0).mean);
+	EXPECT_DOUBLE_EQ(u.GetBin(0).mean, h.GetBin(0).mean);
+
+	h.Fill(neutron, MakeValues(5.0), 0.0);
+	EXPECT_EQ(2u, h.GetBin(0).count);
+
+}
+
+TEST(Histogram, Total)
+{
+
+	Histogram h("h",
+			Histogram::Axis(Histogram::Quantity::Energy, 2, 0.0, 10.0));
+	auto const neutron = G4Neutron::Definition();
+
+	// three histories, the last one has no hits
+	h.Fill(neutron, MakeValues(1.0), 2.0);
+	h.Fill(neutron, MakeValues(6.0), 1.0);
+	h.EndHistory();
+	h.Fill(neutron, MakeValues(7.0), 1.0);
+	h.EndHistory();
+
+	EXPECT_DOUBLE_EQ(std::sqrt(4.0 / 4.0 - 1.0 / 3.0),
+			h.GetBin(0).RelativeError(3));
+	EXPECT_DOUBLE_EQ(std::sqrt(2.0 / 4.0 - 1.0 / 3.0),
+			h.GetBin(1).RelativeError(3));
+
+	auto const total = h.GetTotal();
+	EXPECT_EQ(3u, total.count);
+	EXPECT_DOUBLE_EQ(4.0, total.weight);
+	EXPECT_DOUBLE_EQ(10.0, total.weight2);
+	EXPECT_DOUBLE_EQ(std::sqrt(10.0 / 16.0 - 1.0 / 3.0),
+			total.RelativeError(3));
+	EXPECT_DOUBLE_EQ(0.0,
+			Histogram("e", h.GetX()).GetTotal().RelativeError(3));
+
+}
+
+TEST(Histogram, CorrelatedHits)
+{
+
+	Histogram::Axis const x(Histogram::Quantity::Energy, 1, 0.0, 10.0);
+	Histogram correlated("c", x), independent("i", x);
+	auto const neutron = G4Neutron::Definition();
+
+	// 20 histories with the same hits, either by pairs in half of them or one in each
+	for (int i = 0; i < 10; i++) {
+		correlated.Fill(neutron, MakeValues(1.0));
+		correlated.Fill(neutron, MakeValues(1.0));
+		correlated.EndHistory();
+		independent.Fill(neutron, MakeValues(1.0));
+		independent.EndHistory();
+		independent.Fill(neutron, MakeValues(1.0));
+		independent.EndHistory();
+	}
+
+	EXPECT_DOUBLE_EQ(20.0, correlated.GetTotal().weight);
+	EXPECT_DOUBLE_EQ(20.0, independent.GetTotal().weight);
+	EXPECT_DOUBLE_EQ(std::sqrt(40.0 / 400.0 - 1.0 / 20.0),
+			correlated.GetTotal().RelativeError(20));
+	EXPECT_DOUBLE_EQ(0.0, independent.GetTotal().RelativeError(20));
+
+	// merged histograms keep the history sums
+	Histogram merged("c", x);
+	merged.Merge(correlated);
+	EXPECT_DOUBLE_EQ(correlated.GetTotal().weight2, merged.GetTotal().weight2);
+
+}
+
+TEST(Histogram, Merge)
+{
+
+	Histogram::Axis const x(Histogram::Quantity::Energy, 1, 0.0, 100.0);
+	Histogram all("all", x), a("a", x), b("b", x);
+	auto const neutron = G4Neutron::Definition();
+
+	for (int i = 0; i < 1000; i++) {
+		auto const e = 50.0 + 10.0 * std::sin(i);
+		all.Fill(neutron, MakeValues(e));
+		(i % 3 == 0 ? a : b).Fill(neutron, MakeValues(e));
+	}
+
+	a.Merge(b);
+	EXPECT_EQ(all.GetBin(0).count, a.GetBin(0).count);
+	EXPECT_NEAR(all.GetBin(0).mean, a.GetBin(0).mean, 1e-12);
+	EXPECT_NEAR(all.GetBin(0).Variance(), a.GetBin(0).Variance(), 1e-9);
+
+	Histogram other("other",
+			Histogram::Axis(Histogram::Quantity::Energy, 2, 0.0, 100.0));
+	EXPECT_THROW(a.Merge(other), Histogram::MismatchException);
+
+}
+
+}
+
+}
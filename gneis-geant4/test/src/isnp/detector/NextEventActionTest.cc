@@ -0,0 +1,167 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4NistManager.hh>
+#include <G4PVPlacement.hh>
+#include <G4PhysicalConstants.hh>
+#include <G4SystemOfUnits.hh>
+
+#include "isnp/detector/NextEventAction.hh"
+
+namespace isnp {
+
+namespace detector {
+
+static G4double const SIGMA = 0.1 / cm;
+
+/**
+ * Vacuum world with a slab 10 cm thick across Z at the origin,
+ * the slab attenuates neutrons by SIGMA.
+ */
+static G4VPhysicalVolume* MakeSlab(NextEventAction& action) {
+
+	auto const nist = G4NistManager::Instance();
+	auto const vacuum = nist->FindOrBuildMaterial("G4_Galactic");
+	auto const iron = nist->FindOrBuildMaterial("G4_Fe");
+
+	auto const logicWorld = new G4LogicalVolume(
+			new G4Box("world", 2 * m, 2 * m, 2 * m), vacuum, "world");
+	auto const world = new G4PVPlacement(nullptr, G4ThreeVector(), logicWorld,
+			"world", nullptr, false, 0, false);
+
+	auto const logicSlab = new G4LogicalVolume(
+			new G4Box("slab", 1 * m, 1 * m, 5 * cm), iron, "slab");
+	new G4PVPlacement(nullptr, G4ThreeVector(), logicSlab, "slab", logicWorld,
+			false, 0, false);
+
+	action.SetWorldVolume(world);
+	action.SetCrossSection([iron](G4Material const* const material, G4double) {
+		return material == iron ? SIGMA : 0.0;
+	});
+
+	return world;
+
+}
+
+TEST(NextEventAction, OpticalDepth) {
+
+	NextEventAction action;
+	MakeSlab(action);
+
+	G4ThreeVector const from(0, 0, -50 * cm);
+	EXPECT_NEAR(1.0,
+			action.OpticalDepth(from, G4ThreeVector(0, 0, 1), 1 * m, 1 * MeV),
+			1e-9);
+
+	// oblique path through the slab is longer by 1 / cos
+	auto const direction = G4ThreeVector(1, 0, 1).unit();
+	EXPECT_NEAR(std::sqrt(2.0),
+			action.OpticalDepth(from, direction, 1 * m * std::sqrt(2.0),
+					1 * MeV), 1e-9);
+
+	// path ending before the slab is not attenuated
+	EXPECT_NEAR(0.0,
+			action.OpticalDepth(from, G4ThreeVector(0, 0, 1), 40 * cm, 1 * MeV),
+			1e-9);
+
+}
+
+TEST(NextEventAction, Contribution) {
+
+	NextEventAction action;
+	MakeSlab(action);
+
+	NextEventAction::Emission const emission { G4ThreeVector(0, 0, -50 * cm),
+			2 * MeV, 0.0, 1.0, G4ThreeVector(), 0.0, 0.0 };
+	G4ThreeVector const target(0, 0, 50 * cm);
+	G4ThreeVector const normal(0, 0, 1);
+	auto const r2 = (1 * m) * (1 * m) / (mm * mm);
+
+	// isotropic point source behind the slab, fluence per mm^2 at a point
+	G4double energy;
+	EXPECT_NEAR(std::exp(-1.0) / (4 * pi * r2),
+			action.Contribution(emission, target, 0.0, normal, energy),
+			1e-9 / r2);
+	EXPECT_DOUBLE_EQ(2 * MeV, energy);
+
+	// small disk facing the source takes its solid angle
+	auto const radius = 1 * cm;
+	EXPECT_NEAR(std::exp(-1.0) * radius * radius / (4 * (1 * m) * (1 * m)),
+			action.Contribution(emission, target, radius, normal, energy),
+			1e-12);
+
+	// elastic scattering on hydrogen never goes backwards
+	auto elastic = emission;
+	elastic.incidentDirection = G4ThreeVector(0, 0, -1);
+	elastic.incidentEnergy = 2 * MeV;
+	elastic.massRatio = 1.0;
+	EXPECT_EQ(0.0, action.Contribution(elastic, target, 0.0, normal, energy));
+
+	// and keeps the energy when it goes forward
+	elastic.incidentDirection = G4ThreeVector(0, 0, 1);
+	EXPECT_NEAR(std::exp(-1.0) / (pi * r2),
+			action.Contribution(elastic, target, 0.0, normal, energy),
+			1e-9 / r2);
+	EXPECT_NEAR(2 * MeV, energy, 1e-9 * MeV);
+
+}
+
+TEST(NextEventAction, ElasticDensity) {
+
+	// density integrates to one over the sphere for any target
+	for (auto const massRatio : { 1.0, 2.0, 12.0, 56.0 }) {
+		int const n = 100000;
+		G4double integral = 0.0, meanEnergy = 0.0;
+		for (int i = 0; i < n; i++) {
+			auto const cosine = -1.0 + 2.0 * (i + 0.5) / n;
+			G4double energyRatio;
+			auto const density = NextEventAction::ElasticDensity(massRatio,
+					cosine, energyRatio);
+			integral += 2 * pi * density * 2.0 / n;
+			meanEnergy += 2 * pi * density * energyRatio * 2.0 / n;
+		}
+		EXPECT_NEAR(1.0, integral, 1e-3);
+
+		// mean energy ratio of isotropic scattering in the centre of mass frame
+		auto const a = massRatio;
+		EXPECT_NEAR((a * a + 1) / ((a + 1) * (a + 1)), meanEnergy, 1e-3);
+	}
+
+	// scattering on a nucleus as heavy as a neutron
+	G4double energyRatio;
+	EXPECT_NEAR(0.5 / pi,
+			NextEventAction::ElasticDensity(1.0, 0.5, energyRatio), 1e-12);
+	EXPECT_NEAR(0.25, energyRatio, 1e-12);
+
+}
+
+TEST(NextEventAction, Uncollided) {
+
+	NextEventAction action;
+	MakeSlab(action);
+
+	G4ThreeVector const from(0, 0, -50 * cm);
+	G4ThreeVector const target(0, 0, 50 * cm);
+	G4ThreeVector const normal(0, 0, 1);
+
+	G4double distance;
+	EXPECT_NEAR(std::exp(-1.0),
+			action.Uncollided(from, G4ThreeVector(0, 0, 1), 1 * MeV, target,
+					10 * cm, normal, distance), 1e-9);
+	EXPECT_NEAR(1 * m, distance, 1e-9 * mm);
+
+	// direction missing the disk, a point is never hit
+	EXPECT_EQ(0.0,
+			action.Uncollided(from, G4ThreeVector(1, 0, 1).unit(), 1 * MeV,
+					target, 10 * cm, normal, distance));
+	EXPECT_EQ(0.0,
+			action.Uncollided(from, G4ThreeVector(0, 0, 1), 1 * MeV, target,
+					0.0, normal, distance));
+
+}
+
+}
+
+}
@@ -0,0 +1,102 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <gtest/gtest.h>
+#include "isnp/detector/ShardMerger.hh"
+#include "isnp/util/DataFrameMapper.hh"
+#include "isnp/util/DataFrameWriter.hh"
+
+namespace isnp {
+
+namespace detector {
+
+TEST(ShardMerger, MergeText) {
+
+	G4String const shard1 = "ShardMergerTest.t0.txt";
+	G4String const shard2 = "ShardMergerTest.t1.txt";
+	{
+		std::ofstream os(shard1);
+		os << "# comment\nType\tX\tEvent\n" << "a\t1\t0\n" << "b\t2\t0\n"
+				<< "a\t3\t3\n";
+	}
+	{
+		std::ofstream os(shard2);
+		os << "# comment\nType\tX\tEvent\n" << "c\t4\t1\n" << "a\t5\t2\n"
+				<< "b\t6\t4\n";
+	}
+
+	std::ostringstream os;
+	ShardMerger::MergeText( { shard1, shard2 }, os);
+	EXPECT_EQ("a\t1\t0\nb\t2\t0\nc\t4\t1\na\t5\t2\na\t3\t3\nb\t6\t4\n",
+			os.str());
+
+	EXPECT_THROW(ShardMerger::MergeText( { "nonexistent.txt" }, os),
+			ShardMerger::MergeException);
+
+	std::remove(shard1.c_str());
+	std::remove(shard2.c_str());
+
+}
+
+TEST(ShardMerger, MergeBinary) {
+
+	G4String const shard1 = "ShardMergerTest.t0.bin";
+	G4String const shard2 = "ShardMergerTest.t1.bin";
+	G4String const output = "ShardMergerTest.bin";
+
+	// shards have different dictionaries
+	{
+		std::ofstream os(shard1, std::ios::binary);
+		util::DataFrameWriter writer(os);
+		util::DataFrame::CategoryId const types[] = { 0, 1, 0 };
+		G4float const x[] = { 1, 2, 3 };
+		int32_t const events[] = { 0, 0, 3 };
+		writer.AddCategoryColumn("Type", { { 0, "a" }, { 1, "b" } }, types);
+		writer.AddFloatColumn("X", 1, x);
+		writer.AddIntegerColumn("Event", events);
+		writer.Write(3);
+	}
+	{
+		std::ofstream os(shard2, std::ios::binary);
+		util::DataFrameWriter writer(os);
+		util::DataFrame::CategoryId const types[] = { 0, 1, 2 };
+		G4float const x[] = { 4, 5, 6 };
+		int32_t const events[] = { 1, 2, 4 };
+		writer.AddCategoryColumn("Type", { { 0, "c" }, { 1, "a" }, { 2, "b" } },
+				types);
+		writer.AddFloatColumn("X", 1, x);
+		writer.AddIntegerColumn("Event", events);
+		writer.Write(3);
+	}
+
+	{
+		// small frames make the output consist of several frames
+		std::ofstream os(output, std::ios::binary);
+		ShardMerger::MergeBinary( { shard1, shard2 }, "Event", os, 4);
+	}
+
+	util::DataFrameMapper mapper( { "X" }, { "Type" });
+	auto const df = mapper.map(output);
+	ASSERT_EQ(6u, df.Size());
+
+	G4float const x[] = { 1, 2, 4, 5, 3, 6 };
+	G4String const types[] = { "a", "b", "c", "a", "a", "b" };
+	for (util::DataFrame::size_type i = 0; i < df.Size(); i++) {
+		EXPECT_EQ(x[i], df.FloatValue("X", i));
+		EXPECT_EQ(types[i], df.CategoryValue("Type", i));
+	}
+
+	std::ostringstream os;
+	EXPECT_THROW(ShardMerger::MergeBinary( { shard1 }, "Run", os, 4),
+			ShardMerger::MergeException);
+
+	std::remove(shard1.c_str());
+	std::remove(shard2.c_str());
+	std::remove(output.c_str());
+
+}
+
+}
+
+}
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <vector>
 #include <G4SystemOfUnits.hh>
 #include <gtest/gtest.h>
 
@@ -100,6 +101,34 @@ TEST(GaussEllipse, Generate)
 
 }
 
+TEST(GaussEllipse, GenerateN)
+{
+
+	using namespace isnp::testutil;
+
+	static G4double const FWHM = 2 * std::sqrt(2 * std::log(2));
+
+	GaussEllipse generator(GaussEllipseProps(200 * mm, 50 * mm));
+
+	std::vector<G4double> xs(1000000), ys(xs.size());
+	generator.GenerateN(xs.data(), ys.data(), xs.size());
+
+	Stat x, y, r;
+
+	for (std::size_t i = 0; i < xs.size(); i++) {
+		x += xs[i];
+		y += ys[i];
+		r += std::sqrt(xs[i] * xs[i] + ys[i] * ys[i]);
+	}
+
+	EXPECT_TRUE(x.Is(0.0 * mm));
+	EXPECT_NEAR(200 * mm / FWHM, x.GetStd(), 0.2 * mm);
+	EXPECT_TRUE(y.Is(0.0 * mm));
+	EXPECT_NEAR(50 * mm / FWHM, y.GetStd(), 0.1 * mm);
+	EXPECT_NEAR(114.78 * mm / FWHM, r.GetStd(), 0.5 * mm);
+
+}
+
 }
 
 }
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <vector>
 #include <G4SystemOfUnits.hh>
 #include <gtest/gtest.h>
 
@@ -72,6 +73,115 @@ TEST(UniformCircle, ZeroDiameter)
 
 }
 
+static void ExpectUniformCircle(testutil::Stat const& x,
+		testutil::Stat const& y, testutil::Stat const& r) {
+
+	EXPECT_TRUE(x.Is(0.0 * cm));
+	EXPECT_NEAR(-2 * cm, x.GetMin(), 0.001 * cm);
+	EXPECT_NEAR(2 * cm, x.GetMax(), 0.001 * cm);
+	EXPECT_NEAR(1.0 * cm, x.GetStd(), 0.001 * cm);
+
+	EXPECT_TRUE(y.Is(0.0 * cm));
+	EXPECT_NEAR(-2 * cm, y.GetMin(), 0.001 * cm);
+	EXPECT_NEAR(2 * cm, y.GetMax(), 0.001 * cm);
+	EXPECT_NEAR(1.0 * cm, y.GetStd(), 0.001 * cm);
+
+	EXPECT_NEAR(2 * cm, r.GetMax(), 0.01 * cm);
+	EXPECT_NEAR(0.47 * cm, r.GetStd(), 0.01 * cm);
+
+}
+
+TEST(UniformCircle, GenerateN)
+{
+
+	using namespace isnp::testutil;
+
+	UniformCircle generator(UniformCircleProps(40 * mm));
+
+	std::vector<G4double> xs(1000000), ys(xs.size());
+	generator.GenerateN(xs.data(), ys.data(), xs.size());
+
+	Stat x, y, r;
+
+	for (std::size_t i = 0; i < xs.size(); i++) {
+		x += xs[i];
+		y += ys[i];
+		r += std::sqrt(xs[i] * xs[i] + ys[i] * ys[i]);
+	}
+
+	ExpectUniformCircle(x, y, r);
+
+}
+
+TEST(UniformCircle, Engine)
+{
+
+	UniformCircle generator(UniformCircleProps(40 * mm));
+	EXPECT_EQ(UniformCircleProps::Engine::Rejection,
+			generator.GetProps().GetEngine());
+
+	generator.GetProps().SetEngine(UniformCircleProps::Engine::Analytic);
+	EXPECT_EQ(UniformCircleProps::Engine::Analytic,
+			generator.GetProps().GetEngine());
+
+}
+
+TEST(UniformCircle, GenerateAnalytic)
+{
+
+	using namespace isnp::testutil;
+
+	UniformCircle generator(
+			UniformCircleProps(40 * mm, UniformCircleProps::Engine::Analytic));
+	Stat x, y, r;
+
+	for (int i = 0; i < 1000000; i++) {
+		auto const pos = generator.Generate();
+		EXPECT_DOUBLE_EQ(0.0, pos.getZ());
+		x += pos.getX();
+		y += pos.getY();
+		r += std::sqrt(pos.getX() * pos.getX() + pos.getY() * pos.getY());
+	}
+
+	ExpectUniformCircle(x, y, r);
+
+}
+
+TEST(UniformCircle, GenerateNAnalytic)
+{
+
+	using namespace isnp::testutil;
+
+	UniformCircle generator(
+			UniformCircleProps(40 * mm, UniformCircleProps::Engine::Analytic));
+
+	std::vector<G4double> xs(1000000), ys(xs.size());
+	generator.GenerateN(xs.data(), ys.data(), xs.size());
+
+	Stat x, y, r;
+
+	for (std::size_t i = 0; i < xs.size(); i++) {
+		x += xs[i];
+		y += ys[i];
+		r += std::sqrt(xs[i] * xs[i] + ys[i] * ys[i]);
+	}
+
+	ExpectUniformCircle(x, y, r);
+
+}
+
+TEST(UniformCircle, ZeroDiameterAnalytic)
+{
+
+	UniformCircle generator(
+			UniformCircleProps(0 * mm, UniformCircleProps::Engine::Analytic));
+
+	auto const pos = generator.Generate();
+	EXPECT_DOUBLE_EQ(0.0, pos.getX());
+	EXPECT_DOUBLE_EQ(0.0, pos.getY());
+
+}
+
 }
 
 }
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <vector>
 #include <G4SystemOfUnits.hh>
 #include <gtest/gtest.h>
 
@@ -111,6 +112,39 @@ TEST(UniformRectangle, Generate)
 
 }
 
+TEST(UniformRectangle, GenerateN)
+{
+
+	using namespace isnp::testutil;
+
+	UniformRectangle generator(UniformRectangleProps(120 * mm, 50 * mm));
+
+	std::vector<G4double> xs(1000000), ys(xs.size());
+	generator.GenerateN(xs.data(), ys.data(), xs.size());
+
+	Stat x, y;
+
+	for (std::size_t i = 0; i < xs.size(); i++) {
+		x += xs[i];
+		y += ys[i];
+	}
+
+	EXPECT_TRUE(x.Is(0.0 * mm));
+	EXPECT_NEAR(-60 * mm, x.GetMin(), 0.001 * mm);
+	EXPECT_NEAR(60 * mm, x.GetMax(), 0.001 * mm);
+	EXPECT_NEAR(120 * mm / std::sqrt(12), x.GetStd(), 0.1 * mm);
+
+	EXPECT_TRUE(y.Is(0.0 * mm));
+	EXPECT_NEAR(-25 * mm, y.GetMin(), 0.001 * mm);
+	EXPECT_NEAR(25 * mm, y.GetMax(), 0.001 * mm);
+	EXPECT_NEAR(50.0 * mm / std::sqrt(12), y.GetStd(), 0.1 * mm);
+
+	generator.GetProps().SetXWidth(0);
+	generator.GenerateN(xs.data(), ys.data(), 10);
+	EXPECT_DOUBLE_EQ(0.0, xs[9]);
+
+}
+
 }
 
 }
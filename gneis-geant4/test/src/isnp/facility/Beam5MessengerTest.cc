@@ -106,6 +106,86 @@ TEST(Beam5Messenger, SetHasSpallationTarget) {
 
 }
 
+TEST(Beam5Messenger, SetRegionSettings) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility beam5"));
+
+	auto const facility = Beam5::GetInstance();
+	auto const& shielding = facility->GetRegionSettings(
+			Beam5::Region::Shielding);
+
+	EXPECT_DOUBLE_EQ(0.0, shielding.productionCut);
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/facility/beam5/region/cut shielding 1 cm"));
+
+	// production cuts need no step limiter, track limits do
+	EXPECT_FALSE(facility->HasTrackLimits());
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/facility/beam5/region/maxTime shielding 10 us"));
+	EXPECT_TRUE(facility->HasTrackLimits());
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/facility/beam5/region/minEnergy shielding 1 eV"));
+	EXPECT_DOUBLE_EQ(10 * mm, shielding.productionCut);
+	EXPECT_DOUBLE_EQ(10 * microsecond, shielding.maxTime);
+	EXPECT_DOUBLE_EQ(1 * eV, shielding.minKineticEnergy);
+	EXPECT_DOUBLE_EQ(0.0,
+			facility->GetRegionSettings(Beam5::Region::Target).productionCut);
+
+	EXPECT_NE(0,
+			uiManager->ApplyCommand(
+					"/isnp/facility/beam5/region/cut wall 1 cm"));
+	EXPECT_NE(0,
+			uiManager->ApplyCommand(
+					"/isnp/facility/beam5/region/cut shielding -1 cm"));
+
+	facility->SetRegionSettings(Beam5::Region::Shielding,
+			Beam5::RegionSettings { 0.0, 0.0, 0.0 });
+	EXPECT_FALSE(facility->HasTrackLimits());
+
+}
+
+TEST(Beam5Messenger, SetFastVacuum) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility beam5"));
+
+	auto const facility = Beam5::GetInstance();
+
+	EXPECT_FALSE(facility->GetFastVacuum());
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility/beam5/fastVacuum"));
+	EXPECT_TRUE(facility->GetFastVacuum());
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility/beam5/fastVacuum 0"));
+	EXPECT_FALSE(facility->GetFastVacuum());
+
+}
+
+TEST(Beam5Messenger, SetHasSections) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility beam5"));
+
+	auto const facility = Beam5::GetInstance();
+
+	EXPECT_FALSE(facility->GetHasSections());
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility/beam5/sections"));
+	EXPECT_TRUE(facility->GetHasSections());
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility/beam5/sections 0"));
+	EXPECT_FALSE(facility->GetHasSections());
+
+	EXPECT_DOUBLE_EQ(4., facility->GetSectionSmartless());
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand("/isnp/facility/beam5/sectionSmartless 8"));
+	EXPECT_DOUBLE_EQ(8., facility->GetSectionSmartless());
+	EXPECT_NE(0,
+			uiManager->ApplyCommand("/isnp/facility/beam5/sectionSmartless 0"));
+	facility->SetSectionSmartless(4.);
+
+}
+
 }
 
 }
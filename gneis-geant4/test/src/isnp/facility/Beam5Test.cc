@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <G4UImanager.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4Tubs.hh>
+#include <G4Region.hh>
+#include <G4RegionStore.hh>
+#include <G4ProductionCuts.hh>
+#include <G4SystemOfUnits.hh>
+
+#include "isnp/facility/Beam5.hh"
+#include "isnp/facility/component/SpallationTarget.hh"
+#include "isnp/facility/component/OverlapCache.hh"
+#include "isnp/testutil/Geometry.hh"
+#include "isnp/util/NameBuilder.hh"
+
+namespace isnp {
+
+namespace facility {
+
+/**
+ * Placement of a volume in the world coordinate system.
+ */
+struct Placement {
+	G4String name;
+	G4ThreeVector translation;
+	G4RotationMatrix rotation;
+};
+
+/**
+ * Collects the placements of the volumes below the mother except the section envelopes,
+ * which only regroup the volumes.
+ */
+static void CollectPlacements(G4LogicalVolume const* const mother,
+		G4ThreeVector const& translation, G4RotationMatrix const& rotation,
+		std::vector<Placement>& placements) {
+
+	for (std::size_t i = 0; i < mother->GetNoDaughters(); i++) {
+		auto const daughter = mother->GetDaughter(i);
+		auto const daughterTranslation = translation
+				+ rotation * daughter->GetObjectTranslation();
+		auto const daughterRotation = rotation
+				* daughter->GetObjectRotationValue();
+
+		if (daughter->GetName().find("section") != 0) {
+			placements.push_back(Placement { daughter->GetName(),
+					daughterTranslation, daughterRotation });
+		}
+		CollectPlacements(daughter->GetLogicalVolume(), daughterTranslation,
+				daughterRotation, placements);
+	}
+
+}
+
+static std::vector<Placement> CollectPlacements(
+		G4VPhysicalVolume const* const world) {
+
+	std::vector<Placement> placements;
+	CollectPlacements(world->GetLogicalVolume(), G4ThreeVector(),
+			G4RotationMatrix(), placements);
+
+	// positions are rounded to micrometres not to mix up copies of a volume
+	auto const key = [](Placement const& p) {
+		return std::make_tuple(p.name, std::llround(p.translation.z() / um),
+				std::llround(p.translation.x() / um),
+				std::llround(p.translation.y() / um));
+	};
+	std::sort(std::begin(placements), std::end(placements),
+			[&key](Placement const& a, Placement const& b) {
+				return key(a) < key(b);
+			});
+	return placements;
+
+}
+
+TEST(Beam5, Sections) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility beam5"));
+
+	auto const facility = Beam5::GetInstance();
+	auto const spallationTarget = component::SpallationTarget::GetInstance();
+	auto const rotation = spallationTarget->GetRotation();
+	auto const position = spallationTarget->GetPosition();
+	auto const overlapCache = component::OverlapCache::GetInstance();
+	auto const enabled = overlapCache->GetEnabled();
+	overlapCache->SetEnabled(false);
+
+	// every construction turns and moves the target to the beam
+	facility->SetHasSections(false);
+	auto const flat = facility->Construct();
+	spallationTarget->SetRotation(rotation);
+	spallationTarget->SetPosition(position);
+
+	facility->SetHasSections(true);
+	auto const sectioned = facility->Construct();
+	spallationTarget->SetRotation(rotation);
+	spallationTarget->SetPosition(position);
+
+	facility->SetHasSections(false);
+	overlapCache->SetEnabled(enabled);
+
+	auto const flatPlacements = CollectPlacements(flat);
+	auto const sectionedPlacements = CollectPlacements(sectioned);
+	ASSERT_EQ(flatPlacements.size(), sectionedPlacements.size());
+	for (std::size_t i = 0; i < flatPlacements.size(); i++) {
+		auto const& a = flatPlacements[i];
+		auto const& b = sectionedPlacements[i];
+		EXPECT_EQ(a.name, b.name);
+		EXPECT_NEAR(0.0, (a.translation - b.translation).mag(), 1 * um)
+				<< a.name;
+		EXPECT_TRUE(a.rotation.isNear(b.rotation, 1e-9)) << a.name;
+	}
+
+	auto const world = dynamic_cast<G4Tubs const*>(
+			flat->GetLogicalVolume()->GetSolid());
+	ASSERT_NE(nullptr, world);
+	EXPECT_EQ(0u,
+			testutil::Geometry::CountDifferences(flat->GetLogicalVolume(),
+					sectioned->GetLogicalVolume(),
+					G4ThreeVector(world->GetOuterRadius(),
+							world->GetOuterRadius(), world->GetZHalfLength()),
+					100000));
+
+}
+
+TEST(Beam5, Regions) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility beam5"));
+
+	auto const facility = Beam5::GetInstance();
+	auto const spallationTarget = component::SpallationTarget::GetInstance();
+	auto const rotation = spallationTarget->GetRotation();
+	auto const position = spallationTarget->GetPosition();
+	auto const overlapCache = component::OverlapCache::GetInstance();
+	auto const enabled = overlapCache->GetEnabled();
+	overlapCache->SetEnabled(false);
+	auto const settings = facility->GetRegionSettings(Beam5::Region::Shielding);
+	facility->SetRegionSettings(Beam5::Region::Shielding,
+			Beam5::RegionSettings { 1 * cm, 0, 0 });
+
+	G4String const name = util::NameBuilder::Make("beam5",
+			Beam5::RegionName(Beam5::Region::Shielding).c_str());
+
+	// every construction replaces the root volumes of the region
+	facility->Construct();
+	spallationTarget->SetRotation(rotation);
+	spallationTarget->SetPosition(position);
+	auto const region = G4RegionStore::GetInstance()->GetRegion(name, false);
+	ASSERT_NE(nullptr, region);
+	auto const numOfRootVolumes = region->GetNumberOfRootVolumes();
+	auto const cuts = region->GetProductionCuts();
+
+	facility->SetRegionSettings(Beam5::Region::Shielding,
+			Beam5::RegionSettings { 2 * cm, 0, 0 });
+	facility->Construct();
+	spallationTarget->SetRotation(rotation);
+	spallationTarget->SetPosition(position);
+
+	facility->SetRegionSettings(Beam5::Region::Shielding, settings);
+	overlapCache->SetEnabled(enabled);
+
+	EXPECT_EQ(numOfRootVolumes, region->GetNumberOfRootVolumes());
+	EXPECT_EQ(cuts, region->GetProductionCuts());
+	EXPECT_DOUBLE_EQ(2 * cm, region->GetProductionCuts()->GetProductionCut(0));
+
+}
+
+}
+
+}
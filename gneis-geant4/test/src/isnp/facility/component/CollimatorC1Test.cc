@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <G4Box.hh>
+#include <G4PVPlacement.hh>
+#include <G4NistManager.hh>
+#include <G4SystemOfUnits.hh>
+#include "isnp/facility/component/CollimatorC1.hh"
+#include "isnp/testutil/Geometry.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+static G4LogicalVolume* PlaceInWorld(G4LogicalVolume* const collimator) {
+
+	auto const world = new G4LogicalVolume(
+			new G4Box("world", 0.5 * m, 0.5 * m, 1 * m),
+			G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR"),
+			collimator->GetName() + ":world");
+	new G4PVPlacement(nullptr, G4ThreeVector(), collimator,
+			collimator->GetName(), world, false, 0, true);
+
+	return world;
+
+}
+
+TEST(CollimatorC1, AsNativeCylinder) {
+
+	auto const outerRadius = 200 * mm;
+	auto const air = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+	CollimatorC1 const collimator;
+	auto const boolean = PlaceInWorld(collimator.AsCylinder(outerRadius));
+	auto const native = PlaceInWorld(
+			collimator.AsNativeCylinder(outerRadius, air));
+
+	EXPECT_EQ(0u,
+			testutil::Geometry::CountDifferences(boolean, native,
+					G4ThreeVector(250 * mm, 250 * mm,
+							collimator.GetLength() / 2 + 50 * mm), 100000));
+
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <G4UImanager.hh>
+#include <G4SystemOfUnits.hh>
+#include "isnp/facility/BasicSpallation.hh"
+#include "isnp/facility/component/ImportanceRegions.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+TEST(ImportanceRegionsMessenger, Add) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility basicSpallation"));
+
+	auto const component = ImportanceRegions::GetInstance();
+	EXPECT_TRUE(component != nullptr);
+
+	auto const cmd = "/isnp/facility/component/importance/add";
+
+	EXPECT_EQ(0, uiManager->ApplyCommand(G4String(cmd) + " wall 8 23.2 m"));
+	EXPECT_EQ(0, uiManager->ApplyCommand(G4String(cmd) + " c1 2 5900"));
+	EXPECT_EQ(0, uiManager->ApplyCommand(G4String(cmd) + " wall 4 23 m"));
+	EXPECT_NE(0, uiManager->ApplyCommand(G4String(cmd) + " bad 0 1 m"));
+
+	// regions are ordered by position
+	auto const& regions = component->GetRegions();
+	ASSERT_EQ(2u, regions.size());
+	EXPECT_EQ(G4String("c1"), regions[0].name);
+	EXPECT_DOUBLE_EQ(5.9 * m, regions[0].z);
+	EXPECT_DOUBLE_EQ(2.0, regions[0].importance);
+	EXPECT_EQ(G4String("wall"), regions[1].name);
+	EXPECT_DOUBLE_EQ(23. * m, regions[1].z);
+	EXPECT_DOUBLE_EQ(4.0, regions[1].importance);
+	EXPECT_EQ(G4String("c1 2 5900 wall 4 23000"),
+			uiManager->GetCurrentStringValue(cmd));
+
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/facility/component/importance/clear"));
+	EXPECT_TRUE(component->GetRegions().empty());
+
+}
+
+}
+
+}
+
+}
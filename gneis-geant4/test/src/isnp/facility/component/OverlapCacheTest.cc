@@ -0,0 +1,127 @@
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+#include <G4UImanager.hh>
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4NistManager.hh>
+#include <G4PVPlacement.hh>
+#include <G4SystemOfUnits.hh>
+#include "isnp/facility/component/OverlapCache.hh"
+#include "isnp/util/ContentHash.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+static G4VPhysicalVolume* MakeWorld(G4double const shift) {
+
+	auto const air = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+	auto const logicWorld = new G4LogicalVolume(
+			new G4Box("world", 1 * m, 1 * m, 1 * m), air, "world");
+	auto const world = new G4PVPlacement(nullptr, G4ThreeVector(), logicWorld,
+			"world", nullptr, false, 0, false);
+
+	auto const logicBox = new G4LogicalVolume(
+			new G4Box("box", 10 * cm, 10 * cm, 10 * cm), air, "box");
+	new G4PVPlacement(nullptr, G4ThreeVector(), logicBox, "box1", logicWorld,
+			false, 0, false);
+	new G4PVPlacement(nullptr, G4ThreeVector(0, 0, shift), logicBox, "box2",
+			logicWorld, false, 0, false);
+
+	return world;
+
+}
+
+TEST(OverlapCache, Validate) {
+
+	auto const cache = OverlapCache::GetInstance();
+	auto const savedDirectory = cache->GetDirectory();
+	cache->SetDirectory("overlapCacheTest");
+
+	auto const apart = MakeWorld(50 * cm);
+	auto const overlapping = MakeWorld(15 * cm);
+	EXPECT_EQ(OverlapCache::Hash(apart), OverlapCache::Hash(MakeWorld(50 * cm)));
+	EXPECT_NE(OverlapCache::Hash(apart), OverlapCache::Hash(overlapping));
+
+	EXPECT_EQ(0u, cache->Validate(apart));
+	auto const numOfOverlaps = cache->Validate(overlapping);
+	EXPECT_LT(0u, numOfOverlaps);
+
+	auto const fileName = "overlapCacheTest/overlaps-"
+			+ util::ContentHash::ToString(OverlapCache::Hash(overlapping))
+			+ ".txt";
+
+	// the cached verdict is trusted
+	std::ofstream(fileName) << 7 << '\n';
+	EXPECT_EQ(7u, cache->Validate(overlapping));
+
+	cache->Revalidate();
+	EXPECT_EQ(numOfOverlaps, cache->Validate(overlapping));
+
+	std::remove(
+			("overlapCacheTest/overlaps-"
+					+ util::ContentHash::ToString(OverlapCache::Hash(apart))
+					+ ".txt").c_str());
+	std::remove(fileName.c_str());
+	::rmdir("overlapCacheTest");
+
+	cache->SetDirectory(savedDirectory);
+
+}
+
+TEST(OverlapCache, ExcludeSister) {
+
+	auto const cache = OverlapCache::GetInstance();
+	auto const enabled = cache->GetEnabled();
+	cache->SetEnabled(false);
+
+	// the boxes overlap each other
+	auto const overlapping = MakeWorld(15 * cm);
+	EXPECT_EQ(2u, cache->Validate(overlapping));
+
+	// the excluded box is skipped itself and as the sister of the other box
+	cache->Exclude(overlapping->GetLogicalVolume()->GetDaughter(1));
+	EXPECT_EQ(0u, cache->Validate(overlapping));
+
+	// exclusions hold for one validation
+	EXPECT_EQ(2u, cache->Validate(overlapping));
+
+	cache->SetEnabled(enabled);
+
+}
+
+TEST(OverlapCacheMessenger, SetDirectory) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility basicSpallation"));
+
+	auto const cache = OverlapCache::GetInstance();
+	auto const dir = "/isnp/facility/component/overlapCache/";
+
+	EXPECT_TRUE(cache->GetEnabled());
+	EXPECT_EQ(0, uiManager->ApplyCommand(G4String(dir) + "enable false"));
+	EXPECT_FALSE(cache->GetEnabled());
+	EXPECT_EQ(0, uiManager->ApplyCommand(G4String(dir) + "enable"));
+	EXPECT_TRUE(cache->GetEnabled());
+
+	auto const savedDirectory = cache->GetDirectory();
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(G4String(dir) + "directory /tmp/cache"));
+	EXPECT_EQ(G4String("/tmp/cache"), cache->GetDirectory());
+	cache->SetDirectory(savedDirectory);
+
+	EXPECT_EQ(0, uiManager->ApplyCommand(G4String(dir) + "revalidate"));
+
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <G4UImanager.hh>
+#include <G4SystemOfUnits.hh>
+#include "isnp/facility/BasicSpallation.hh"
+#include "isnp/facility/component/ScoringPlanes.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+TEST(ScoringPlanesMessenger, Add) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility basicSpallation"));
+
+	auto const component = ScoringPlanes::GetInstance();
+	EXPECT_TRUE(component != nullptr);
+
+	auto const cmd = "/isnp/facility/component/scoringPlane/add";
+
+	EXPECT_EQ(0, uiManager->ApplyCommand(G4String(cmd) + " target 500"));
+	EXPECT_EQ(0, uiManager->ApplyCommand(G4String(cmd) + " c5 35 m"));
+	EXPECT_EQ(0, uiManager->ApplyCommand(G4String(cmd) + " target 0.6 m"));
+
+	auto const& planes = component->GetPlanes();
+	ASSERT_EQ(2u, planes.size());
+	EXPECT_EQ(G4String("target"), planes[0].name);
+	EXPECT_DOUBLE_EQ(600. * mm, planes[0].z);
+	EXPECT_EQ(G4String("c5"), planes[1].name);
+	EXPECT_DOUBLE_EQ(35. * m, planes[1].z);
+	EXPECT_EQ(G4String("target 600 c5 35000"),
+			uiManager->GetCurrentStringValue(cmd));
+
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/facility/component/scoringPlane/clear"));
+	EXPECT_TRUE(component->GetPlanes().empty());
+
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <G4Box.hh>
+#include <G4NistManager.hh>
+#include <G4SystemOfUnits.hh>
+#include "isnp/facility/component/SpallationTarget.hh"
+#include "isnp/testutil/Geometry.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+static G4LogicalVolume* PlaceInWorld(G4bool const native) {
+
+	auto const target = SpallationTarget::GetInstance();
+	auto const world = new G4LogicalVolume(
+			new G4Box("world", 0.5 * m, 0.5 * m, 0.5 * m),
+			G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR"),
+			native ? "world:native" : "world");
+
+	auto const savedNative = target->GetNative();
+	auto const savedRotation = target->GetRotation();
+	auto const savedPosition = target->GetPosition();
+
+	target->SetNative(native);
+	target->SetRotation(G4ThreeVector());
+	target->SetPosition(G4ThreeVector());
+	target->Place(world);
+
+	target->SetNative(savedNative);
+	target->SetRotation(savedRotation);
+	target->SetPosition(savedPosition);
+
+	return world;
+
+}
+
+TEST(SpallationTarget, Native) {
+
+	auto const boolean = PlaceInWorld(false);
+	auto const native = PlaceInWorld(true);
+
+	EXPECT_EQ(0u,
+			testutil::Geometry::CountDifferences(boolean, native,
+					G4ThreeVector(150 * mm, 60 * mm, 220 * mm), 100000));
+
+}
+
+}
+
+}
+
+}
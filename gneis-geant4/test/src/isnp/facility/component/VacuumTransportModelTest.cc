@@ -0,0 +1,174 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <G4Box.hh>
+#include <G4Tubs.hh>
+#include <G4LogicalVolume.hh>
+#include <G4NistManager.hh>
+#include <G4PVPlacement.hh>
+#include <G4Region.hh>
+#include <G4Navigator.hh>
+#include <G4TouchableHistory.hh>
+#include <G4Neutron.hh>
+#include <G4DynamicParticle.hh>
+#include <G4Track.hh>
+#include <G4Step.hh>
+#include <G4FastTrack.hh>
+#include <G4FastStep.hh>
+#include <G4PhysicalConstants.hh>
+#include <G4SystemOfUnits.hh>
+#include <geomdefs.hh>
+
+#include "isnp/facility/component/VacuumTransportModel.hh"
+
+namespace isnp {
+
+namespace facility {
+
+namespace component {
+
+static G4double const SIGMA = 0.01 / cm;
+
+/**
+ * Tube 10 cm in radius and 1 m long along Z centred at z = 20 cm,
+ * the residual gas of the tube attenuates neutrons by SIGMA.
+ */
+static G4VPhysicalVolume* MakeTube(G4Region* const envelope) {
+
+	auto const nist = G4NistManager::Instance();
+	auto const vacuum = nist->FindOrBuildMaterial("G4_Galactic");
+	auto const air = nist->FindOrBuildMaterial("G4_AIR");
+
+	auto const logicWorld = new G4LogicalVolume(
+			new G4Box("world", 1 * m, 1 * m, 1 * m), vacuum, "world");
+	auto const world = new G4PVPlacement(nullptr, G4ThreeVector(), logicWorld,
+			"world", nullptr, false, 0, false);
+
+	auto const logicTube = new G4LogicalVolume(
+			new G4Tubs("tube", 0., 10 * cm, 50 * cm, 0., twopi), air, "tube");
+	new G4PVPlacement(nullptr, G4ThreeVector(0, 0, 20 * cm), logicTube, "tube",
+			logicWorld, false, 0, false);
+	envelope->AddRootLogicalVolume(logicTube);
+
+	return world;
+
+}
+
+/**
+ * Moves a neutron of 1 MeV from the position by the model,
+ * the post step point is left in the step.
+ */
+static void Transport(VacuumTransportModel& model, G4Region* const envelope,
+		G4VPhysicalVolume* const world, G4ThreeVector const& position,
+		G4ThreeVector const& direction, G4Step& step) {
+
+	G4Navigator navigator;
+	navigator.SetWorldVolume(world);
+	navigator.LocateGlobalPointAndSetup(position, &direction, false, false);
+
+	auto const track = new G4Track(
+			new G4DynamicParticle(G4Neutron::Definition(), direction, 1 * MeV),
+			0.0, position);
+	track->SetTouchableHandle(navigator.CreateTouchableHistory());
+
+	G4FastTrack fastTrack(envelope, false);
+	fastTrack.SetCurrentTrack(*track, &navigator);
+	ASSERT_TRUE(model.ModelTrigger(fastTrack));
+
+	G4FastStep fastStep;
+	fastStep.Initialize(fastTrack);
+	model.DoIt(fastTrack, fastStep);
+
+	step.InitializeStep(track);
+	fastStep.UpdateStepForPostStep(&step);
+
+}
+
+TEST(VacuumTransportModel, DoIt) {
+
+	auto const envelope = new G4Region("vacuumTransportModelTest");
+	auto const world = MakeTube(envelope);
+	auto const air = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+	VacuumTransportModel model(envelope);
+	model.SetCrossSection([air](G4Material const* const material, G4double) {
+		return material == air ? SIGMA : 0.0;
+	});
+	EXPECT_TRUE(model.IsApplicable(*G4Neutron::Definition()));
+
+	{
+		// along the axis to the end cap of the tube
+		G4Step step;
+		Transport(model, envelope, world, G4ThreeVector(), G4ThreeVector(0, 0, 1),
+				step);
+		auto const postStepPoint = step.GetPostStepPoint();
+		auto const velocity = step.GetTrack()->GetVelocity();
+
+		EXPECT_NEAR(0.0,
+				(postStepPoint->GetPosition() - G4ThreeVector(0, 0, 70 * cm)).mag(),
+				1e-9 * mm);
+		EXPECT_NEAR(70 * cm, step.GetStepLength(), 1e-9 * mm);
+		EXPECT_NEAR(70 * cm / velocity, postStepPoint->GetGlobalTime(), 1e-9 * ns);
+		EXPECT_NEAR(std::exp(-0.7), postStepPoint->GetWeight(), 1e-12);
+		delete step.GetTrack();
+	}
+
+	{
+		// obliquely through the side of the tube
+		G4Step step;
+		Transport(model, envelope, world, G4ThreeVector(),
+				G4ThreeVector(1, 0, 1).unit(), step);
+		auto const postStepPoint = step.GetPostStepPoint();
+
+		EXPECT_NEAR(0.0,
+				(postStepPoint->GetPosition() - G4ThreeVector(10 * cm, 0, 10 * cm)).mag(),
+				1e-9 * mm);
+		EXPECT_NEAR(10 * cm * std::sqrt(2.0), step.GetStepLength(), 1e-9 * mm);
+		EXPECT_NEAR(std::exp(-0.1 * std::sqrt(2.0)), postStepPoint->GetWeight(),
+				1e-12);
+		delete step.GetTrack();
+	}
+
+}
+
+TEST(VacuumTransportModel, EntryFace) {
+
+	auto const envelope = new G4Region("vacuumTransportModelEntryTest");
+	auto const world = MakeTube(envelope);
+
+	VacuumTransportModel model(envelope);
+	model.SetCrossSection([](G4Material const*, G4double) {
+		return SIGMA;
+	});
+
+	// the navigator brings a neutron from upstream onto the entry face
+	G4ThreeVector const direction(0, 0, 1);
+	G4ThreeVector position(0, 0, -50 * cm);
+	G4Navigator navigator;
+	navigator.SetWorldVolume(world);
+	navigator.LocateGlobalPointAndSetup(position, &direction, false, false);
+	G4double safety;
+	auto const length = navigator.ComputeStep(position, direction, kInfinity,
+			safety);
+	EXPECT_NEAR(20 * cm, length, 1e-9 * mm);
+	position += length * direction;
+
+	// and the model takes it to the exit face in one step
+	G4Step step;
+	Transport(model, envelope, world, position, direction, step);
+	auto const postStepPoint = step.GetPostStepPoint();
+
+	EXPECT_NEAR(0.0,
+			(postStepPoint->GetPosition() - G4ThreeVector(0, 0, 70 * cm)).mag(),
+			1e-9 * mm);
+	EXPECT_NEAR(1 * m, step.GetStepLength(), 1e-9 * mm);
+	EXPECT_NEAR(std::exp(-1.0), postStepPoint->GetWeight(), 1e-12);
+	delete step.GetTrack();
+
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,63 @@
+#include <fstream>
+
+#include <G4UImanager.hh>
+
+#include <gtest/gtest.h>
+
+#include <isnp/generator/Emulator.hh>
+
+namespace isnp {
+
+namespace generator {
+
+TEST(EmulatorMessenger, File) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	Emulator emulator;
+
+	EXPECT_EQ("", uiManager->GetCurrentStringValue("/isnp/gun/emulator/file"));
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand("/isnp/gun/emulator/file table1.bin"));
+	EXPECT_EQ("table1.bin", emulator.GetTableFileName());
+	EXPECT_EQ("table1.bin",
+			uiManager->GetCurrentStringValue("/isnp/gun/emulator/file"));
+
+}
+
+TEST(EmulatorMessenger, Bins) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	Emulator emulator;
+
+	EXPECT_EQ("100 50 36 20",
+			uiManager->GetCurrentStringValue("/isnp/gun/emulator/bins"));
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/gun/emulator/bins 10 5 4 3"));
+	EXPECT_EQ(10u, emulator.GetEnergyBins());
+	EXPECT_EQ(5u, emulator.GetAngleBins());
+	EXPECT_EQ(4u, emulator.GetAzimuthBins());
+	EXPECT_EQ(3u, emulator.GetPositionBins());
+	EXPECT_EQ("10 5 4 3",
+			uiManager->GetCurrentStringValue("/isnp/gun/emulator/bins"));
+	EXPECT_EQ(0x18f, uiManager->ApplyCommand("/isnp/gun/emulator/bins 0 5 4 3"));
+
+}
+
+TEST(EmulatorMessenger, BuildMissingSample) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	Emulator emulator;
+
+	// the error is reported, the application goes on
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/gun/emulator/build no-such-sample.txt no-such-table.bin"));
+	EXPECT_FALSE(std::ifstream("no-such-table.bin"));
+
+}
+
+}
+
+}
@@ -0,0 +1,103 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <G4SystemOfUnits.hh>
+#include <G4ParticleTable.hh>
+
+#include <gtest/gtest.h>
+
+#include "isnp/generator/EmulatorTable.hh"
+#include "isnp/util/DataFrameLoader.hh"
+#include "isnp/util/DataFrameMapper.hh"
+
+namespace isnp {
+
+namespace generator {
+
+static util::DataFrame LoadSample(char const* const text) {
+
+	std::stringstream s;
+	s << text;
+	util::DataFrameLoader loader( { "KineticEnergy", "DirectionX",
+			"DirectionY", "DirectionZ", "PositionX", "PositionY", "PositionZ" },
+			{ "Type" }, { "Weight" });
+	return loader.load(s);
+
+}
+
+TEST(EmulatorTable, RoundTrip) {
+
+	G4String const fileName = "EmulatorTableTest.bin";
+
+	// the last row goes backwards and is skipped
+	auto const sample =
+			LoadSample(
+					"Type\tKineticEnergy\tDirectionX\tDirectionY\tDirectionZ\tPositionX\tPositionY\tPositionZ\tWeight\n"
+							"neutron\t1\t0\t0\t1\t-10\t-20\t0\t1\n"
+							"neutron\t100\t0.6\t0\t0.8\t10\t20\t0\t3\n"
+							"gamma\t10\t0\t0\t-1\t0\t0\t0\t1\n");
+
+	{
+		std::ofstream os(fileName, std::ios::binary);
+		EXPECT_EQ(2u, EmulatorTable::Build(sample, EmulatorTable::Binning {
+				10, 5, 4, 3 }, os));
+	}
+
+	{
+		util::DataFrameMapper mapper(EmulatorTable::FloatColumns(),
+				EmulatorTable::CategoryColumns());
+		EmulatorTable const table(
+				std::make_shared < util::DataFrame const
+						> (mapper.map(fileName)));
+
+		EXPECT_EQ(2u, table.Size());
+		EXPECT_DOUBLE_EQ(4.0, table.GetTotalWeight());
+
+		auto const neutron = G4ParticleTable::GetParticleTable()->FindParticle(
+				"neutron");
+
+		int high = 0;
+		int const n = 100000;
+		for (int i = 0; i < n; i++) {
+			auto const p = table.Shoot();
+
+			EXPECT_EQ(neutron, p.particle);
+			EXPECT_LE(1.0 * MeV, p.energy * (1 + 1e-6));
+			EXPECT_GE(100.0 * MeV, p.energy * (1 - 1e-6));
+			EXPECT_NEAR(1.0, p.direction.mag(), 1e-9);
+			EXPECT_LT(0.0, p.direction.z());
+			EXPECT_EQ(0.0, p.position.z());
+			EXPECT_LE(-10.0 * mm, p.position.x() * (1 - 1e-6));
+			EXPECT_GE(10.0 * mm, p.position.x() * (1 - 1e-6));
+
+			if (p.energy > 10.0 * MeV) {
+				high++;
+			}
+		}
+
+		// bins are drawn by their weights
+		EXPECT_NEAR(0.75, static_cast<G4double>(high) / n, 0.01);
+	}
+
+	std::remove(fileName.c_str());
+
+}
+
+TEST(EmulatorTable, Empty) {
+
+	auto const sample =
+			LoadSample(
+					"Type\tKineticEnergy\tDirectionX\tDirectionY\tDirectionZ\tPositionX\tPositionY\tPositionZ\n"
+							"gamma\t10\t0\t0\t-1\t0\t0\t0\n");
+
+	std::stringstream os;
+	EXPECT_THROW(
+			EmulatorTable::Build(sample, EmulatorTable::Binning { 10, 5, 4, 3 }, os),
+			EmulatorTable::EmptySampleException);
+
+}
+
+}
+
+}
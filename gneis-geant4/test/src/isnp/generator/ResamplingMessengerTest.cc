@@ -1,4 +1,5 @@
 #include <cmath>
+#include <fstream>
 
 #include <G4RunManager.hh>
 #include <G4SystemOfUnits.hh>
@@ -66,6 +67,110 @@ TEST(ResamplingMessenger, SetFile) {
 
 }
 
+TEST(ResamplingMessenger, Mode) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	Resampling resampling;
+
+	EXPECT_EQ(Resampling::Mode::Memory, resampling.GetMode());
+	EXPECT_EQ("memory",
+			uiManager->GetCurrentStringValue("/isnp/gun/resampling/mode"));
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/gun/resampling/mode stream"));
+	EXPECT_EQ(Resampling::Mode::Stream, resampling.GetMode());
+	EXPECT_EQ("stream",
+			uiManager->GetCurrentStringValue("/isnp/gun/resampling/mode"));
+	EXPECT_NE(0, uiManager->ApplyCommand("/isnp/gun/resampling/mode disk"));
+
+}
+
+TEST(ResamplingMessenger, BlockSize) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	Resampling resampling;
+
+	EXPECT_EQ(1000000,
+			uiManager->GetCurrentIntValue("/isnp/gun/resampling/blockSize"));
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand("/isnp/gun/resampling/blockSize 1000"));
+	EXPECT_EQ(1000u, resampling.GetBlockSize());
+	EXPECT_EQ(0x18f,
+			uiManager->ApplyCommand("/isnp/gun/resampling/blockSize 0"));
+
+}
+
+TEST(ResamplingMessenger, ShuffleBlocks) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	Resampling resampling;
+
+	EXPECT_TRUE(resampling.GetShuffleBlocks());
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/gun/resampling/shuffleBlocks false"));
+	EXPECT_FALSE(resampling.GetShuffleBlocks());
+	EXPECT_FALSE(
+			uiManager->GetCurrentBoolValue(
+					"/isnp/gun/resampling/shuffleBlocks"));
+
+}
+
+TEST(ResamplingMessenger, ProjectPositions) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	Resampling resampling;
+
+	EXPECT_TRUE(resampling.GetProjectPositions());
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/gun/resampling/projectPositions false"));
+	EXPECT_FALSE(resampling.GetProjectPositions());
+	EXPECT_FALSE(
+			uiManager->GetCurrentBoolValue(
+					"/isnp/gun/resampling/projectPositions"));
+
+}
+
+TEST(ResamplingMessenger, Importance) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	Resampling resampling;
+
+	EXPECT_EQ("",
+			uiManager->GetCurrentStringValue("/isnp/gun/resampling/importance"));
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand("/isnp/gun/resampling/importance 1 10"));
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/gun/resampling/importance 100 2 keV"));
+	EXPECT_EQ("0.1 2 1 10", resampling.GetEnergyImportance());
+	EXPECT_EQ(0x18f,
+			uiManager->ApplyCommand("/isnp/gun/resampling/importance 1 0"));
+
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand("/isnp/gun/resampling/clearImportance"));
+	EXPECT_EQ("", resampling.GetEnergyImportance());
+
+}
+
+TEST(ResamplingMessenger, ConvertMissingFile) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	Resampling resampling;
+
+	// the error is reported, the application goes on
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/gun/resampling/convert no-such-file.txt no-such-file.bin"));
+	EXPECT_FALSE(std::ifstream("no-such-file.bin"));
+
+}
+
 }
 
 }
@@ -1,10 +1,16 @@
+#include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <sstream>
+#include <vector>
 
 #include <G4UImanager.hh>
 #include <G4RunManager.hh>
 #include <G4SystemOfUnits.hh>
 #include <G4RotationMatrix.hh>
+#include <G4ParticleTable.hh>
+#include <Randomize.hh>
 
 #include <gtest/gtest.h>
 
@@ -12,6 +18,9 @@
 #include "isnp/testutil/Stat.hh"
 #include "isnp/testutil/SampleData.hh"
 #include "isnp/facility/component/BeamPointer.hh"
+#include "isnp/generator/ResamplingSampler.hh"
+#include "isnp/util/DataFrameLoader.hh"
+#include "isnp/util/RandomNumberGenerator.hh"
 
 namespace isnp {
 
@@ -138,6 +147,321 @@ TEST(Resampling, DetectBeamTransform) {
 
 }
 
+TEST(Resampling, ProjectPositions) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/facility basicSpallation"));
+
+	Resampling resampling;
+	resampling.SetVerboseLevel(1);
+	resampling.SetProjectPositions(false);
+
+	{
+		std::stringstream s;
+		s << data;
+		resampling.Load(s);
+	}
+
+	G4Event event;
+	resampling.GeneratePrimaries(&event);
+	auto const v = event.GetPrimaryVertex(0);
+
+	// recorded positions are kept as they are
+	EXPECT_NEAR(100.0 * mm, v->GetPosition().getX(), 0.05 * mm);
+	EXPECT_NEAR(200.0 * mm, v->GetPosition().getY(), 0.05 * mm);
+	EXPECT_NEAR(300.0 * mm, v->GetPosition().getZ(), 0.05 * mm);
+
+}
+
+TEST(Resampling, BinarySample) {
+
+	G4String const textFileName = "ResamplingTest.txt";
+	G4String const binaryFileName = "ResamplingTest.bin";
+
+	{
+		std::ofstream f(textFileName);
+		f << data;
+	}
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	Resampling resampling;
+	resampling.SetVerboseLevel(1);
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/gun/resampling/convert " + textFileName + " "
+							+ binaryFileName));
+	resampling.SetSampleFileName(binaryFileName);
+
+	G4Event event;
+	resampling.GeneratePrimaries(&event);
+	auto const p = event.GetPrimaryVertex(0)->GetPrimary();
+
+	EXPECT_EQ("neutron", p->GetParticleDefinition()->GetParticleName());
+	EXPECT_NEAR(1000.0 * MeV, p->GetKineticEnergy(), 0.01 * MeV);
+
+	std::remove(textFileName.c_str());
+	std::remove(binaryFileName.c_str());
+
+}
+
+TEST(Resampling, EmptySample) {
+
+	G4String const fileName = "ResamplingEmptyTest.txt";
+	{
+		std::ofstream f(fileName);
+	}
+
+	{
+		Resampling resampling;
+		resampling.SetSampleFileName(fileName);
+		G4Event event;
+		EXPECT_THROW(resampling.GeneratePrimaries(&event),
+				Resampling::EmptySampleException);
+	}
+
+	std::remove(fileName.c_str());
+
+}
+
+TEST(Resampling, HeaderOnlySample) {
+
+	std::stringstream s;
+	s << "Type\tKineticEnergy\tDirectionX\tDirectionY\tDirectionZ\tPositionX\tPositionY\tPositionZ\n";
+
+	Resampling resampling;
+	EXPECT_THROW(resampling.Load(s), Resampling::EmptySampleException);
+
+}
+
+TEST(Resampling, WeightedSample) {
+
+	std::stringstream s;
+	s << "Type\tKineticEnergy\tDirectionX\tDirectionY\tDirectionZ\tPositionX\tPositionY\tPositionZ\tWeight\n"
+			<< "neutron\t10.0000\t0.000000\t0.000000\t1.000000\t0.00000\t0.00000\t0.00000\t3\n"
+			<< "neutron\t20.0000\t0.000000\t0.000000\t1.000000\t0.00000\t0.00000\t0.00000\t1\n"
+			<< "neutron\t30.0000\t0.000000\t0.000000\t1.000000\t0.00000\t0.00000\t0.00000\t0\n";
+
+	Resampling resampling;
+	resampling.SetVerboseLevel(1);
+	resampling.Load(s);
+
+	int const numOfEvents = 100000;
+	int low = 0, high = 0;
+	for (int i = 0; i < numOfEvents; i++) {
+		G4Event event;
+		resampling.GeneratePrimaries(&event);
+		auto const p = event.GetPrimaryVertex(0)->GetPrimary();
+		if (p->GetKineticEnergy() < 15.0 * MeV) {
+			low++;
+		} else if (p->GetKineticEnergy() < 25.0 * MeV) {
+			high++;
+		}
+	}
+
+	EXPECT_EQ(numOfEvents, low + high);
+	EXPECT_NEAR(0.75, static_cast<G4double>(low) / numOfEvents, 0.01);
+
+}
+
+TEST(Resampling, WeightedStream) {
+
+	// blocks of two rows, the second block weighs three times more than the first one
+	G4String const fileName = "ResamplingTest.txt";
+	{
+		std::ofstream f(fileName);
+		f << "Type\tKineticEnergy\tDirectionX\tDirectionY\tDirectionZ\tPositionX\tPositionY\tPositionZ\tWeight\n"
+				<< "neutron\t10.0000\t0.000000\t0.000000\t1.000000\t0.00000\t0.00000\t0.00000\t1\n"
+				<< "neutron\t20.0000\t0.000000\t0.000000\t1.000000\t0.00000\t0.00000\t0.00000\t1\n"
+				<< "neutron\t30.0000\t0.000000\t0.000000\t1.000000\t0.00000\t0.00000\t0.00000\t2\n"
+				<< "neutron\t40.0000\t0.000000\t0.000000\t1.000000\t0.00000\t0.00000\t0.00000\t4\n";
+	}
+
+	int const numOfEvents = 100000;
+	auto const fractions = [numOfEvents](Resampling& resampling) {
+		std::vector<G4double> result(4);
+		for (int i = 0; i < numOfEvents; i++) {
+			G4Event event;
+			resampling.GeneratePrimaries(&event);
+			auto const e = event.GetPrimaryVertex(0)->GetPrimary()->GetKineticEnergy();
+			result[static_cast<std::size_t>(e / (10.0 * MeV) - 0.5)] += 1.0 / numOfEvents;
+		}
+		return result;
+	};
+
+	Resampling whole;
+	whole.SetSampleFileName(fileName);
+	auto const expected = fractions(whole);
+
+	Resampling streamed;
+	streamed.SetMode(Resampling::Mode::Stream);
+	streamed.SetBlockSize(2);
+	streamed.SetSampleFileName(fileName);
+	auto const actual = fractions(streamed);
+
+	for (std::size_t i = 0; i < expected.size(); i++) {
+		EXPECT_NEAR(expected[i], actual[i], 0.01);
+	}
+	EXPECT_NEAR(0.5, actual[3], 0.01);
+
+	std::remove(fileName.c_str());
+
+}
+
+TEST(Resampling, EnergyImportance) {
+
+	std::stringstream s;
+	s << "Type\tKineticEnergy\tDirectionX\tDirectionY\tDirectionZ\tPositionX\tPositionY\tPositionZ\n"
+			<< "neutron\t10.0000\t0.000000\t0.000000\t1.000000\t0.00000\t0.00000\t0.00000\n"
+			<< "neutron\t20.0000\t0.000000\t0.000000\t1.000000\t0.00000\t0.00000\t0.00000\n";
+
+	Resampling resampling;
+	resampling.SetVerboseLevel(1);
+	resampling.AddEnergyImportance(15.0 * MeV, 4.0);
+	resampling.Load(s);
+
+	int const numOfEvents = 100000;
+	int high = 0;
+	G4double totalWeight = 0, highWeight = 0;
+	for (int i = 0; i < numOfEvents; i++) {
+		G4Event event;
+		resampling.GeneratePrimaries(&event);
+		auto const v = event.GetPrimaryVertex(0);
+		totalWeight += v->GetWeight();
+		if (v->GetPrimary()->GetKineticEnergy() > 15.0 * MeV) {
+			high++;
+			highWeight += v->GetWeight();
+			EXPECT_DOUBLE_EQ(0.625, v->GetWeight());
+		} else {
+			EXPECT_DOUBLE_EQ(2.5, v->GetWeight());
+		}
+	}
+
+	// important rows are drawn 4 times more often, weighted frequencies are unbiased
+	EXPECT_NEAR(0.8, static_cast<G4double>(high) / numOfEvents, 0.01);
+	EXPECT_NEAR(1.0, totalWeight / numOfEvents, 0.02);
+	EXPECT_NEAR(0.5, highWeight / numOfEvents, 0.01);
+
+}
+
+TEST(Resampling, Acceptance) {
+
+	std::stringstream s;
+	s << "Type\tKineticEnergy\tDirectionX\tDirectionY\tDirectionZ\tPositionX\tPositionY\tPositionZ\tWeight\n"
+			<< "neutron\t10.0000\t0.000000\t0.000000\t1.000000\t0.00000\t0.00000\t0.00000\t1\n"
+			<< "neutron\t20.0000\t0.000000\t0.000000\t1.000000\t0.00000\t0.00000\t0.00000\t2\n"
+			<< "neutron\t30.0000\t0.600000\t0.000000\t0.800000\t0.00000\t0.00000\t0.00000\t3\n";
+
+	util::ApertureChain apertures;
+	apertures.AddCircle(1000 * mm, 0, 20 * mm);
+	auto const bp = facility::component::BeamPointer::GetInstance();
+	bp->SetApertures(apertures);
+
+	Resampling resampling;
+	resampling.SetVerboseLevel(1);
+	resampling.SetAcceptance(true);
+	resampling.Load(s);
+
+	int const numOfEvents = 10000;
+	int high = 0;
+	for (int i = 0; i < numOfEvents; i++) {
+		G4Event event;
+		resampling.GeneratePrimaries(&event);
+		auto const v = event.GetPrimaryVertex(0);
+		auto const p = v->GetPrimary();
+
+		// the third direction misses the aperture, the other ones carry its weight fraction
+		EXPECT_NEAR(0.0, p->GetMomentumDirection().getX(), 1e-5);
+		EXPECT_DOUBLE_EQ(0.5, v->GetWeight());
+		if (p->GetKineticEnergy() > 25.0 * MeV) {
+			high++;
+		}
+	}
+
+	// energies are not affected by the acceptance
+	EXPECT_NEAR(0.5, static_cast<G4double>(high) / numOfEvents, 0.02);
+
+	bp->SetApertures(util::ApertureChain());
+
+}
+
+/**
+ * Compares per-event sampling with column lookups by name (as it was done before ResamplingSampler)
+ * and with the bound sampler. Run with --gtest_also_run_disabled_tests.
+ */
+TEST(Resampling, DISABLED_Benchmark) {
+
+	using namespace isnp::testutil;
+	using Clock = std::chrono::steady_clock;
+
+	int const numOfEvents = 10000000;
+
+	std::stringstream s;
+	s << SampleData_txt;
+	util::DataFrameLoader loader( { "KineticEnergy", "DirectionX",
+			"DirectionY", "DirectionZ", "PositionX", "PositionY", "PositionZ" },
+			{ "Type" });
+	auto const df = std::make_shared < util::DataFrame const > (loader.load(s));
+	auto const particleTable = G4ParticleTable::GetParticleTable();
+
+	auto const shootNumber = [&df](G4String const& column,
+			util::DataFrame::size_type const rowNo) {
+		auto const v = df->FloatValue(column, rowNo);
+		auto const precision = df->Precision(column);
+		return precision > 0 ?
+				util::RandomNumberGenerator::locality(v, precision) : v;
+	};
+
+	G4double sum = 0.0;
+
+	auto const legacyStart = Clock::now();
+	for (int i = 0; i < numOfEvents; i++) {
+		auto const rowNo = CLHEP::RandFlat::shootInt(df->Size());
+		auto const particle = particleTable->FindParticle(
+				df->CategoryValue("Type", rowNo));
+		G4ThreeVector const dir(shootNumber("DirectionX", rowNo),
+				shootNumber("DirectionY", rowNo),
+				shootNumber("DirectionZ", rowNo));
+		G4ThreeVector const pos(shootNumber("PositionX", rowNo),
+				shootNumber("PositionY", rowNo),
+				shootNumber("PositionZ", rowNo));
+		auto const dirRowNo = CLHEP::RandFlat::shootInt(df->Size());
+		G4ThreeVector const dir2(shootNumber("DirectionX", dirRowNo),
+				shootNumber("DirectionY", dirRowNo),
+				shootNumber("DirectionZ", dirRowNo));
+		sum += shootNumber("KineticEnergy", rowNo) + dir.getX() + pos.getX()
+				+ dir2.getX() + (particle ? 1 : 0);
+	}
+	std::chrono::duration<double> const legacyTime = Clock::now()
+			- legacyStart;
+
+	ResamplingSampler const sampler(df, "KineticEnergy", "DirectionX",
+			"DirectionY", "DirectionZ", "PositionX", "PositionY", "PositionZ",
+			"Type", "Weight", EnergyImportance(), util::ApertureChain());
+
+	auto const samplerStart = Clock::now();
+	for (int i = 0; i < numOfEvents; i++) {
+		auto const rowNo = CLHEP::RandFlat::shootInt(sampler.Size());
+		auto const particle = sampler.Particle(rowNo);
+		auto const dir = sampler.ShootDirection(rowNo);
+		auto const pos = sampler.ShootPosition(rowNo);
+		auto const dirRowNo = CLHEP::RandFlat::shootInt(sampler.Size());
+		auto const dir2 = sampler.ShootDirection(dirRowNo);
+		sum += sampler.ShootEnergy(rowNo) + dir.getX() + pos.getX()
+				+ dir2.getX() + (particle ? 1 : 0);
+	}
+	std::chrono::duration<double> const samplerTime = Clock::now()
+			- samplerStart;
+
+	G4cout << "Resampling benchmark: lookup by name "
+			<< numOfEvents / legacyTime.count() << " events/s, sampler "
+			<< numOfEvents / samplerTime.count() << " events/s (checksum "
+			<< sum << ")" << G4endl;
+
+	EXPECT_LT(samplerTime.count(), legacyTime.count());
+
+}
+
 }
 
 }
@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "isnp/generator/SampleRegistry.hh"
+#include "isnp/util/DataFrameLoader.hh"
+
+namespace isnp {
+
+namespace generator {
+
+static SampleRegistry::SamplerPtr MakeSampler(unsigned& numOfCalls) {
+
+	++numOfCalls;
+
+	std::stringstream s;
+	s << "Type\tKineticEnergy\tDirectionX\tDirectionY\tDirectionZ\tPositionX\tPositionY\tPositionZ\n"
+			<< "neutron\t1000.00\t0.500000\t0.250000\t0.829156\t100.000\t200.000\t300.000\n";
+
+	util::DataFrameLoader loader( { "KineticEnergy", "DirectionX",
+			"DirectionY", "DirectionZ", "PositionX", "PositionY", "PositionZ" },
+			{ "Type" });
+
+	return std::make_shared < ResamplingSampler const
+			> (std::make_shared < util::DataFrame const > (loader.load(s)),
+					"KineticEnergy", "DirectionX", "DirectionY", "DirectionZ",
+					"PositionX", "PositionY", "PositionZ", "Type",
+					"Weight", EnergyImportance(), util::ApertureChain());
+
+}
+
+TEST(SampleRegistry, Get) {
+
+	G4String const fileName = "SampleRegistryTest.txt";
+	{
+		std::ofstream f(fileName);
+		f << "sample";
+	}
+
+	auto& registry = SampleRegistry::GetInstance();
+	unsigned numOfCalls = 0;
+	auto const loader = [&numOfCalls] {
+		return MakeSampler(numOfCalls);
+	};
+
+	{
+		auto const s1 = registry.Get(fileName, loader);
+		auto const s2 = registry.Get(fileName, loader);
+		EXPECT_EQ(1, numOfCalls);
+		EXPECT_EQ(s1.get(), s2.get());
+		EXPECT_EQ(1, s1->Size());
+	}
+
+	// sample is released when nobody refers to it
+	registry.Get(fileName, loader);
+	EXPECT_EQ(2, numOfCalls);
+
+	std::remove(fileName.c_str());
+
+}
+
+}
+
+}
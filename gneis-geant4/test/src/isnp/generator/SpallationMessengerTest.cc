@@ -244,6 +244,29 @@ TEST(SpallationMessenger, SetMode) {
 
 }
 
+TEST(SpallationMessenger, CircleEngine) {
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	Spallation spallation;
+
+	EXPECT_EQ("Rejection",
+			uiManager->GetCurrentStringValue(
+					"/isnp/gun/spallation/circleEngine"));
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/gun/spallation/circleEngine Analytic"));
+	EXPECT_EQ(dist::UniformCircleProps::Engine::Analytic,
+			spallation.GetUniformCircle().GetProps().GetEngine());
+	EXPECT_EQ("Analytic",
+			uiManager->GetCurrentStringValue(
+					"/isnp/gun/spallation/circleEngine"));
+	EXPECT_EQ(500,
+			uiManager->ApplyCommand(
+					"/isnp/gun/spallation/circleEngine badValue"));
+
+}
+
 }
 
 }
@@ -1,4 +1,6 @@
+#include <chrono>
 #include <cmath>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -293,6 +295,74 @@ TEST(Spallation, DetectTargetTransform) {
 
 }
 
+TEST(Spallation, ResetPositions) {
+
+	Spallation spallation;
+	spallation.SetMode(Spallation::Mode::UniformCircle);
+	G4Transform3D const zeroTransform;
+
+	spallation.GeneratePosition(zeroTransform);
+	spallation.GetUniformCircle().GetProps().SetDiameter(0.0);
+	{
+		auto const pos = spallation.GeneratePosition(zeroTransform);
+		EXPECT_DOUBLE_EQ(0.0, pos.getX());
+		EXPECT_DOUBLE_EQ(0.0, pos.getY());
+	}
+
+	spallation.SetMode(Spallation::Mode::UniformRectangle);
+	spallation.GetUniformRectangle().GetProps().SetXWidth(0.0);
+	spallation.GetUniformRectangle().GetProps().SetYWidth(10.0 * mm);
+	for (int i = 0; i < 1000; i++) {
+		auto const pos = spallation.GeneratePosition(zeroTransform);
+		EXPECT_DOUBLE_EQ(0.0, pos.getX());
+		EXPECT_GE(5.0 * mm, std::fabs(pos.getY()));
+	}
+
+}
+
+TEST(Spallation, DISABLED_Benchmark) {
+
+	using Clock = std::chrono::steady_clock;
+
+	std::size_t const numOfPoints = 10000000;
+	std::size_t const batchSize = 256;
+
+	Spallation spallation;
+	std::vector<G4double> x(batchSize), y(batchSize);
+	dist::AbstractDistribution const* const distributions[] = {
+			&spallation.GetUniformRectangle(), &spallation.GetUniformCircle(),
+			&spallation.GetGaussEllipse() };
+	char const* const names[] = { "UniformRectangle", "UniformCircle",
+			"GaussEllipse" };
+
+	for (std::size_t d = 0; d < 3; d++) {
+		auto const& distribution = *distributions[d];
+		G4double sum = 0.0;
+
+		auto const singleStart = Clock::now();
+		for (std::size_t i = 0; i < numOfPoints; i++) {
+			auto const pos = distribution.Generate();
+			sum += pos.getX() + pos.getY();
+		}
+		std::chrono::duration<double> const singleTime = Clock::now()
+				- singleStart;
+
+		auto const batchStart = Clock::now();
+		for (std::size_t i = 0; i < numOfPoints; i += batchSize) {
+			distribution.GenerateN(x.data(), y.data(), batchSize);
+			sum += x[0] + y[0];
+		}
+		std::chrono::duration<double> const batchTime = Clock::now()
+				- batchStart;
+
+		G4cout << "Spallation benchmark: " << names[d] << " per call "
+				<< numOfPoints / singleTime.count() << " points/s, batched "
+				<< numOfPoints / batchTime.count() << " points/s (checksum "
+				<< sum << ")" << G4endl;
+	}
+
+}
+
 }
 
 }
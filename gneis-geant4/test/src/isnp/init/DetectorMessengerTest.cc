@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <G4UImanager.hh>
+#include "isnp/detector/Basic.hh"
+
+namespace isnp {
+
+namespace init {
+
+TEST(DetectorMessenger, Format)
+{
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/detector/format binary"));
+	EXPECT_EQ(detector::Basic::Format::Binary, detector::Basic::GetFormat());
+	EXPECT_EQ("binary",
+			uiManager->GetCurrentStringValue("/isnp/detector/format"));
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/detector/format text"));
+	EXPECT_EQ(detector::Basic::Format::Text, detector::Basic::GetFormat());
+	EXPECT_EQ("text", uiManager->GetCurrentStringValue("/isnp/detector/format"));
+
+	EXPECT_EQ(500, uiManager->ApplyCommand("/isnp/detector/format csv"));
+
+}
+
+TEST(DetectorMessenger, FlushThreshold)
+{
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	EXPECT_EQ(0,
+			uiManager->GetCurrentIntValue("/isnp/detector/flushThreshold"));
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand("/isnp/detector/flushThreshold 100000"));
+	EXPECT_EQ(100000u, detector::Basic::GetFlushThreshold());
+	EXPECT_EQ(100000,
+			uiManager->GetCurrentIntValue("/isnp/detector/flushThreshold"));
+	EXPECT_EQ(0x18f,
+			uiManager->ApplyCommand("/isnp/detector/flushThreshold -1"));
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/detector/flushThreshold 0"));
+	EXPECT_EQ(0u, detector::Basic::GetFlushThreshold());
+
+}
+
+TEST(DetectorMessenger, WriteHits)
+{
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	EXPECT_TRUE(uiManager->GetCurrentBoolValue("/isnp/detector/writeHits"));
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/detector/writeHits false"));
+	EXPECT_FALSE(detector::Basic::GetWriteHits());
+	EXPECT_FALSE(uiManager->GetCurrentBoolValue("/isnp/detector/writeHits"));
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/detector/writeHits true"));
+	EXPECT_TRUE(detector::Basic::GetWriteHits());
+
+}
+
+}
+
+}
@@ -16,6 +16,26 @@ TEST(PhysListMessenger, SetPhysList)
 
 }
 
+TEST(PhysListMessenger, PhysicsCache)
+{
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	EXPECT_TRUE(uiManager->GetCurrentBoolValue("/isnp/physicsCache"));
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/physicsCache false"));
+	EXPECT_FALSE(uiManager->GetCurrentBoolValue("/isnp/physicsCache"));
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/physicsCache"));
+	EXPECT_TRUE(uiManager->GetCurrentBoolValue("/isnp/physicsCache"));
+
+	EXPECT_EQ(G4String("isnp-cache"),
+			uiManager->GetCurrentStringValue("/isnp/physicsCacheDir"));
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/physicsCacheDir /tmp/tables"));
+	EXPECT_EQ(G4String("/tmp/tables"),
+			uiManager->GetCurrentStringValue("/isnp/physicsCacheDir"));
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/physicsCacheDir isnp-cache"));
+
+}
+
 }
 
 }
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Material.hh>
+#include <G4NistManager.hh>
+#include <G4PVPlacement.hh>
+#include <G4ProductionCuts.hh>
+#include <G4Region.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4TransportationManager.hh>
+#include "isnp/init/PhysicsTableCache.hh"
+
+namespace isnp {
+
+namespace init {
+
+static G4VPhysicalVolume* MakeWorld(G4double const halfLength) {
+
+	auto const air = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+	auto const logicWorld = new G4LogicalVolume(
+			new G4Box("world", 1 * m, 1 * m, halfLength), air, "world");
+
+	return new G4PVPlacement(nullptr, G4ThreeVector(), logicWorld, "world",
+			nullptr, false, 0, false);
+
+}
+
+TEST(PhysicsTableCache, MakeKey) {
+
+	PhysicsTableCache cache;
+	cache.SetPhysicsList(nullptr, "QGSP_INCLXX_HP");
+	auto key = cache.MakeKey();
+	EXPECT_EQ(key, cache.MakeKey());
+
+	// description of the physics list
+	cache.SetPhysicsList(nullptr, "QGSP_INCLXX_HP neutron");
+	EXPECT_NE(key, cache.MakeKey());
+	cache.SetPhysicsList(nullptr, "QGSP_INCLXX_HP");
+	EXPECT_EQ(key, cache.MakeKey());
+
+	// a new material
+	new G4Material("physicsTableCacheTest", 1., 1.008 * g / mole,
+			0.07 * g / cm3);
+	EXPECT_NE(key, cache.MakeKey());
+	key = cache.MakeKey();
+	EXPECT_EQ(key, cache.MakeKey());
+
+	// production cut of a region
+	auto const region = new G4Region("physicsTableCacheTest");
+	auto const cuts = new G4ProductionCuts;
+	cuts->SetProductionCut(1 * mm);
+	region->SetProductionCuts(cuts);
+	auto const regionKey = cache.MakeKey();
+	EXPECT_NE(key, regionKey);
+	cuts->SetProductionCut(2 * mm);
+	EXPECT_NE(regionKey, cache.MakeKey());
+	cuts->SetProductionCut(1 * mm);
+	EXPECT_EQ(regionKey, cache.MakeKey());
+	delete region;
+	EXPECT_EQ(key, cache.MakeKey());
+
+	// geometry
+	auto const navigator =
+			G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+	auto const savedWorld = navigator->GetWorldVolume();
+	navigator->SetWorldVolume(MakeWorld(1 * m));
+	key = cache.MakeKey();
+	navigator->SetWorldVolume(MakeWorld(2 * m));
+	EXPECT_NE(key, cache.MakeKey());
+	navigator->SetWorldVolume(MakeWorld(1 * m));
+	EXPECT_EQ(key, cache.MakeKey());
+	navigator->SetWorldVolume(savedWorld);
+
+}
+
+}
+
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <G4UImanager.hh>
+#include <G4SystemOfUnits.hh>
+#include "isnp/detector/Basic.hh"
+#include "isnp/detector/NextEventAction.hh"
+
+namespace isnp {
+
+namespace init {
+
+TEST(ScoreMessenger, Histogram1D)
+{
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/score/clear"));
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/score/histogram1D spectrum energy 100 1e-3 1e3 log"));
+
+	auto const h = detector::Basic::FindHistogram("spectrum");
+	ASSERT_NE(nullptr, h);
+	EXPECT_FALSE(h->IsTwoDimensional());
+	EXPECT_EQ(detector::Histogram::Quantity::Energy, h->GetX().GetQuantity());
+	EXPECT_EQ(100u, h->GetX().GetNumOfBins());
+	EXPECT_DOUBLE_EQ(1e-3, h->GetX().GetMin());
+	EXPECT_DOUBLE_EQ(1e3, h->GetX().GetMax());
+	EXPECT_EQ(detector::Histogram::Scale::Log, h->GetX().GetScale());
+
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand("/isnp/score/histogram1D profile x 10 -5 5"));
+	EXPECT_EQ(detector::Histogram::Scale::Linear,
+			detector::Basic::FindHistogram("profile")->GetX().GetScale());
+	EXPECT_EQ(2u, detector::Basic::GetHistograms().size());
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/score/clear"));
+	EXPECT_EQ(nullptr, detector::Basic::FindHistogram("spectrum"));
+
+}
+
+TEST(ScoreMessenger, Histogram2D)
+{
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/score/histogram2D map x 10 -5 5 lin y 20 -10 10 lin"));
+
+	auto const h = detector::Basic::FindHistogram("map");
+	ASSERT_NE(nullptr, h);
+	EXPECT_TRUE(h->IsTwoDimensional());
+	EXPECT_EQ(detector::Histogram::Quantity::Y, h->GetY().GetQuantity());
+	EXPECT_EQ(20u, h->GetY().GetNumOfBins());
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/score/particle map neutron"));
+	EXPECT_EQ("neutron", h->GetParticleName());
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/score/particle map all"));
+	EXPECT_EQ("", h->GetParticleName());
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/score/value map time"));
+	EXPECT_EQ(detector::Histogram::Quantity::Time, h->GetValue());
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/score/clear"));
+
+}
+
+TEST(ScoreMessenger, InvalidAxis)
+{
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand(
+					"/isnp/score/histogram1D bad energy 10 0 100 log"));
+	EXPECT_EQ(nullptr, detector::Basic::FindHistogram("bad"));
+	EXPECT_NE(0,
+			uiManager->ApplyCommand("/isnp/score/histogram1D bad mass 10 0 1"));
+
+}
+
+TEST(ScoreMessenger, NextEvent)
+{
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+	auto const& points = detector::NextEventAction::GetPoints();
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/score/clearNextEvent"));
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand("/isnp/score/nextEvent far 0 0 36 0 m"));
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand("/isnp/score/nextEvent disk 10 20 1000 50"));
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand("/isnp/score/nextEvent far 0 0 35 0 m"));
+	EXPECT_NE(0,
+			uiManager->ApplyCommand("/isnp/score/nextEvent bad 0 0 1 -1"));
+
+	ASSERT_EQ(2u, points.size());
+	EXPECT_EQ(G4String("far"), points[0].name);
+	EXPECT_DOUBLE_EQ(35. * m, points[0].position.getZ());
+	EXPECT_DOUBLE_EQ(0.0, points[0].radius);
+	EXPECT_EQ(G4String("disk"), points[1].name);
+	EXPECT_DOUBLE_EQ(20. * mm, points[1].position.getY());
+	EXPECT_DOUBLE_EQ(50. * mm, points[1].radius);
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/score/clearNextEvent"));
+	EXPECT_TRUE(points.empty());
+
+}
+
+}
+
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <G4UImanager.hh>
+#include <G4SystemOfUnits.hh>
 #include "isnp/init/FacilityMessenger.hh"
+#include "isnp/init/StackingAction.hh"
+#include "isnp/init/CompositeSteppingAction.hh"
 
 namespace isnp {
 
@@ -17,6 +20,49 @@ TEST(UserActionMessenger, SetGun)
 
 }
 
+TEST(UserActionMessenger, Stacking)
+{
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/stacking/kill e-"));
+	EXPECT_EQ(0,
+			uiManager->ApplyCommand("/isnp/stacking/energyFloor gamma 100 keV"));
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/stacking/energyFloor proton 2"));
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/stacking/neutronsOutsideTarget"));
+
+	EXPECT_TRUE(StackingAction::IsKilled("e-"));
+	EXPECT_FALSE(StackingAction::IsKilled("neutron"));
+	EXPECT_DOUBLE_EQ(100 * keV, StackingAction::GetEnergyFloor("gamma"));
+	EXPECT_DOUBLE_EQ(2 * MeV, StackingAction::GetEnergyFloor("proton"));
+	EXPECT_DOUBLE_EQ(0.0, StackingAction::GetEnergyFloor("neutron"));
+	EXPECT_TRUE(StackingAction::GetNeutronsOnlyOutsideTarget());
+	EXPECT_EQ("1",
+			uiManager->GetCurrentValues("/isnp/stacking/neutronsOutsideTarget"));
+
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/stacking/energyFloor gamma 0"));
+	EXPECT_DOUBLE_EQ(0.0, StackingAction::GetEnergyFloor("gamma"));
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/stacking/clear"));
+	EXPECT_FALSE(StackingAction::IsKilled("e-"));
+	EXPECT_DOUBLE_EQ(0.0, StackingAction::GetEnergyFloor("proton"));
+	EXPECT_FALSE(StackingAction::GetNeutronsOnlyOutsideTarget());
+
+}
+
+TEST(UserActionMessenger, CountSteps)
+{
+
+	auto const uiManager = G4UImanager::GetUIpointer();
+
+	EXPECT_FALSE(CompositeSteppingAction::GetCountSteps());
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/countSteps"));
+	EXPECT_TRUE(CompositeSteppingAction::GetCountSteps());
+	EXPECT_EQ("1", uiManager->GetCurrentValues("/isnp/countSteps"));
+	EXPECT_EQ(0, uiManager->ApplyCommand("/isnp/countSteps false"));
+	EXPECT_FALSE(CompositeSteppingAction::GetCountSteps());
+
+}
+
 }
 
 }
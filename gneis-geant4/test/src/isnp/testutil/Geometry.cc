@@ -0,0 +1,46 @@
+#include <G4AffineTransform.hh>
+#include <G4VPhysicalVolume.hh>
+#include <Randomize.hh>
+
+#include "isnp/testutil/Geometry.hh"
+
+G4Material const* isnp::testutil::Geometry::MaterialAt(
+		G4LogicalVolume const* const volume, G4ThreeVector const& point) {
+
+	for (std::size_t i = 0; i < volume->GetNoDaughters(); i++) {
+		auto const daughter = volume->GetDaughter(i);
+
+		G4AffineTransform transform(daughter->GetRotation(),
+				daughter->GetTranslation());
+		transform.Invert();
+		auto const local = transform.TransformPoint(point);
+
+		auto const logical = daughter->GetLogicalVolume();
+		if (logical->GetSolid()->Inside(local) != kOutside) {
+			return MaterialAt(logical, local);
+		}
+	}
+
+	return volume->GetMaterial();
+
+}
+
+unsigned isnp::testutil::Geometry::CountDifferences(
+		G4LogicalVolume const* const a, G4LogicalVolume const* const b,
+		G4ThreeVector const& halfSize, unsigned const numOfPoints) {
+
+	unsigned result = 0;
+
+	for (unsigned i = 0; i < numOfPoints; i++) {
+		G4ThreeVector const point(
+				CLHEP::RandFlat::shoot(-halfSize.x(), halfSize.x()),
+				CLHEP::RandFlat::shoot(-halfSize.y(), halfSize.y()),
+				CLHEP::RandFlat::shoot(-halfSize.z(), halfSize.z()));
+		if (MaterialAt(a, point) != MaterialAt(b, point)) {
+			result++;
+		}
+	}
+
+	return result;
+
+}
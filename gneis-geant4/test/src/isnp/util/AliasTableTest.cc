@@ -0,0 +1,95 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "isnp/util/AliasTable.hh"
+
+namespace isnp {
+
+namespace util {
+
+static std::vector<G4double> Frequencies(AliasTable const& table,
+		int const numOfDraws) {
+
+	std::vector<G4double> result(table.Size());
+	for (int i = 0; i < numOfDraws; i++) {
+		result.at(table.Shoot()) += 1.0 / numOfDraws;
+	}
+	return result;
+
+}
+
+TEST(AliasTable, Generic) {
+
+	std::vector<G4float> const weights { 1, 2, 3, 0, 4 };
+	AliasTable const table(weights.data(), weights.size());
+
+	EXPECT_EQ(5u, table.Size());
+	EXPECT_DOUBLE_EQ(10.0, table.GetTotalWeight());
+
+	auto const f = Frequencies(table, 1000000);
+	EXPECT_NEAR(0.1, f[0], 0.002);
+	EXPECT_NEAR(0.2, f[1], 0.002);
+	EXPECT_NEAR(0.3, f[2], 0.002);
+	EXPECT_EQ(0.0, f[3]);
+	EXPECT_NEAR(0.4, f[4], 0.002);
+
+}
+
+TEST(AliasTable, Chunks) {
+
+	// the second chunk has zero weight and is never selected
+	std::vector<G4float> const weights { 1, 1, 0, 0, 2, 4, 2 };
+	AliasTable const table(weights.data(), weights.size(), 2, 3);
+
+	EXPECT_DOUBLE_EQ(10.0, table.GetTotalWeight());
+
+	auto const f = Frequencies(table, 1000000);
+	EXPECT_NEAR(0.1, f[0], 0.002);
+	EXPECT_NEAR(0.1, f[1], 0.002);
+	EXPECT_EQ(0.0, f[2]);
+	EXPECT_EQ(0.0, f[3]);
+	EXPECT_NEAR(0.2, f[4], 0.002);
+	EXPECT_NEAR(0.4, f[5], 0.002);
+	EXPECT_NEAR(0.2, f[6], 0.002);
+
+}
+
+TEST(AliasTable, Parallel) {
+
+	std::vector<G4float> weights(100000);
+	for (std::size_t i = 0; i < weights.size(); i++) {
+		weights[i] = static_cast<G4float>(i % 17);
+	}
+
+	AliasTable const sequential(weights.data(), weights.size(), 1000, 1);
+	AliasTable const parallel(weights.data(), weights.size(), 1000, 8);
+
+	EXPECT_DOUBLE_EQ(sequential.GetTotalWeight(), parallel.GetTotalWeight());
+	for (int i = 0; i < 1000; i++) {
+		auto const u = (i + 0.5) / 1000, v = (i * 7 % 1000 + 0.5) / 1000;
+		EXPECT_EQ(sequential.Sample(u, v), parallel.Sample(u, v));
+		EXPECT_NE(0u, sequential.Sample(u, v) % 17);
+	}
+
+}
+
+TEST(AliasTable, InvalidWeight) {
+
+	std::vector<G4float> const negative { 1, -1 };
+	EXPECT_THROW(AliasTable(negative.data(), negative.size()),
+			AliasTable::InvalidWeightException);
+
+	std::vector<G4float> const zero { 0, 0 };
+	EXPECT_THROW(AliasTable(zero.data(), zero.size()),
+			AliasTable::InvalidWeightException);
+
+	std::vector<G4float> const infinite { 1, 1.0f / 0.0f };
+	EXPECT_THROW(AliasTable(infinite.data(), infinite.size()),
+			AliasTable::InvalidWeightException);
+
+}
+
+}
+
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include "isnp/util/ApertureChain.hh"
+
+namespace isnp {
+
+namespace util {
+
+TEST(ApertureChain, Empty) {
+
+	ApertureChain chain;
+
+	EXPECT_TRUE(chain.IsEmpty());
+	EXPECT_TRUE(chain.IsInCone(G4ThreeVector(1, 0, 0), 0, 0));
+
+}
+
+TEST(ApertureChain, Rectangle) {
+
+	ApertureChain chain;
+	chain.AddRectangle(900, 100, 20, 40);
+
+	EXPECT_FALSE(chain.IsEmpty());
+
+	// point source, far end is at z = 1000
+	EXPECT_TRUE(chain.IsInCone(G4ThreeVector(0, 0, 1), 0, 0));
+	EXPECT_TRUE(chain.IsInCone(G4ThreeVector(0.0099, 0.0199, 1), 0, 0));
+	EXPECT_FALSE(chain.IsInCone(G4ThreeVector(0.0101, 0, 1), 0, 0));
+	EXPECT_FALSE(chain.IsInCone(G4ThreeVector(0, -0.0201, 1), 0, 0));
+	EXPECT_FALSE(chain.IsInCone(G4ThreeVector(0, 0, -1), 0, 0));
+
+	// a wider spot widens the cone
+	EXPECT_TRUE(chain.IsInCone(G4ThreeVector(0.0101, 0, 1), 1, 0));
+
+}
+
+TEST(ApertureChain, Circle) {
+
+	ApertureChain chain;
+	chain.AddRectangle(100, 100, 200, 200);
+	chain.AddCircle(1900, 100, 20);
+
+	EXPECT_TRUE(chain.IsInCone(G4ThreeVector(0.003, 0.003, 1), 0, 0));
+	EXPECT_TRUE(chain.IsInCone(G4ThreeVector(0.003, 0.003, 1).unit(), 0, 0));
+	EXPECT_FALSE(chain.IsInCone(G4ThreeVector(0.0045, 0.0045, 1), 0, 0));
+	EXPECT_TRUE(chain.IsInCone(G4ThreeVector(0.0045, 0.0045, 1), 3, 4));
+
+	ApertureChain other;
+	other.AddRectangle(100, 100, 200, 200);
+	EXPECT_NE(chain.ToString(), other.ToString());
+	other.AddCircle(1900, 100, 20);
+	EXPECT_EQ(chain.ToString(), other.ToString());
+
+}
+
+}
+
+}
@@ -0,0 +1,160 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <gtest/gtest.h>
+#include "isnp/util/DataFrameBlockReader.hh"
+#include "isnp/util/DataFrameLoader.hh"
+#include "isnp/util/DataFrameWriter.hh"
+
+namespace isnp {
+
+namespace util {
+
+static G4String const TEXT = "A\tC\tB\tE\n"
+		"1.23456e20\tabc\t1.2345e-20\ta\n"
+		"2.34567e20\tcba\t2.3456e-20\tb\n"
+		"\n"
+		"3.45678e20\tabc\t3.4567e-20\ta\n"
+		"4.5\tabc\t4.5\tc\n"
+		"5.6\tcba\t5.6\ta";
+
+static void ExpectBlocks(G4String const& fileName, DataFrame const& full) {
+
+	DataFrameBlockReader reader(fileName, { "A", "B" }, { "E" }, 2);
+	EXPECT_EQ(full.Size(), reader.GetNumOfRows());
+	EXPECT_EQ(2u, reader.GetBlockSize());
+	EXPECT_EQ(3u, reader.GetNumOfBlocks());
+
+	DataFrame::size_type row = 0;
+	for (DataFrame::size_type blockNo = 0; blockNo < reader.GetNumOfBlocks();
+			blockNo++) {
+		auto const df = reader.Read(blockNo);
+		EXPECT_EQ(blockNo < 2 ? 2u : 1u, df.Size());
+		EXPECT_EQ(full.Precision("A"), df.Precision("A"));
+		EXPECT_EQ(full.Precision("B"), df.Precision("B"));
+
+		for (DataFrame::size_type i = 0; i < df.Size(); i++, row++) {
+			EXPECT_EQ(full.FloatValue("A", row), df.FloatValue("A", i));
+			EXPECT_EQ(full.FloatValue("B", row), df.FloatValue("B", i));
+			EXPECT_EQ(full.CategoryValue("E", row), df.CategoryValue("E", i));
+		}
+	}
+	EXPECT_EQ(full.Size(), row);
+
+}
+
+TEST(DataFrameBlockReader, Text) {
+
+	G4String const fileName = "DataFrameBlockReaderTest.txt";
+	{
+		std::ofstream os(fileName);
+		os << TEXT;
+	}
+
+	std::istringstream is(TEXT);
+	DataFrameLoader loader( { "A", "B" }, { "E" });
+	ExpectBlocks(fileName, loader.load(is));
+
+	std::remove(fileName.c_str());
+
+}
+
+TEST(DataFrameBlockReader, Binary) {
+
+	G4String const fileName = "DataFrameBlockReaderTest.bin";
+
+	std::istringstream is(TEXT);
+	DataFrameLoader loader( { "A", "B" }, { "E" });
+	auto const full = loader.load(is);
+	{
+		std::ofstream os(fileName, std::ios::binary);
+		DataFrameWriter::Write(full, os);
+	}
+
+	ExpectBlocks(fileName, full);
+
+	{
+		DataFrameBlockReader reader(fileName, { "A" }, { }, 10);
+		EXPECT_EQ(1u, reader.GetNumOfBlocks());
+		EXPECT_THROW(reader.Read(0).CategoryColumn("E"),
+				DataFrame::NoSuchColumnException);
+	}
+
+	EXPECT_THROW(DataFrameBlockReader(fileName, { "A", "D" }, { }, 10),
+			DataFrameLoader::NoColumnException);
+
+	std::remove(fileName.c_str());
+
+}
+
+TEST(DataFrameBlockReader, Frames) {
+
+	G4String const fileName = "DataFrameBlockReaderTest.bin";
+
+	std::istringstream is(TEXT);
+	DataFrameLoader loader( { "A", "B" }, { "E" });
+	auto const full = loader.load(is);
+
+	// second frame has its own dictionary, a block spans both frames
+	std::istringstream is1("A\tB\tE\n"
+			"1.23456e20\t1.2345e-20\ta\n"
+			"2.34567e20\t2.3456e-20\tb\n"
+			"3.45678e20\t3.4567e-20\ta\n");
+	std::istringstream is2("A\tB\tE\n"
+			"4.5\t4.5\tc\n"
+			"5.6\t5.6\ta\n");
+	{
+		std::ofstream os(fileName, std::ios::binary);
+		DataFrameWriter::Write(loader.load(is1), os);
+		DataFrameWriter::Write(loader.load(is2), os);
+	}
+
+	DataFrameBlockReader reader(fileName, { "A", "B" }, { "E" }, 2);
+	EXPECT_EQ(full.Size(), reader.GetNumOfRows());
+
+	DataFrame::size_type row = 0;
+	for (DataFrame::size_type blockNo = 0; blockNo < reader.GetNumOfBlocks();
+			blockNo++) {
+		auto const df = reader.Read(blockNo);
+		for (DataFrame::size_type i = 0; i < df.Size(); i++, row++) {
+			EXPECT_EQ(full.FloatValue("A", row), df.FloatValue("A", i));
+			EXPECT_EQ(full.CategoryValue("E", row), df.CategoryValue("E", i));
+		}
+	}
+	EXPECT_EQ(full.Size(), row);
+
+	std::remove(fileName.c_str());
+
+}
+
+TEST(DataFrameBlockReader, SumByBlocks) {
+
+	G4String const fileName = "DataFrameBlockReaderTest.txt";
+	{
+		std::ofstream os(fileName);
+		os << TEXT;
+	}
+
+	DataFrameBlockReader reader(fileName, { "A" }, { "E" }, 2, { "B", "W" });
+	auto const sums = reader.SumByBlocks("B");
+	ASSERT_EQ(3u, sums.size());
+	EXPECT_NEAR(3.5801e-20, sums[0], 1e-24);
+	EXPECT_NEAR(4.5 + 3.4567e-20, sums[1], 1e-6);
+	EXPECT_NEAR(5.6, sums[2], 1e-6);
+
+	EXPECT_TRUE(reader.SumByBlocks("W").empty());
+
+	std::remove(fileName.c_str());
+
+}
+
+TEST(DataFrameBlockReader, NoFile) {
+
+	EXPECT_THROW(DataFrameBlockReader("nonexistent.txt", { "A" }, { }, 10),
+			DataFrameLoader::FileException);
+
+}
+
+}
+
+}
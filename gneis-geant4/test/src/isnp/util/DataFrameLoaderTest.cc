@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <cctype>
+#include <map>
 #include <sstream>
+#include <string>
+#include <vector>
 #include <gtest/gtest.h>
 #include "isnp/util/DataFrameLoader.hh"
 
@@ -66,6 +71,176 @@ TEST(DataFrameLoader, Generic) {
 
 }
 
+static std::string MakeLargeText(unsigned const numOfRows,
+		unsigned const badRow) {
+
+	std::stringstream ss;
+	ss << "# large text\n" << "A\tC\tB\tE\n";
+
+	for (unsigned i = 0; i < numOfRows; i++) {
+		if (i % 101 == 0) {
+			ss << "\t# comment\n\n";
+		}
+
+		if (i == badRow) {
+			ss << "1.0\tabc\n";
+			continue;
+		}
+
+		ss << (i * 1.25e-3) << "\t" << (i % 1000 == 999 ? "rare" : "abc")
+				<< i % 7 << "\t" << -(i * 3.5e2) << "\t" << (i % 3 ? "b" : "a")
+				<< "\n";
+	}
+
+	return ss.str();
+
+}
+
+/**
+ * Columns of a text parsed line by line with std::stof as the serial loader
+ * did before the parallel parser, the reference for the parser.
+ */
+struct SerialColumns {
+	std::map<std::string, std::vector<G4float>> floats;
+	std::map<std::string, std::vector<std::string>> categories;
+	std::map<std::string, unsigned> precisions;
+};
+
+static std::vector<std::string> Tokenize(std::string const& line) {
+
+	std::vector<std::string> result;
+	std::istringstream is(line);
+	std::string token;
+	while (std::getline(is, token, '\t')) {
+		if (!token.empty()) {
+			result.push_back(token);
+		}
+	}
+	return result;
+
+}
+
+static unsigned DetectPrecision(std::string const& s) {
+
+	auto const e = std::find_if(std::begin(s), std::end(s), [](char ch) {
+		return ch == 'e' || ch == 'E';
+	});
+	auto const result = std::distance(std::begin(s), e);
+	return std::find(std::begin(s), e, '.') == e ? result : result - 1;
+
+}
+
+static SerialColumns LoadSerially(std::string const& text,
+		std::vector<std::string> const& floatColumns,
+		std::vector<std::string> const& categoryColumns) {
+
+	SerialColumns result;
+	std::vector<std::string> names;
+	std::istringstream is(text);
+	std::string line;
+
+	while (std::getline(is, line)) {
+		line.erase(line.begin(),
+				std::find_if(line.begin(), line.end(), [](char ch) {
+					return !std::isspace(static_cast<unsigned char>(ch));
+				}));
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+
+		auto const v = Tokenize(line);
+		if (names.empty()) {
+			names = v;
+			continue;
+		}
+
+		auto const value = [&names, &v](std::string const& name) {
+			auto const idx = std::distance(std::begin(names),
+					std::find(std::begin(names), std::end(names), name));
+			return v.at(idx);
+		};
+
+		for (auto const& name : floatColumns) {
+			if (result.precisions.count(name) == 0) {
+				result.precisions[name] = DetectPrecision(value(name));
+			}
+			result.floats[name].push_back(std::stof(value(name)));
+		}
+		for (auto const& name : categoryColumns) {
+			result.categories[name].push_back(value(name));
+		}
+	}
+
+	return result;
+
+}
+
+TEST(DataFrameLoader, Parallel) {
+
+	auto const text = MakeLargeText(300000, 300000);
+	auto const expected = LoadSerially(text, { "A", "B" }, { "C", "E" });
+
+	DataFrameLoader loader( { "A", "B" }, { "C", "E" });
+	loader.SetNumOfThreads(4);
+	std::stringstream s(text);
+	DataFrame const df = loader.load(s);
+
+	ASSERT_EQ(300000u, expected.floats.at("A").size());
+	ASSERT_EQ(expected.floats.at("A").size(), df.Size());
+	EXPECT_EQ(expected.precisions.at("A"), df.Precision("A"));
+	EXPECT_EQ(expected.precisions.at("B"), df.Precision("B"));
+
+	for (DataFrame::size_type i = 0; i < df.Size(); i++) {
+		ASSERT_EQ(expected.floats.at("A")[i], df.FloatValue("A", i));
+		ASSERT_EQ(expected.floats.at("B")[i], df.FloatValue("B", i));
+		ASSERT_EQ(expected.categories.at("C")[i], df.CategoryValue("C", i));
+		ASSERT_EQ(expected.categories.at("E")[i], df.CategoryValue("E", i));
+	}
+
+}
+
+TEST(DataFrameLoader, ParallelNoValue) {
+
+	auto const text = MakeLargeText(300000, 250000);
+
+	DataFrameLoader loader( { "A", "B" }, { "C", "E" });
+	loader.SetNumOfThreads(4);
+	std::stringstream s(text);
+
+	try {
+		loader.load(s);
+		FAIL();
+	} catch (DataFrameLoader::NoValueException const& e) {
+		EXPECT_EQ("E", e.GetColumnName());
+		// header, column names, 250000 rows before and 2 lines per each 101th row
+		EXPECT_EQ(2 + 250000 + 2 * (250000 / 101 + 1) + 1, e.GetLineNo());
+	}
+
+}
+
+TEST(DataFrameLoader, OptionalColumns) {
+	std::stringstream ss;
+	ss << "A\tE\tW\n" << "1.5\ta\t2\n" << "2.5\tb\t0.5\n";
+
+	DataFrameLoader loader( { "A" }, { "E" }, { "W", "V" });
+	DataFrame const df = loader.load(ss);
+
+	EXPECT_EQ(2, df.Size());
+	EXPECT_TRUE(df.HasFloatColumn("W"));
+	EXPECT_FALSE(df.HasFloatColumn("V"));
+	EXPECT_EQ(2.0f, df.FloatValue("W", 0));
+	EXPECT_EQ(0.5f, df.FloatValue("W", 1));
+
+}
+
+TEST(DataFrameLoader, NoFile) {
+
+	DataFrameLoader loader( { "A" }, { });
+	EXPECT_THROW(loader.load(G4String("no-such-file.txt")),
+			DataFrameLoader::FileException);
+
+}
+
 }
 
 }
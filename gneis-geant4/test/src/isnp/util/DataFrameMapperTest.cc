@@ -0,0 +1,136 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <gtest/gtest.h>
+#include "isnp/util/DataFrameLoader.hh"
+#include "isnp/util/DataFrameMapper.hh"
+#include "isnp/util/DataFrameWriter.hh"
+#include "isnp/util/DataFrameFormat.hh"
+
+namespace isnp {
+
+namespace util {
+
+static DataFrame LoadText() {
+	std::stringstream ss;
+	ss << "A\tC\tB\tE\n" << "1.23456e20\tabc\t1.2345e-20\ta\n"
+			<< "2.34567e20\tcba\t2.3456e-20\tb\n"
+			<< "3.45678e20\tabc\t3.4567e-20\ta\n";
+
+	DataFrameLoader loader( { "A", "B" }, { "C", "E" });
+	return loader.load(ss);
+}
+
+TEST(DataFrameMapper, RoundTrip) {
+	G4String const fileName = "DataFrameMapperTest.bin";
+
+	auto const text = LoadText();
+	{
+		std::ofstream os(fileName, std::ios::binary);
+		DataFrameWriter::Write(text, os);
+	}
+
+	EXPECT_TRUE(DataFrameFormat::IsBinary(fileName));
+
+	{
+		DataFrameMapper mapper( { "A", "B" }, { "E" });
+		DataFrame const df = mapper.map(fileName);
+
+		EXPECT_TRUE(df.IsMapped());
+		EXPECT_FALSE(text.IsMapped());
+		EXPECT_EQ(3, df.Size());
+		EXPECT_EQ(6, df.Precision("A"));
+		EXPECT_EQ(5, df.Precision("B"));
+		EXPECT_THROW(df.CategoryColumn("C"), DataFrame::NoSuchColumnException);
+
+		for (DataFrame::size_type i = 0; i < df.Size(); i++) {
+			EXPECT_EQ(text.FloatValue("A", i), df.FloatValue("A", i));
+			EXPECT_EQ(text.FloatValue("B", i), df.FloatValue("B", i));
+			EXPECT_EQ(text.CategoryValue("E", i), df.CategoryValue("E", i));
+		}
+
+		EXPECT_EQ(0u,
+				reinterpret_cast<std::uintptr_t>(df.FloatColumn("A").data())
+						% DataFrameFormat::DataAlignment);
+	}
+
+	{
+		DataFrameMapper mapper( { "A" }, { }, { "B", "D" });
+		DataFrame const df = mapper.map(fileName);
+
+		EXPECT_TRUE(df.HasFloatColumn("B"));
+		EXPECT_FALSE(df.HasFloatColumn("D"));
+	}
+
+	{
+		DataFrameMapper mapper( { "A", "D" }, { });
+		EXPECT_THROW(mapper.map(fileName), DataFrameLoader::NoColumnException);
+	}
+
+	std::remove(fileName.c_str());
+}
+
+TEST(DataFrameMapper, Frames) {
+	G4String const fileName = "DataFrameMapperTest.bin";
+
+	std::stringstream ss;
+	ss << "A\tC\tB\tE\n" << "4.5\tabc\t4.5e-20\tc\n"
+			<< "5.6\tabc\t5.6e-20\ta\n";
+	DataFrameLoader loader( { "A", "B" }, { "C", "E" });
+	auto const first = LoadText();
+	auto const second = loader.load(ss);
+	{
+		std::ofstream os(fileName, std::ios::binary);
+		DataFrameWriter::Write(first, os);
+		DataFrameWriter::Write(second, os);
+	}
+
+	{
+		DataFrameMapper mapper( { "A" }, { "E" });
+		DataFrame const df = mapper.map(fileName);
+
+		EXPECT_FALSE(df.IsMapped());
+		EXPECT_EQ(5, df.Size());
+		EXPECT_EQ(6, df.Precision("A"));
+
+		for (DataFrame::size_type i = 0; i < df.Size(); i++) {
+			auto const& expected = i < first.Size() ? first : second;
+			auto const j = i < first.Size() ? i : i - first.Size();
+			EXPECT_EQ(expected.FloatValue("A", j), df.FloatValue("A", i));
+			EXPECT_EQ(expected.CategoryValue("E", j), df.CategoryValue("E", i));
+		}
+	}
+
+	// truncated trailing frame
+	{
+		std::ofstream os(fileName, std::ios::binary | std::ios::app);
+		os.write(DataFrameFormat::Magic, sizeof(DataFrameFormat::Magic));
+	}
+
+	{
+		DataFrameMapper mapper( { "A" }, { "E" });
+		EXPECT_THROW(mapper.map(fileName), DataFrameMapper::FormatException);
+	}
+
+	std::remove(fileName.c_str());
+}
+
+TEST(DataFrameMapper, NotBinary) {
+	G4String const fileName = "DataFrameMapperTest.txt";
+	{
+		std::ofstream os(fileName);
+		os << "A\n1.0\n";
+	}
+
+	EXPECT_FALSE(DataFrameFormat::IsBinary(fileName));
+
+	DataFrameMapper mapper( { "A" }, { });
+	EXPECT_THROW(mapper.map(fileName), DataFrameMapper::FormatException);
+
+	std::remove(fileName.c_str());
+}
+
+}
+
+}
@@ -33,6 +33,14 @@ TEST(FileNameBuilder, MakeWithCommonSuffix_s_pch)
 	EXPECT_EQ("base.abc.txt", res);
 }
 
+TEST(FileNameBuilder, MakeShard)
+{
+	FileNameBuilder::SetCommonSuffix("");
+	EXPECT_EQ("base.t3.txt", FileNameBuilder::MakeShard("base", 3, ".txt"));
+	FileNameBuilder::SetCommonSuffix("abc");
+	EXPECT_EQ("base.abc.t0.bin", FileNameBuilder::MakeShard("base", 0, ".bin"));
+}
+
 }
 
 }